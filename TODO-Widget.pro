@@ -19,11 +19,16 @@
 #-------------------------------------------------
 
 # Required Qt modules
-QT       += core gui sql svg network
+QT       += core gui sql svg network concurrent
 
 # Add widgets module for Qt 5+
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
+# zlib for streaming compression of exports and backups: the system library on
+# Unix, the copy bundled with and exported by QtCore on Windows
+unix: LIBS += -lz
+win32: INCLUDEPATH += $$[QT_INSTALL_HEADERS]/QtZlib
+
 # Application name and template
 TARGET = TODO-Widget
 TEMPLATE = app
@@ -41,9 +46,23 @@ SOURCES += \
     models/category.cpp \
     models/taskmodel.cpp \
     models/categorymodel.cpp \
+    models/trackingclock.cpp \
+    models/timereportmodel.cpp \
     services/databasemanager.cpp \
     services/settingsmanager.cpp \
     services/importexportservice.cpp \
+    services/reportgenerator.cpp \
+    services/reportcache.cpp \
+    services/csvwriter.cpp \
+    services/jsonstreamreader.cpp \
+    services/csvreader.cpp \
+    services/cborsnapshot.cpp \
+    services/jsonstreamwriter.cpp \
+    services/compresseddevice.cpp \
+    services/importexportjob.cpp \
+    services/icalendarwriter.cpp \
+    services/logger.cpp \
+    services/tracer.cpp \
     controllers/taskcontroller.cpp \
     controllers/categorycontroller.cpp \
     controllers/notificationcontroller.cpp \
@@ -61,9 +80,23 @@ HEADERS += \
     models/category.h \
     models/taskmodel.h \
     models/categorymodel.h \
+    models/trackingclock.h \
+    models/timereportmodel.h \
     services/databasemanager.h \
     services/settingsmanager.h \
     services/importexportservice.h \
+    services/reportgenerator.h \
+    services/reportcache.h \
+    services/csvwriter.h \
+    services/jsonstreamreader.h \
+    services/csvreader.h \
+    services/cborsnapshot.h \
+    services/jsonstreamwriter.h \
+    services/compresseddevice.h \
+    services/importexportjob.h \
+    services/icalendarwriter.h \
+    services/logger.h \
+    services/tracer.h \
     controllers/taskcontroller.h \
     controllers/categorycontroller.h \
     controllers/notificationcontroller.h \
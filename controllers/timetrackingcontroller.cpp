@@ -14,6 +14,7 @@
 
 #include "timetrackingcontroller.h"
 #include "../services/databasemanager.h"
+#include "../services/reportcache.h"
 #include "../controllers/projectcontroller.h"
 #include <QDebug>
 
@@ -33,26 +34,31 @@ TimeTrackingController::TimeTrackingController(TimeEntryModel *model, QObject* p
     : QObject(parent)
     , m_timeEntryModel(model)
     , m_timer(new QTimer(this))
-    , m_startTime(QDateTime())
+    , m_heartbeatTimer(new QTimer(this))
     , m_currentProjectId("")
+    , m_dataVersion(1)
     , m_initialized(false)
 {
-    // Set up the timer to fire every second
+    // Set up the shared tick to fire every second for all running timers
     m_timer->setInterval(1000);
+    m_timer->setTimerType(Qt::PreciseTimer);
     connect(m_timer, &QTimer::timeout, this, &TimeTrackingController::onTimerTick);
+    
+    // Checkpoint running entries at a coarse interval; precision is irrelevant here
+    m_heartbeatTimer->setInterval(HEARTBEAT_INTERVAL_MS);
+    m_heartbeatTimer->setTimerType(Qt::VeryCoarseTimer);
+    connect(m_heartbeatTimer, &QTimer::timeout, this, &TimeTrackingController::onHeartbeat);
 }
 
 /**
  * @brief Destructor for TimeTrackingController
  *
- * Ensures any running timer is stopped before destruction.
+ * Ensures all running timers are stopped before destruction.
  */
 TimeTrackingController::~TimeTrackingController()
 {
-    // Ensure any running timer is stopped before destruction
-    if (isTimerRunning()) {
-        stopTimer();
-    }
+    // Ensure all running timers are stopped before destruction
+    stopAllTimers();
 }
 
 /**
@@ -107,6 +113,9 @@ bool TimeTrackingController::initialize()
     bool success = loadTimeEntries();
     
     if (success) {
+        // Resume or close running entries persisted by a previous session
+        recoverRunningEntries();
+        
         m_initialized = true;
         qDebug() << "TimeTrackingController initialized successfully";
     } else {
@@ -119,17 +128,17 @@ bool TimeTrackingController::initialize()
 /**
  * @brief Start the timer for tracking time on a project
  *
- * If a timer is already running, it stops it first and creates a time entry.
- * Then starts tracking time for the specified project.
+ * Timers for other projects keep running. The new timer is backed by a running
+ * time entry which is written to the database once here; ticks never write.
  *
  * @param projectId The ID of the project to track time for
  * @return true if the timer was started successfully, false otherwise
  */
 bool TimeTrackingController::startTimer(const QString& projectId)
 {
-    // If there's already a timer running, stop it first
-    if (isTimerRunning()) {
-        stopTimer();
+    if (isTimerRunning(projectId)) {
+        qWarning() << "Cannot start timer: Project" << projectId << "is already being tracked";
+        return false;
     }
     
     // Check if the project exists
@@ -138,66 +147,131 @@ bool TimeTrackingController::startTimer(const QString& projectId)
         return false;
     }
     
-    // Start tracking the new project
-    m_currentProjectId = projectId;
-    m_startTime = QDateTime::currentDateTime();
-    m_timer->start();
+    // Persist the running entry so its state survives a restart
+    TimeEntry entry(projectId, QDateTime::currentDateTime());
+    addTimeEntry(entry);
+    trackRunningEntry(entry);
     
     emit timerStarted(projectId);
-    qDebug() << "Started timer for project:" << projectId;
+    qDebug() << "Started timer for project:" << projectId << "(" << m_runningTimers.size() << "running )";
     
     return true;
 }
 
 /**
- * @brief Stop the timer and create a time entry
+ * @brief Stop the timer of a project and complete its time entry
  *
- * Stops the active timer, calculates the duration, and creates a new
- * time entry for the tracked time.
+ * Sets the end time and duration of the project's running time entry.
+ * The shared tick is stopped once no timers remain.
  *
+ * @param projectId The ID of the project whose timer should be stopped
  * @return true if the timer was stopped successfully, false otherwise
  */
-bool TimeTrackingController::stopTimer()
+bool TimeTrackingController::stopTimer(const QString& projectId)
 {
-    if (!isTimerRunning()) {
+    auto it = m_runningTimers.find(projectId);
+    if (it == m_runningTimers.end()) {
         return false;
     }
     
-    // Stop the timer
-    m_timer->stop();
+    // Account for a suspend that happened since the last heartbeat
+    it.value().clock.resync();
     
-    // Create a time entry for the tracked time
-    QDateTime endTime = QDateTime::currentDateTime();
-    int duration = m_startTime.secsTo(endTime);
+    RunningTimer timer = it.value();
+    m_runningTimers.erase(it);
+    updateTimerActivity();
     
-    TimeEntry entry(m_currentProjectId, m_startTime, endTime, duration);
-    addTimeEntry(entry);
+    // Complete the running time entry from the monotonic duration so that the
+    // end time stays consistent with it even if the wall clock jumped
+    int duration = timer.clock.elapsedSeconds();
+    QDateTime endTime = timer.startTime.addSecs(duration);
     
-    // Clear the current tracking state
-    QString projectId = m_currentProjectId;
-    m_currentProjectId = "";
-    m_startTime = QDateTime();
+    TimeEntry entry = m_timeEntryModel->getTimeEntry(timer.entryId);
+    entry.setEndTime(endTime);
+    entry.setDuration(duration);
+    updateTimeEntry(entry);
     
-    emit timerStopped(duration);
+    // Fall back to the most recently started remaining timer
+    if (m_currentProjectId == projectId) {
+        m_currentProjectId = latestRunningProject();
+    }
+    
+    emit timerStopped(projectId, duration);
     qDebug() << "Stopped timer for project:" << projectId << "Duration:" << duration << "seconds";
     
     return true;
 }
 
 /**
- * @brief Check if the timer is currently running
+ * @brief Stop the current timer
+ *
+ * Stops the most recently started timer.
  *
- * @return true if the timer is active and tracking a project, false otherwise
+ * @return true if the timer was stopped successfully, false otherwise
+ */
+bool TimeTrackingController::stopTimer()
+{
+    if (!isTimerRunning()) {
+        return false;
+    }
+    
+    return stopTimer(m_currentProjectId);
+}
+
+/**
+ * @brief Stop all running timers
+ *
+ * @return The number of timers that were stopped
+ */
+int TimeTrackingController::stopAllTimers()
+{
+    int stopped = 0;
+    
+    const QStringList projectIds = getRunningProjectIds();
+    for (const QString& projectId : projectIds) {
+        if (stopTimer(projectId)) {
+            ++stopped;
+        }
+    }
+    
+    return stopped;
+}
+
+/**
+ * @brief Check if any timer is currently running
+ *
+ * @return true if at least one project is being tracked, false otherwise
  */
 bool TimeTrackingController::isTimerRunning() const
 {
-    return m_timer->isActive() && !m_currentProjectId.isEmpty();
+    return !m_runningTimers.isEmpty();
+}
+
+/**
+ * @brief Check if a timer is running for a project
+ *
+ * @param projectId The ID of the project to check
+ * @return true if the project is being tracked, false otherwise
+ */
+bool TimeTrackingController::isTimerRunning(const QString& projectId) const
+{
+    return m_runningTimers.contains(projectId);
+}
+
+/**
+ * @brief Get the IDs of all projects with a running timer
+ *
+ * @return The IDs of the tracked projects
+ */
+QStringList TimeTrackingController::getRunningProjectIds() const
+{
+    return m_runningTimers.keys();
 }
 
 /**
  * @brief Get the ID of the project currently being tracked
  *
- * @return The ID of the current project, or empty string if not tracking
+ * @return The ID of the most recently started project, or empty string if not tracking
  */
 QString TimeTrackingController::getCurrentProjectId() const
 {
@@ -211,11 +285,49 @@ QString TimeTrackingController::getCurrentProjectId() const
  */
 int TimeTrackingController::getCurrentElapsed() const
 {
-    if (!isTimerRunning()) {
+    return getElapsed(m_currentProjectId);
+}
+
+/**
+ * @brief Get the elapsed time for a project's tracking session
+ *
+ * @param projectId The ID of the tracked project
+ * @return The elapsed time in seconds, or 0 if the project is not being tracked
+ */
+int TimeTrackingController::getElapsed(const QString& projectId) const
+{
+    auto it = m_runningTimers.constFind(projectId);
+    if (it == m_runningTimers.cend()) {
         return 0;
     }
     
-    return m_startTime.secsTo(QDateTime::currentDateTime());
+    return it.value().clock.elapsedSeconds();
+}
+
+/**
+ * @brief Subscribe or unsubscribe a consumer to timer ticks
+ *
+ * @param consumer The object consuming timerTick
+ * @param wanted True to receive ticks, false to stop receiving them
+ */
+void TimeTrackingController::setTicksWanted(const QObject* consumer, bool wanted)
+{
+    if (wanted) {
+        if (!m_tickConsumers.contains(consumer)) {
+            // Drop consumers that are destroyed without unsubscribing
+            connect(consumer, &QObject::destroyed, this, [this, consumer]() {
+                setTicksWanted(consumer, false);
+            });
+            m_tickConsumers.insert(consumer);
+        }
+        
+        // A display becoming visible is the typical moment after a resume
+        resyncClocks();
+    } else if (m_tickConsumers.remove(consumer)) {
+        consumer->disconnect(this);
+    }
+    
+    updateTimerActivity();
 }
 
 /**
@@ -228,6 +340,7 @@ bool TimeTrackingController::addTimeEntry(const TimeEntry& entry)
 {
     // Add the entry to the model
     m_timeEntryModel->addTimeEntry(entry);
+    markEntryChanged(entry);
     
     // Save to the database
     bool success = DatabaseManager::instance().saveTimeEntry(entry);
@@ -250,6 +363,9 @@ bool TimeTrackingController::addTimeEntry(const TimeEntry& entry)
  */
 bool TimeTrackingController::updateTimeEntry(const TimeEntry& entry)
 {
+    // Keep the previous version to invalidate the days it covered
+    TimeEntry previous = m_timeEntryModel->getTimeEntry(entry.id());
+    
     // Update the entry in the model
     bool modelSuccess = m_timeEntryModel->updateTimeEntry(entry);
     
@@ -258,6 +374,9 @@ bool TimeTrackingController::updateTimeEntry(const TimeEntry& entry)
         return false;
     }
     
+    markEntryChanged(previous);
+    markEntryChanged(entry);
+    
     // Save to the database
     bool dbSuccess = DatabaseManager::instance().saveTimeEntry(entry);
     
@@ -290,6 +409,18 @@ bool TimeTrackingController::deleteTimeEntry(const QString& id)
         return false;
     }
     
+    markEntryChanged(entry);
+    
+    // Deleting a running entry discards its timer without completing it
+    if (entry.isRunning() && m_runningTimers.value(entry.projectId()).entryId == id) {
+        m_runningTimers.remove(entry.projectId());
+        updateTimerActivity();
+        if (m_currentProjectId == entry.projectId()) {
+            m_currentProjectId = latestRunningProject();
+        }
+        emit timerStopped(entry.projectId(), 0);
+    }
+    
     // Delete from the database
     bool dbSuccess = DatabaseManager::instance().deleteTimeEntry(id);
     
@@ -407,10 +538,26 @@ bool TimeTrackingController::loadTimeEntries()
 {
     QList<TimeEntry> entries = DatabaseManager::instance().loadTimeEntries();
     m_timeEntryModel->setTimeEntries(entries);
+    
+    // Every cached report may be stale after a full reload
+    ++m_dataVersion;
+    ReportCache::instance().clear();
+    emit timeEntriesReloaded();
+    
     qDebug() << "Loaded" << entries.size() << "time entries from database";
     return true;
 }
 
+/**
+ * @brief Get the data version of the time entries
+ *
+ * @return The current data version
+ */
+quint64 TimeTrackingController::dataVersion() const
+{
+    return m_dataVersion;
+}
+
 /**
  * @brief Save all time entries to the database
  *
@@ -463,11 +610,161 @@ QString TimeTrackingController::formatDuration(int seconds, const QString& forma
 /**
  * @brief Timer tick event handler
  *
- * Called every second when the timer is running. Emits the timerTick signal
- * with the current elapsed time.
+ * Called every second by the shared tick while timers are running and a display
+ * wants ticks. Emits the timerTick signal for each running timer.
  */
 void TimeTrackingController::onTimerTick()
 {
-    int elapsed = getCurrentElapsed();
-    emit timerTick(elapsed);
+    for (auto it = m_runningTimers.cbegin(); it != m_runningTimers.cend(); ++it) {
+        emit timerTick(it.key(), it.value().clock.elapsedSeconds());
+    }
+}
+
+/**
+ * @brief Register a running time entry as an active timer
+ *
+ * Starts the shared tick if this is the first running timer and records an
+ * initial heartbeat.
+ *
+ * @param entry The running time entry
+ */
+void TimeTrackingController::trackRunningEntry(const TimeEntry& entry)
+{
+    RunningTimer timer;
+    timer.entryId = entry.id();
+    timer.startTime = entry.startTime();
+    timer.clock.start(entry.startTime());
+    m_runningTimers.insert(entry.projectId(), timer);
+    m_currentProjectId = entry.projectId();
+    
+    // Stamp the heartbeat right away so a crash before the first interval
+    // is not mistaken for a session that never ran
+    DatabaseManager::instance().touchRunningTimeEntries(QDateTime::currentDateTime());
+    
+    updateTimerActivity();
+}
+
+/**
+ * @brief Start or stop the shared tick and heartbeat
+ *
+ * Keeps the number of wakeups proportional to what is actually displayed:
+ * no tick without a visible consumer, no heartbeat without running timers.
+ */
+void TimeTrackingController::updateTimerActivity()
+{
+    bool running = !m_runningTimers.isEmpty();
+    bool ticking = running && !m_tickConsumers.isEmpty();
+    
+    if (ticking && !m_timer->isActive()) {
+        m_timer->start();
+    } else if (!ticking && m_timer->isActive()) {
+        m_timer->stop();
+    }
+    
+    if (running && !m_heartbeatTimer->isActive()) {
+        m_heartbeatTimer->start();
+    } else if (!running && m_heartbeatTimer->isActive()) {
+        m_heartbeatTimer->stop();
+    }
+}
+
+/**
+ * @brief Heartbeat event handler
+ *
+ * Stamps all running entries with the current time in one UPDATE. At most one
+ * heartbeat is written per interval, however many timers are running.
+ */
+void TimeTrackingController::onHeartbeat()
+{
+    if (isTimerRunning()) {
+        resyncClocks();
+        DatabaseManager::instance().touchRunningTimeEntries(QDateTime::currentDateTime());
+    }
+}
+
+/**
+ * @brief Resynchronize the clocks of all running timers
+ *
+ * Reads the system sleep time from the boot-time clock; a detected suspend gap
+ * is credited to every running timer by its clock.
+ */
+void TimeTrackingController::resyncClocks()
+{
+    for (auto it = m_runningTimers.begin(); it != m_runningTimers.end(); ++it) {
+        qint64 gap = it.value().clock.resync();
+        if (gap > 0) {
+            qDebug() << "Detected suspend of" << gap / 1000 << "seconds while tracking project:" << it.key();
+        }
+    }
+}
+
+/**
+ * @brief Resume or close running entries left by a previous session
+ *
+ * A clean shutdown stops every timer, so running entries found at startup were
+ * left behind by a crash or a forced exit. If the last heartbeat (or the start
+ * time when no heartbeat was recorded) is recent the timer is resumed, otherwise
+ * the entry is closed at that point so the tracked time up to the crash is kept.
+ */
+void TimeTrackingController::recoverRunningEntries()
+{
+    const QList<TimeEntry> runningEntries = m_timeEntryModel->getRunningTimeEntries();
+    if (runningEntries.isEmpty()) {
+        return;
+    }
+    
+    QMap<QString, QDateTime> heartbeats = DatabaseManager::instance().loadRunningTimeEntryHeartbeats();
+    QDateTime now = QDateTime::currentDateTime();
+    
+    for (const TimeEntry& entry : runningEntries) {
+        QDateTime lastSeen = heartbeats.value(entry.id(), entry.startTime());
+        
+        if (lastSeen.secsTo(now) <= ORPHAN_THRESHOLD_SECS && !isTimerRunning(entry.projectId())) {
+            trackRunningEntry(entry);
+            qDebug() << "Resumed running time entry:" << entry.id();
+            continue;
+        }
+        
+        TimeEntry closed = entry;
+        closed.setEndTime(lastSeen);
+        closed.setDuration(qMax(0, static_cast<int>(entry.startTime().secsTo(lastSeen))));
+        updateTimeEntry(closed);
+        qDebug() << "Closed orphaned time entry:" << entry.id() << "at" << lastSeen.toString(Qt::ISODate);
+    }
+}
+
+/**
+ * @brief Get the project of the most recently started running timer
+ *
+ * @return QString The project ID, or an empty string if no timer is running
+ */
+QString TimeTrackingController::latestRunningProject() const
+{
+    QString projectId;
+    QDateTime latest;
+    for (auto running = m_runningTimers.cbegin(); running != m_runningTimers.cend(); ++running) {
+        if (latest.isNull() || running.value().startTime > latest) {
+            latest = running.value().startTime;
+            projectId = running.key();
+        }
+    }
+    return projectId;
+}
+
+/**
+ * @brief Record a mutation of a time entry
+ *
+ * @param entry The added, updated or deleted entry
+ */
+void TimeTrackingController::markEntryChanged(const TimeEntry& entry)
+{
+    ++m_dataVersion;
+    
+    if (!entry.startTime().isValid()) {
+        return;
+    }
+    
+    QDate firstDay = entry.startTime().date();
+    QDate lastDay = entry.endTime().isValid() ? entry.endTime().date() : QDate::currentDate();
+    ReportCache::instance().invalidate(firstDay, qMax(firstDay, lastDay));
 }
@@ -15,9 +15,12 @@
 #include <QObject>
 #include <QTimer>
 #include <QDateTime>
+#include <QSet>
 #include <QMap>
+#include <QStringList>
 #include "../models/timeentry.h"
 #include "../models/timeentrymodel.h"
+#include "../models/trackingclock.h"
 
 /**
  * @class TimeTrackingController
@@ -27,6 +30,21 @@
  * It provides methods for starting and stopping timers, managing time entries, and generating
  * time reports. It is implemented as a singleton to ensure there is only one instance
  * throughout the application.
+ * 
+ * Several timers can run at the same time, one per project. Each running timer is
+ * backed by a running TimeEntry that is written to the database once when it starts,
+ * and all of them are driven by a single shared tick timer.
+ * 
+ * Running entries are checkpointed by a coarse heartbeat that stamps their
+ * last_seen column, so entries left behind by a crash can be closed at the last
+ * heartbeat on the next startup instead of being lost or running forever.
+ * 
+ * The per-second tick only runs while a visible display has asked for it through
+ * setTicksWanted(), so a hidden or minimized window causes no tick wakeups.
+ * 
+ * Elapsed times are read from a monotonic TrackingClock per timer, so wall-clock
+ * changes cannot produce wrong or negative durations. Suspend gaps are detected
+ * when the clocks are resynchronized on heartbeats and when a display is shown.
  */
 class TimeTrackingController : public QObject {
     Q_OBJECT
@@ -72,32 +90,61 @@ public:
     /**
      * @brief Start a timer for a project
      * 
-     * Starts tracking time for the specified project. If there's already a timer running,
-     * it stops the current one before starting the new one.
+     * Starts tracking time for the specified project alongside any timers that are
+     * already running. A running time entry is added to the model and persisted once.
      * 
      * @param projectId The ID of the project to track
-     * @return bool True if the timer was started, false otherwise
+     * @return bool True if the timer was started, false if the project is unknown or already tracked
      */
     bool startTimer(const QString& projectId);
     
+    /**
+     * @brief Stop the timer of a project
+     * 
+     * Stops the running timer for the specified project and completes its time entry.
+     * 
+     * @param projectId The ID of the project whose timer should be stopped
+     * @return bool True if a timer was running for the project and stopped, false otherwise
+     */
+    bool stopTimer(const QString& projectId);
+    
     /**
      * @brief Stop the current timer
      * 
-     * Stops the currently running timer and creates a time entry for the tracked time.
+     * Stops the most recently started timer and completes its time entry.
      * 
      * @return bool True if a timer was running and stopped, false otherwise
      */
     bool stopTimer();
     
+    /**
+     * @brief Stop all running timers
+     * @return int The number of timers that were stopped
+     */
+    int stopAllTimers();
+    
     /**
      * @brief Check if a timer is currently running
-     * @return bool True if a timer is running, false otherwise
+     * @return bool True if at least one timer is running, false otherwise
      */
     bool isTimerRunning() const;
     
+    /**
+     * @brief Check if a timer is running for a project
+     * @param projectId The ID of the project to check
+     * @return bool True if the project is being tracked, false otherwise
+     */
+    bool isTimerRunning(const QString& projectId) const;
+    
+    /**
+     * @brief Get the IDs of all tracked projects
+     * @return QStringList The IDs of the projects with a running timer
+     */
+    QStringList getRunningProjectIds() const;
+    
     /**
      * @brief Get the ID of the currently tracked project
-     * @return QString The ID of the project being tracked, or an empty string if no timer is running
+     * @return QString The ID of the most recently started project, or an empty string if no timer is running
      */
     QString getCurrentProjectId() const;
     
@@ -107,6 +154,25 @@ public:
      */
     int getCurrentElapsed() const;
     
+    /**
+     * @brief Get the elapsed time for a project's timer
+     * @param projectId The ID of the tracked project
+     * @return int The elapsed time in seconds, or 0 if the project is not being tracked
+     */
+    int getElapsed(const QString& projectId) const;
+    
+    /**
+     * @brief Subscribe or unsubscribe a consumer to timer ticks
+     * 
+     * The shared tick only runs while timers are running and at least one consumer
+     * wants ticks. Displays should request ticks only while they are visible and
+     * recompute their value with getElapsed() when they are shown again.
+     * 
+     * @param consumer The object consuming timerTick
+     * @param wanted True to receive ticks, false to stop receiving them
+     */
+    void setTicksWanted(const QObject* consumer, bool wanted);
+    
     /**
      * @brief Add a time entry
      * 
@@ -193,6 +259,16 @@ public:
      */
     QMap<QDate, int> getTimeByDay(const QDate& startDate, const QDate& endDate) const;
     
+    /**
+     * @brief Get the data version of the time entries
+     * 
+     * The version is bumped on every mutation of the time entries, so results
+     * derived from them can be cached against it.
+     * 
+     * @return quint64 Current data version, starting at 1
+     */
+    quint64 dataVersion() const;
+    
     /**
      * @brief Load all time entries from the database
      * @return bool True if entries were loaded successfully, false otherwise
@@ -222,15 +298,17 @@ signals:
     
     /**
      * @brief Emitted when a timer is stopped
+     * @param projectId The ID of the project that was being tracked
      * @param duration The duration of the tracked time in seconds
      */
-    void timerStopped(int duration);
+    void timerStopped(const QString& projectId, int duration);
     
     /**
-     * @brief Emitted periodically while a timer is running
+     * @brief Emitted periodically for each running timer
+     * @param projectId The ID of the tracked project
      * @param elapsed The elapsed time in seconds
      */
-    void timerTick(int elapsed);
+    void timerTick(const QString& projectId, int elapsed);
     
     /**
      * @brief Emitted when a time entry is added
@@ -249,17 +327,96 @@ signals:
      * @param id The ID of the deleted time entry
      */
     void timeEntryDeleted(const QString& id);
+    
+    /**
+     * @brief Emitted when all time entries were reloaded from the database
+     */
+    void timeEntriesReloaded();
 
 private slots:
     /**
      * @brief Handle timer tick
      * 
-     * Called every second while a timer is running. Updates the elapsed time
-     * and emits the timerTick signal.
+     * Called every second while at least one timer is running. Emits the
+     * timerTick signal for each running timer.
      */
     void onTimerTick();
+    
+    /**
+     * @brief Handle heartbeat
+     * 
+     * Called at a coarse interval while timers are running. Records the
+     * heartbeat of all running entries with a single database update.
+     */
+    void onHeartbeat();
 
 private:
+    /**
+     * @struct RunningTimer
+     * @brief State of a single running timer
+     */
+    struct RunningTimer {
+        QString entryId;          ///< ID of the running time entry
+        QDateTime startTime;      ///< Start time of the timer
+        TrackingClock clock;      ///< Monotonic elapsed-time source anchored at the start time
+    };
+    
+    /**
+     * @brief Register a running time entry as an active timer
+     * 
+     * Used both when a timer is started and when running entries are restored
+     * from the database.
+     * 
+     * @param entry The running time entry
+     */
+    void trackRunningEntry(const TimeEntry& entry);
+    
+    /**
+     * @brief Get the project of the most recently started running timer
+     * 
+     * The current project falls back to it when the current timer stops or
+     * its entry is deleted.
+     * 
+     * @return QString The project ID, or an empty string if no timer is running
+     */
+    QString latestRunningProject() const;
+    
+    /**
+     * @brief Resume or close running entries left by a previous session
+     * 
+     * Entries with a recent heartbeat are resumed. Entries whose last heartbeat
+     * is older than the orphan threshold are closed at that heartbeat.
+     */
+    void recoverRunningEntries();
+    
+    /**
+     * @brief Resynchronize the clocks of all running timers
+     * 
+     * Credits the time the system slept since the last sync to each clock.
+     */
+    void resyncClocks();
+    
+    /**
+     * @brief Start or stop the shared tick and heartbeat
+     * 
+     * The heartbeat runs while any timer is running. The tick additionally
+     * requires at least one consumer wanting ticks.
+     */
+    void updateTimerActivity();
+    
+    /**
+     * @brief Record a mutation of a time entry
+     * 
+     * Bumps the data version and drops cached reports overlapping the days the
+     * entry covers. Running entries are considered to extend to today.
+     * 
+     * @param entry The added, updated or deleted entry
+     */
+    void markEntryChanged(const TimeEntry& entry);
+    
+    static const int HEARTBEAT_INTERVAL_MS = 60000; ///< Interval between running entry checkpoints
+    static const int ORPHAN_THRESHOLD_SECS = 180;   ///< Heartbeat age after which a running entry is considered orphaned
+
     /**
      * @brief Private copy constructor to enforce singleton pattern
      */
@@ -270,10 +427,13 @@ private:
      */
     TimeTrackingController& operator=(const TimeTrackingController&) = delete;
 
-    QTimer* m_timer;                  ///< Timer for tracking time
-    QDateTime m_startTime;            ///< Start time of the current timer
-    QString m_currentProjectId;       ///< ID of the project being tracked
+    QTimer* m_timer;                  ///< Shared tick source for all running timers
+    QTimer* m_heartbeatTimer;         ///< Coarse timer checkpointing running entries
+    QMap<QString, RunningTimer> m_runningTimers; ///< Running timers keyed by project ID
+    QSet<const QObject*> m_tickConsumers; ///< Consumers currently wanting ticks
+    QString m_currentProjectId;       ///< ID of the most recently started project
     TimeEntryModel* m_timeEntryModel; ///< Model for time entries
+    quint64 m_dataVersion;            ///< Bumped on every time entry mutation
     bool m_initialized;               ///< Flag indicating if the controller is initialized
     static TimeTrackingController *s_instance; ///< Singleton instance
 };
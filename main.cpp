@@ -6,7 +6,8 @@
  * It handles:
  * - Application setup (name, organization, icon)
  * - Single instance enforcement using QLocalServer/QLocalSocket
- * - Custom message handling for logging
+ * - Asynchronous file logging (see Logger)
+ * - Startup tracing when TODOWIDGET_TRACE is set (see Tracer)
  * - Stylesheet loading
  * - Database initialization
  * - Settings loading
@@ -24,12 +25,15 @@
 #include <QLocalServer>
 #include <QLocalSocket>
 #include <QSharedMemory>
+#include <QTimer>
 #include "controllers/taskcontroller.h"
 #include "controllers/categorycontroller.h"
 #include "controllers/projectcontroller.h"
 #include "controllers/timetrackingcontroller.h"
 #include "controllers/notificationcontroller.h"
 #include "views/mainwindow.h"
+#include "services/logger.h"
+#include "services/tracer.h"
 
 /**
  * @brief Clean up all singleton instances
@@ -46,86 +50,6 @@ void cleanupSingletons()
     NotificationController::cleanup();
 }
 
-/**
- * @brief Custom message handler for Qt logging
- * 
- * Redirects Qt's logging messages to a file in the application data directory
- * while preserving output to the console. Formats log entries with timestamps
- * and contextual information based on message severity.
- *
- * @param type The severity level of the message
- * @param context Additional context information about where the message originated
- * @param msg The actual message text
- */
-void customMessageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg)
-{
-    // Get the application data location for storing logs
-    QString logPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
-    QDir logDir(logPath);
-
-    // Create directory if it doesn't exist
-    if (!logDir.exists()) {
-        logDir.mkpath(".");
-    }
-
-    // Create or open log file (append mode)
-    QFile logFile(logDir.filePath("todowidget.log"));
-    if (!logFile.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
-        // Fall back to standard output if file can't be opened
-        fprintf(stderr, "Warning: Could not open log file for writing\n");
-        return;
-    }
-
-    // Format current date and time
-    QString timestamp = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss.zzz");
-
-    // Format based on message type
-    QString logEntry;
-    switch (type) {
-    case QtDebugMsg:
-        logEntry = QString("[%1] [Debug] %2").arg(timestamp, msg);
-        break;
-    case QtInfoMsg:
-        logEntry = QString("[%1] [Info] %2").arg(timestamp, msg);
-        break;
-    case QtWarningMsg:
-        logEntry = QString("[%1] [Warning] %2 (%3:%4, %5)").arg(
-            timestamp, msg,
-            QString(context.file ? context.file : "unknown"),
-            QString::number(context.line),
-            QString(context.function ? context.function : "unknown"));
-        break;
-    case QtCriticalMsg:
-        logEntry = QString("[%1] [Critical] %2 (%3:%4, %5)").arg(
-            timestamp, msg,
-            QString(context.file ? context.file : "unknown"),
-            QString::number(context.line),
-            QString(context.function ? context.function : "unknown"));
-        break;
-    case QtFatalMsg:
-        logEntry = QString("[%1] [Fatal] %2 (%3:%4, %5)").arg(
-            timestamp, msg,
-            QString(context.file ? context.file : "unknown"),
-            QString::number(context.line),
-            QString(context.function ? context.function : "unknown"));
-        break;
-    }
-
-    // Write to log file
-    logEntry += "\n";
-    logFile.write(logEntry.toUtf8());
-    logFile.flush();
-
-    // Also output to console for development purposes
-    fprintf(stderr, "%s\n", qPrintable(logEntry));
-
-    // In case of fatal error, flush and close before aborting
-    if (type == QtFatalMsg) {
-        logFile.close();
-        abort();
-    }
-}
-
 /**
  * @brief Application entry point
  * 
@@ -138,12 +62,15 @@ void customMessageHandler(QtMsgType type, const QMessageLogContext &context, con
  */
 int main(int argc, char *argv[])
 {
-    // Set up logging
-    //qInstallMessageHandler(customMessageHandler);
+    // Record startup from the first line when a trace file is requested
+    const QString traceFile = Tracer::instance().enableFromEnvironment();
+    TraceScope startupTrace("Startup", "startup");
 
     qInfo() << "Application starting up";
 
+    TraceScope applicationTrace("Create application", "startup");
     QApplication app(argc, argv);
+    applicationTrace.end();
 
     // Set application information
     qInfo() << "Setting up application information";
@@ -151,6 +78,14 @@ int main(int argc, char *argv[])
     app.setOrganizationName("TODO Widget");
     app.setOrganizationDomain("todowidget.example.com");
 
+    // Set up logging, which needs the application name for its location
+    QDir logDir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation));
+    Logger::instance().install(logDir.filePath("todowidget.log"));
+#ifdef QT_NO_DEBUG
+    // Debug messages are logged on every window move and timer tick
+    Logger::instance().setLevel("default", QtInfoMsg);
+#endif
+
     // Set application icon
     qInfo() << "Setting application icon";
     app.setWindowIcon(QIcon(":/icons/app_icon.svg"));
@@ -203,11 +138,14 @@ int main(int argc, char *argv[])
 
     // Load application stylesheet
     qInfo() << "Loading stylesheet";
-    QFile styleFile(":/styles/app_style.qss");
-    if (styleFile.open(QFile::ReadOnly)) {
-        QString styleSheet = QLatin1String(styleFile.readAll());
-        app.setStyleSheet(styleSheet);
-        styleFile.close();
+    {
+        TRACE_SCOPE("Load stylesheet", "startup");
+        QFile styleFile(":/styles/app_style.qss");
+        if (styleFile.open(QFile::ReadOnly)) {
+            QString styleSheet = QLatin1String(styleFile.readAll());
+            app.setStyleSheet(styleSheet);
+            styleFile.close();
+        }
     }
 
     // Initialize database
@@ -219,21 +157,40 @@ int main(int argc, char *argv[])
 
     // Load settings
     qInfo() << "Loading settings";
-    SettingsManager::instance().load();
+    {
+        TRACE_SCOPE("Load settings", "startup");
+        SettingsManager::instance().load();
+    }
 
     // Create and show main window
     qInfo() << "Creating main window";
+    TraceScope windowTrace("Create main window", "startup");
     MainWindow mainWindow;
+    windowTrace.end();
 
     // Show the window if not starting minimized
     qInfo() << "Showing main window";
+    TraceScope showTrace("Show main window", "startup");
     if (!SettingsManager::instance().startMinimized()) {
         mainWindow.show();
     }
 
+    // Startup ends when the event loop first gets control
+    QTimer::singleShot(0, &app, [&startupTrace, &showTrace]() {
+        showTrace.end();
+        startupTrace.end();
+    });
+
     qInfo() << "Entering application event loop";
     int result = app.exec();
     
+    if (!traceFile.isEmpty()) {
+        Tracer::instance().exportChromeTrace(traceFile);
+    }
+    
+    // Write settings changed less than the save delay ago
+    SettingsManager::instance().flush();
+    
     // Clean up singletons before exit
     cleanupSingletons();
     
@@ -11,6 +11,7 @@
  */
 
 #include "categorymodel.h"
+#include "../services/tracer.h"
 
 /**
  * @brief Constructor
@@ -225,6 +226,8 @@ QList<Category> CategoryModel::getCategories() const
  */
 void CategoryModel::setCategories(const QList<Category> &categories)
 {
+    TRACE_FUNCTION("model");
+
     beginResetModel();
     m_categories = categories;
     endResetModel();
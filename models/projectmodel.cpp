@@ -14,6 +14,7 @@
 #include <QDebug>
 
 #include "projectmodel.h"
+#include "../services/tracer.h"
 
 /**
  * @brief Constructor for ProjectModel
@@ -262,6 +263,8 @@ QList<Project> ProjectModel::getActiveProjects() const
  */
 void ProjectModel::setProjects(const QList<Project> &projects)
 {
+    TRACE_FUNCTION("model");
+
     beginResetModel();
     m_projects = projects;
     endResetModel();
@@ -12,6 +12,8 @@
 #include "task.h"
 #include <QUuid>
 #include <QJsonObject>
+#include <QCryptographicHash>
+#include <QDataStream>
 
 /**
  * @brief Default constructor
@@ -121,3 +123,27 @@ Task Task::fromJson(const QJsonObject& json) {
 
     return task;
 }
+
+/**
+ * @brief Compute a hash of the task's content
+ * 
+ * The fields are serialized in a fixed order and hashed with MD5, of which
+ * the first 64 bits are kept.
+ * 
+ * @return quint64 The content hash
+ */
+quint64 Task::contentHash() const
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << m_title << m_description << m_isCompleted
+           << (m_createdDate.isValid() ? m_createdDate.toMSecsSinceEpoch() : qint64(-1))
+           << (m_dueDate.isValid() ? m_dueDate.toMSecsSinceEpoch() : qint64(-1))
+           << m_categoryId << qint32(m_priority);
+    
+    QByteArray digest = QCryptographicHash::hash(data, QCryptographicHash::Md5);
+    QDataStream digestStream(digest);
+    quint64 hash = 0;
+    digestStream >> hash;
+    return hash;
+}
@@ -160,6 +160,17 @@ public:
      */
     QJsonObject toJson() const;
     
+    /**
+     * @brief Compute a hash of the task's content
+     * 
+     * Covers every field except the ID and the display order, which only
+     * reflects where the task sits in one list, so copies of the same task
+     * hash equally.
+     * 
+     * @return quint64 The content hash
+     */
+    quint64 contentHash() const;
+    
     /**
      * @brief Create a task from a JSON object
      * 
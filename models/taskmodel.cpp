@@ -11,6 +11,7 @@
  */
 
 #include "taskmodel.h"
+#include "../services/tracer.h"
 #include <algorithm>
 #include <QMimeData>
 #include <QDataStream>
@@ -402,6 +403,8 @@ QList<Task> TaskModel::getTasks() const
  */
 void TaskModel::setTasks(const QList<Task> &tasks)
 {
+    TRACE_FUNCTION("model");
+
     beginResetModel();
     
     // Make a copy of the tasks that we can modify
@@ -535,6 +538,8 @@ void TaskModel::updateDisplayOrders()
  */
 void TaskModel::filterByCategory(const QString &categoryId)
 {
+    TRACE_FUNCTION("model");
+
     beginResetModel();
 
     if (categoryId.isEmpty()) {
@@ -565,6 +570,8 @@ void TaskModel::filterByCategory(const QString &categoryId)
  */
 void TaskModel::clearFilter()
 {
+    TRACE_FUNCTION("model");
+
     if (m_isFiltered) {
         beginResetModel();
         m_isFiltered = false;
@@ -582,6 +589,8 @@ void TaskModel::clearFilter()
  */
 void TaskModel::sortByDueDate(bool ascending)
 {
+    TRACE_FUNCTION("model");
+
     beginResetModel();
 
     auto comparator = [ascending](const Task &a, const Task &b) {
@@ -618,6 +627,8 @@ void TaskModel::sortByDueDate(bool ascending)
  */
 void TaskModel::sortByPriority(bool ascending)
 {
+    TRACE_FUNCTION("model");
+
     beginResetModel();
 
     auto comparator = [ascending](const Task &a, const Task &b) {
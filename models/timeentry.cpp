@@ -13,6 +13,8 @@
 
 #include "timeentry.h"
 #include <QUuid>
+#include <QCryptographicHash>
+#include <QDataStream>
 
 /**
  * @brief Default constructor for TimeEntry
@@ -169,6 +171,10 @@ QJsonObject TimeEntry::toJson() const
         json["notes"] = m_notes;
     }
     
+    if (m_modifiedAt.isValid()) {
+        json["modifiedAt"] = m_modifiedAt.toString(Qt::ISODate);
+    }
+    
     return json;
 }
 
@@ -208,5 +214,32 @@ TimeEntry TimeEntry::fromJson(const QJsonObject& json)
         entry.setNotes(json["notes"].toString());
     }
     
+    if (json.contains("modifiedAt")) {
+        entry.setModifiedAt(QDateTime::fromString(json["modifiedAt"].toString(), Qt::ISODate));
+    }
+    
     return entry;
 }
+
+/**
+ * @brief Compute a hash of the entry's content
+ * 
+ * The fields are serialized in a fixed order and hashed with MD5, of which
+ * the first 64 bits are kept. Running entries hash without a duration.
+ * 
+ * @return quint64 The content hash
+ */
+quint64 TimeEntry::contentHash() const
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << m_projectId << m_startTime.toMSecsSinceEpoch()
+           << (m_endTime.isValid() ? m_endTime.toMSecsSinceEpoch() : qint64(-1))
+           << qint32(isRunning() ? -1 : duration()) << m_notes;
+    
+    QByteArray digest = QCryptographicHash::hash(data, QCryptographicHash::Md5);
+    QDataStream digestStream(digest);
+    quint64 hash = 0;
+    digestStream >> hash;
+    return hash;
+}
@@ -92,6 +92,12 @@ public:
      * @return QString The notes associated with this time entry
      */
     QString notes() const { return m_notes; }
+    
+    /**
+     * @brief Get the time of the last change recorded by the database
+     * @return QDateTime The modification time, invalid for entries not loaded from the database
+     */
+    QDateTime modifiedAt() const { return m_modifiedAt; }
 
     /**
      * @brief Set the time entry's unique identifier
@@ -129,6 +135,12 @@ public:
      */
     void setNotes(const QString& notes) { m_notes = notes; }
     
+    /**
+     * @brief Set the time of the last change
+     * @param modifiedAt The modification time
+     */
+    void setModifiedAt(const QDateTime& modifiedAt) { m_modifiedAt = modifiedAt; }
+    
     /**
      * @brief Check if the time entry is currently running
      * @return bool True if the time entry is still running (no end time), false otherwise
@@ -146,6 +158,16 @@ public:
      * @return int The elapsed time in seconds from start time to now
      */
     int elapsedSeconds() const;
+    
+    /**
+     * @brief Compute a hash of the entry's content
+     * 
+     * Covers the project, times, duration and notes but not the ID or the
+     * modification time, so copies of the same entry hash equally.
+     * 
+     * @return quint64 The content hash
+     */
+    quint64 contentHash() const;
 
     /**
      * @brief Convert the time entry to a JSON object
@@ -173,4 +195,5 @@ private:
     QDateTime m_endTime;      ///< When tracking ended (can be null)
     int m_duration;           ///< Duration in seconds (calculated or manual)
     QString m_notes;          ///< Optional notes
+    QDateTime m_modifiedAt;   ///< Last change recorded by the database (can be null)
 };
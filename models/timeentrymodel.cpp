@@ -12,6 +12,8 @@
  */
 
 #include "timeentrymodel.h"
+#include "../services/tracer.h"
+#include <algorithm>
 
 /**
  * @brief Constructor for TimeEntryModel
@@ -119,6 +121,7 @@ bool TimeEntryModel::setData(const QModelIndex &index, const QVariant &value, in
             break;
         case EndTimeRole:
             entry.setEndTime(value.toDateTime());
+            updateRunningRow(index.row());
             success = true;
             break;
         case DurationRole:
@@ -187,6 +190,14 @@ void TimeEntryModel::addTimeEntry(const TimeEntry &entry)
 {
     beginInsertRows(QModelIndex(), 0, 0);
     m_timeEntries.prepend(entry);
+    
+    // Prepending shifts every existing row down by one
+    for (int &row : m_runningRows) {
+        ++row;
+    }
+    if (entry.isRunning()) {
+        m_runningRows.prepend(0);
+    }
     endInsertRows();
 }
 
@@ -207,6 +218,13 @@ bool TimeEntryModel::removeTimeEntry(const QString &id)
     
     beginRemoveRows(QModelIndex(), index, index);
     m_timeEntries.removeAt(index);
+    
+    m_runningRows.removeOne(index);
+    for (int &row : m_runningRows) {
+        if (row > index) {
+            --row;
+        }
+    }
     endRemoveRows();
     
     return true;
@@ -247,8 +265,18 @@ QList<TimeEntry> TimeEntryModel::getTimeEntries() const
  */
 void TimeEntryModel::setTimeEntries(const QList<TimeEntry> &entries)
 {
+    TRACE_FUNCTION("model");
+
     beginResetModel();
     m_timeEntries = entries;
+    
+    // Full reload is the only place running entries have to be searched for
+    m_runningRows.clear();
+    for (int i = 0; i < m_timeEntries.size(); ++i) {
+        if (m_timeEntries.at(i).isRunning()) {
+            m_runningRows.append(i);
+        }
+    }
     endResetModel();
 }
 
@@ -268,6 +296,7 @@ bool TimeEntryModel::updateTimeEntry(const TimeEntry &entry)
     }
     
     m_timeEntries[index] = entry;
+    updateRunningRow(index);
     QModelIndex modelIndex = createIndex(index, 0);
     emit dataChanged(modelIndex, modelIndex);
     
@@ -338,15 +367,26 @@ int TimeEntryModel::getTotalDuration(const QDate &date) const
     QDateTime dayStart = QDateTime(date, QTime(0, 0, 0));
     QDateTime dayEnd = QDateTime(date, QTime(23, 59, 59, 999));
     
-    for (const TimeEntry &entry : m_timeEntries) {
+    // Only the tracked running rows need the current time, so read it once
+    const QDateTime now = m_runningRows.isEmpty() ? QDateTime() : QDateTime::currentDateTime();
+    int nextRunning = 0;
+    
+    for (int i = 0; i < m_timeEntries.size(); ++i) {
+        const TimeEntry &entry = m_timeEntries.at(i);
+        
+        // Running rows are sorted, so a single cursor identifies them
+        const bool running = nextRunning < m_runningRows.size() && m_runningRows.at(nextRunning) == i;
+        if (running) {
+            ++nextRunning;
+        }
         // Only count entries that start or end within the specified date
         if ((entry.startTime() >= dayStart && entry.startTime() <= dayEnd) ||
             (!entry.endTime().isNull() && entry.endTime() >= dayStart && entry.endTime() <= dayEnd)) {
                 
             // If the entry spans beyond the day, only count the portion within the day
             QDateTime entryStart = entry.startTime() < dayStart ? dayStart : entry.startTime();
-            QDateTime entryEnd = entry.isRunning() ? 
-                QDateTime::currentDateTime() : 
+            QDateTime entryEnd = running ? 
+                now : 
                 (entry.endTime() > dayEnd ? dayEnd : entry.endTime());
                 
             total += entryStart.secsTo(entryEnd);
@@ -372,15 +412,26 @@ QMap<QString, int> TimeEntryModel::getDurationsByProject(const QDate &startDate,
     QDateTime rangeStart = QDateTime(startDate, QTime(0, 0, 0));
     QDateTime rangeEnd = QDateTime(endDate, QTime(23, 59, 59, 999));
     
-    for (const TimeEntry &entry : m_timeEntries) {
+    // Only the tracked running rows need the current time, so read it once
+    const QDateTime now = m_runningRows.isEmpty() ? QDateTime() : QDateTime::currentDateTime();
+    int nextRunning = 0;
+    
+    for (int i = 0; i < m_timeEntries.size(); ++i) {
+        const TimeEntry &entry = m_timeEntries.at(i);
+        
+        // Running rows are sorted, so a single cursor identifies them
+        const bool running = nextRunning < m_runningRows.size() && m_runningRows.at(nextRunning) == i;
+        if (running) {
+            ++nextRunning;
+        }
         // Only count entries that start or end within the date range
         if ((entry.startTime() >= rangeStart && entry.startTime() <= rangeEnd) ||
             (!entry.endTime().isNull() && entry.endTime() >= rangeStart && entry.endTime() <= rangeEnd)) {
                 
             // If the entry spans beyond the range, only count the portion within the range
             QDateTime entryStart = entry.startTime() < rangeStart ? rangeStart : entry.startTime();
-            QDateTime entryEnd = entry.isRunning() ? 
-                QDateTime::currentDateTime() : 
+            QDateTime entryEnd = running ? 
+                now : 
                 (entry.endTime() > rangeEnd ? rangeEnd : entry.endTime());
                 
             int duration = entryStart.secsTo(entryEnd);
@@ -422,19 +473,33 @@ QMap<QDate, int> TimeEntryModel::getDurationsByDay(const QDate &startDate, const
 /**
  * @brief Get the currently running time entry
  * 
- * Finds the first time entry that is in a running state (no end time).
+ * Returns the most recently added running entry without scanning the list.
  * 
  * @return The running TimeEntry object, or an empty TimeEntry if none is running
  */
 TimeEntry TimeEntryModel::getRunningTimeEntry() const
 {
-    for (const TimeEntry &entry : m_timeEntries) {
-        if (entry.isRunning()) {
-            return entry;
-        }
+    if (m_runningRows.isEmpty()) {
+        return TimeEntry();
+    }
+    
+    return m_timeEntries.at(m_runningRows.first());
+}
+
+/**
+ * @brief Get all currently running time entries
+ * 
+ * @return The running TimeEntry objects in row order
+ */
+QList<TimeEntry> TimeEntryModel::getRunningTimeEntries() const
+{
+    QList<TimeEntry> result;
+    
+    for (int row : m_runningRows) {
+        result.append(m_timeEntries.at(row));
     }
     
-    return TimeEntry();
+    return result;
 }
 
 /**
@@ -444,13 +509,7 @@ TimeEntry TimeEntryModel::getRunningTimeEntry() const
  */
 bool TimeEntryModel::hasRunningTimeEntry() const
 {
-    for (const TimeEntry &entry : m_timeEntries) {
-        if (entry.isRunning()) {
-            return true;
-        }
-    }
-    
-    return false;
+    return !m_runningRows.isEmpty();
 }
 
 /**
@@ -471,3 +530,25 @@ int TimeEntryModel::findIndexById(const QString &id) const
     
     return -1;
 }
+
+/**
+ * @brief Refresh the running row after a single row changed
+ * 
+ * Keeps m_runningRows sorted and consistent when the entry at the given row is
+ * replaced or its end time is edited, without rescanning the rest of the list.
+ * 
+ * @param row The row that was modified
+ */
+void TimeEntryModel::updateRunningRow(int row)
+{
+    auto it = std::lower_bound(m_runningRows.begin(), m_runningRows.end(), row);
+    bool tracked = it != m_runningRows.end() && *it == row;
+    
+    if (m_timeEntries.at(row).isRunning()) {
+        if (!tracked) {
+            m_runningRows.insert(it, row);
+        }
+    } else if (tracked) {
+        m_runningRows.erase(it);
+    }
+}
\ No newline at end of file
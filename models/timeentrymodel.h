@@ -181,10 +181,16 @@ public:
     
     /**
      * @brief Get any currently running time entry
-     * @return TimeEntry The currently running time entry, or an empty entry if none is running
+     * @return TimeEntry The most recently added running entry, or an empty entry if none is running
      */
     TimeEntry getRunningTimeEntry() const;
     
+    /**
+     * @brief Get all currently running time entries
+     * @return QList<TimeEntry> The running time entries in row order
+     */
+    QList<TimeEntry> getRunningTimeEntries() const;
+    
     /**
      * @brief Check if there is a running time entry
      * @return bool True if there is a running time entry, false otherwise
@@ -193,6 +199,7 @@ public:
 
 private:
     QList<TimeEntry> m_timeEntries;  ///< The list of time entries
+    QList<int> m_runningRows;        ///< Sorted rows of running entries
     
     /**
      * @brief Find the index of an entry with the specified ID
@@ -200,4 +207,10 @@ private:
      * @return int The index of the entry, or -1 if not found
      */
     int findIndexById(const QString &id) const;
+    
+    /**
+     * @brief Refresh the running row after a single row changed
+     * @param row The row that was modified
+     */
+    void updateRunningRow(int row);
 };
@@ -0,0 +1,141 @@
+/**
+ * @file timereportmodel.cpp
+ * @brief Implementation of the TimeReportModel class
+ * 
+ * The TimeReportModel class exposes typed report rows to the report table.
+ * Display values are derived from the stored seconds on demand.
+ * 
+ * @author Cornebidouil
+ * @date Last updated: April 30, 2025
+ */
+
+#include "timereportmodel.h"
+#include "../services/tracer.h"
+
+/**
+ * @brief Constructor for TimeReportModel
+ * 
+ * @param parent The parent QObject
+ */
+TimeReportModel::TimeReportModel(QObject *parent)
+    : QAbstractTableModel(parent)
+    , m_totalSeconds(0)
+{
+}
+
+/**
+ * @brief Get the number of rows in the model
+ * 
+ * @param parent The parent model index (unused in table models)
+ * @return The number of report rows
+ */
+int TimeReportModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+    return m_rows.size();
+}
+
+/**
+ * @brief Get the number of columns in the model
+ * 
+ * @param parent The parent model index (unused in table models)
+ * @return The number of columns
+ */
+int TimeReportModel::columnCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+    return ColumnCount;
+}
+
+/**
+ * @brief Get data for a specific model index and role
+ * 
+ * Hours and minutes are computed from the row's seconds. SortRole returns the
+ * seconds for numeric columns so sorting is numeric rather than lexical.
+ * 
+ * @param index The model index to get data for
+ * @param role The data role
+ * @return The requested data as a QVariant
+ */
+QVariant TimeReportModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_rows.size()) {
+        return QVariant();
+    }
+    
+    const ReportRow &row = m_rows.at(index.row());
+    
+    switch (role) {
+        case Qt::DisplayRole:
+            switch (index.column()) {
+                case LabelColumn:
+                    return row.label;
+                case HoursColumn:
+                    return row.seconds / 3600;
+                case MinutesColumn:
+                    return (row.seconds % 3600) / 60;
+                default:
+                    return QVariant();
+            }
+        case SortRole:
+            return index.column() == LabelColumn ? QVariant(row.label) : QVariant(row.seconds);
+        case SecondsRole:
+            return row.seconds;
+        case ColorRole:
+            return row.color;
+        case ProjectIdRole:
+            return row.projectId;
+        default:
+            return QVariant();
+    }
+}
+
+/**
+ * @brief Get header data
+ * 
+ * @param section The column number
+ * @param orientation The header orientation
+ * @param role The data role
+ * @return The column title for horizontal display headers
+ */
+QVariant TimeReportModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+    
+    switch (section) {
+        case LabelColumn:
+            return m_labelHeader;
+        case HoursColumn:
+            return "Hours";
+        case MinutesColumn:
+            return "Minutes";
+        default:
+            return QVariant();
+    }
+}
+
+/**
+ * @brief Replace the report rows
+ * 
+ * @param labelHeader Header of the label column
+ * @param rows The new rows
+ * @param totalSeconds Total tracked time of the report
+ */
+void TimeReportModel::setRows(const QString &labelHeader, const QVector<ReportRow> &rows, int totalSeconds)
+{
+    TRACE_FUNCTION("model");
+
+    beginResetModel();
+    m_labelHeader = labelHeader;
+    m_rows = rows;
+    m_totalSeconds = totalSeconds;
+    endResetModel();
+    
+    emit headerDataChanged(Qt::Horizontal, LabelColumn, LabelColumn);
+}
@@ -0,0 +1,136 @@
+/**
+ * @file timereportmodel.h
+ * @brief Definition of the TimeReportModel class
+ * 
+ * This file defines the TimeReportModel class which holds the rows of a time
+ * report. It inherits from QAbstractTableModel to provide model/view integration
+ * with the report table, and exposes its typed rows to the chart and exporters.
+ * 
+ * @author Cornebidouil
+ * @date Last updated: April 30, 2025
+ */
+
+#pragma once
+
+#include <QAbstractTableModel>
+#include <QVector>
+#include <QColor>
+#include <QString>
+#include <QDate>
+
+/**
+ * @struct ReportRow
+ * @brief A single aggregated row of a time report
+ */
+struct ReportRow {
+    QString label;       ///< Display label (date or project name)
+    int seconds = 0;     ///< Tracked time in seconds
+    QColor color;        ///< Chart color, invalid to use a generated color
+    QString projectId;   ///< Project ID for project rows, empty otherwise
+    QDate periodStart;   ///< First day of the row's period, invalid for project totals
+};
+
+/**
+ * @class TimeReportModel
+ * @brief Table model for time report rows
+ * 
+ * The TimeReportModel class stores report rows as a typed vector. Hours and
+ * minutes are derived from the stored seconds when the table asks for them, so
+ * there is no per-cell allocation and no value ever has to be parsed back from text.
+ */
+class TimeReportModel : public QAbstractTableModel {
+    Q_OBJECT
+    
+public:
+    /**
+     * @brief Table columns
+     */
+    enum Column {
+        LabelColumn,
+        HoursColumn,
+        MinutesColumn,
+        ColumnCount
+    };
+    
+    /**
+     * @brief Custom roles for report data
+     */
+    enum TimeReportRoles {
+        SecondsRole = Qt::UserRole + 1,
+        ColorRole,
+        ProjectIdRole,
+        SortRole
+    };
+    
+    /**
+     * @brief Constructor
+     * @param parent Optional parent object
+     */
+    explicit TimeReportModel(QObject *parent = nullptr);
+    
+    // QAbstractItemModel implementation
+    
+    /**
+     * @brief Get the number of rows in the model
+     * @param parent Parent model index (unused)
+     * @return int Number of report rows
+     */
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    
+    /**
+     * @brief Get the number of columns in the model
+     * @param parent Parent model index (unused)
+     * @return int Number of columns
+     */
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    
+    /**
+     * @brief Get data for a specific index and role
+     * @param index Model index to get data for
+     * @param role Data role
+     * @return QVariant The requested data
+     */
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    
+    /**
+     * @brief Get header data
+     * @param section Column or row number
+     * @param orientation Header orientation
+     * @param role Data role
+     * @return QVariant The header data
+     */
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    
+    // Report management methods
+    
+    /**
+     * @brief Replace the report rows
+     * @param labelHeader Header of the label column (e.g. "Date" or "Project")
+     * @param rows The new rows
+     * @param totalSeconds Total tracked time of the report
+     */
+    void setRows(const QString &labelHeader, const QVector<ReportRow> &rows, int totalSeconds);
+    
+    /**
+     * @brief Get the report rows
+     * @return const QVector<ReportRow>& The rows in model order
+     */
+    const QVector<ReportRow>& rows() const { return m_rows; }
+    
+    /**
+     * @brief Get the header of the label column
+     * @return QString The label header
+     */
+    QString labelHeader() const { return m_labelHeader; }
+    
+    /**
+     * @brief Get the total tracked time of the report
+     * @return int Total seconds
+     */
+    int totalSeconds() const { return m_totalSeconds; }
+
+private:
+    QVector<ReportRow> m_rows;   ///< The report rows
+    QString m_labelHeader;       ///< Header of the label column
+    int m_totalSeconds;          ///< Total tracked time in seconds
+};
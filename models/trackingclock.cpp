@@ -0,0 +1,134 @@
+/**
+ * @file trackingclock.cpp
+ * @brief Implementation of the TrackingClock class
+ * 
+ * The TrackingClock measures running timers with a monotonic counter and uses
+ * the wall clock only to anchor the start time. Suspend gaps are read from the
+ * platform's boot-time clock where one exists.
+ * 
+ * @author Cornebidouil
+ * @date Last updated: April 29, 2025
+ */
+
+#include "trackingclock.h"
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#elif defined(Q_OS_LINUX) || defined(Q_OS_MACOS)
+#include <time.h>
+#endif
+
+/**
+ * @brief Default constructor for TrackingClock
+ * 
+ * Creates an invalid clock with no anchor.
+ */
+TrackingClock::TrackingClock()
+    : m_anchor(QDateTime())
+    , m_baseMSecs(0)
+    , m_suspendedMSecs(0)
+    , m_syncWallMSecs(0)
+    , m_syncMonoMSecs(0)
+    , m_syncSleepMSecs(-1)
+{
+}
+
+/**
+ * @brief Start the clock
+ * 
+ * Records the anchor and starts the monotonic counter. Time between the anchor
+ * and now is taken once from the wall clock and never re-read afterwards.
+ * 
+ * @param anchor Wall-clock time the tracked period started
+ */
+void TrackingClock::start(const QDateTime& anchor)
+{
+    qint64 nowMSecs = QDateTime::currentMSecsSinceEpoch();
+    
+    m_anchor = anchor;
+    m_baseMSecs = anchor.isValid() ? qMax<qint64>(0, nowMSecs - anchor.toMSecsSinceEpoch()) : 0;
+    m_suspendedMSecs = 0;
+    m_clock.start();
+    m_syncWallMSecs = nowMSecs;
+    m_syncMonoMSecs = 0;
+    if (!systemSleepMSecs(&m_syncSleepMSecs)) {
+        m_syncSleepMSecs = -1;
+    }
+}
+
+/**
+ * @brief Credit the time the system slept since the previous sync
+ * 
+ * With a boot-time clock the slept time is read directly, so wall-clock steps
+ * in either direction have no effect. Otherwise a forward divergence of the
+ * wall clock above the threshold is credited as suspend time and backward
+ * jumps are ignored. Either way the elapsed time can never decrease.
+ * 
+ * @return qint64 Newly detected suspend gap in milliseconds, or 0 if none
+ */
+qint64 TrackingClock::resync()
+{
+    if (!m_clock.isValid()) {
+        return 0;
+    }
+    
+    qint64 wallMSecs = QDateTime::currentMSecsSinceEpoch();
+    qint64 monoMSecs = m_clock.elapsed();
+    qint64 gap = 0;
+    
+    qint64 sleepMSecs = 0;
+    if (m_syncSleepMSecs >= 0 && systemSleepMSecs(&sleepMSecs)) {
+        gap = qMax<qint64>(0, sleepMSecs - m_syncSleepMSecs);
+        m_syncSleepMSecs = sleepMSecs;
+    } else {
+        qint64 divergence = (wallMSecs - m_syncWallMSecs) - (monoMSecs - m_syncMonoMSecs);
+        gap = divergence > SUSPEND_THRESHOLD_MS ? divergence : 0;
+    }
+    
+    m_suspendedMSecs += gap;
+    m_syncWallMSecs = wallMSecs;
+    m_syncMonoMSecs = monoMSecs;
+    
+    return gap;
+}
+
+/**
+ * @brief Read the total time the system has slept since boot
+ * 
+ * The difference between a clock that counts suspend and one that does not.
+ * 
+ * @param sleptMSecs Receives the slept milliseconds
+ * @return bool True if the platform provides a boot-time clock, false otherwise
+ */
+bool TrackingClock::systemSleepMSecs(qint64* sleptMSecs)
+{
+#if defined(Q_OS_WIN)
+    ULONGLONG unbiased = 0;
+    if (!QueryUnbiasedInterruptTime(&unbiased)) {
+        return false;
+    }
+    // GetTickCount64 counts suspend, the unbiased interrupt time (100 ns units) does not
+    *sleptMSecs = qMax<qint64>(0, static_cast<qint64>(GetTickCount64()) - static_cast<qint64>(unbiased / 10000));
+    return true;
+#elif defined(Q_OS_LINUX) || defined(Q_OS_MACOS)
+#if defined(Q_OS_LINUX)
+    const clockid_t withSleep = CLOCK_BOOTTIME;
+    const clockid_t withoutSleep = CLOCK_MONOTONIC;
+#else
+    const clockid_t withSleep = CLOCK_MONOTONIC;
+    const clockid_t withoutSleep = CLOCK_UPTIME_RAW;
+#endif
+    timespec boot;
+    timespec mono;
+    if (clock_gettime(withSleep, &boot) != 0 || clock_gettime(withoutSleep, &mono) != 0) {
+        return false;
+    }
+    qint64 bootMSecs = static_cast<qint64>(boot.tv_sec) * 1000 + boot.tv_nsec / 1000000;
+    qint64 monoMSecs = static_cast<qint64>(mono.tv_sec) * 1000 + mono.tv_nsec / 1000000;
+    *sleptMSecs = qMax<qint64>(0, bootMSecs - monoMSecs);
+    return true;
+#else
+    Q_UNUSED(sleptMSecs);
+    return false;
+#endif
+}
@@ -0,0 +1,111 @@
+/**
+ * @file trackingclock.h
+ * @brief Definition of the TrackingClock class
+ * 
+ * This file defines the TrackingClock class which measures the elapsed time of a
+ * running timer. It pairs a wall-clock anchor with a monotonic counter so that
+ * durations stay correct across NTP corrections, DST changes and system suspend.
+ * 
+ * @author Cornebidouil
+ * @date Last updated: April 29, 2025
+ */
+
+#pragma once
+
+#include <QDateTime>
+#include <QElapsedTimer>
+
+/**
+ * @class TrackingClock
+ * @brief Monotonic elapsed-time source for running timers
+ * 
+ * The TrackingClock class reads elapsed time from a QElapsedTimer only, so the
+ * hot path never touches the wall clock and can never go backwards. The wall clock
+ * is never used to measure sleep: resync() reads how long the system slept since
+ * the previous sync from the difference between a boot-time clock, which keeps
+ * running during suspend, and a monotonic clock, which stops (CLOCK_BOOTTIME vs
+ * CLOCK_MONOTONIC on Linux, GetTickCount64 vs QueryUnbiasedInterruptTime on
+ * Windows). That gap is credited to the elapsed time so the tracked duration still
+ * matches the start and end times, while wall-clock steps (NTP, manual changes)
+ * are not mistaken for sleep. Platforms without such clocks fall back to comparing
+ * the wall clock with the monotonic counter.
+ */
+class TrackingClock {
+public:
+    /**
+     * @brief Default constructor
+     * 
+     * Creates an invalid clock. Call start() before reading it.
+     */
+    TrackingClock();
+    
+    /**
+     * @brief Start the clock
+     * 
+     * @param anchor Wall-clock time the tracked period started. If it lies in the
+     *        past (e.g. a resumed entry), the time since then is counted as already elapsed.
+     */
+    void start(const QDateTime& anchor);
+    
+    /**
+     * @brief Check if the clock has been started
+     * @return bool True if the clock is running, false otherwise
+     */
+    bool isValid() const { return m_clock.isValid(); }
+    
+    /**
+     * @brief Get the wall-clock anchor
+     * @return QDateTime The time the tracked period started
+     */
+    QDateTime anchor() const { return m_anchor; }
+    
+    /**
+     * @brief Get the elapsed time in milliseconds
+     * 
+     * Reads only the monotonic clock.
+     * 
+     * @return qint64 Elapsed milliseconds, including detected suspend gaps
+     */
+    qint64 elapsedMSecs() const { return m_baseMSecs + m_suspendedMSecs + m_clock.elapsed(); }
+    
+    /**
+     * @brief Get the elapsed time in seconds
+     * @return int Elapsed seconds, including detected suspend gaps
+     */
+    int elapsedSeconds() const { return static_cast<int>(elapsedMSecs() / 1000); }
+    
+    /**
+     * @brief Get the total suspend time detected so far
+     * @return qint64 Suspended milliseconds credited to the elapsed time
+     */
+    qint64 suspendedMSecs() const { return m_suspendedMSecs; }
+    
+    /**
+     * @brief Credit the time the system slept since the previous sync
+     * 
+     * Should be called at a coarse interval and before reading the clock after a
+     * period where the system may have slept.
+     * 
+     * @return qint64 Newly detected suspend gap in milliseconds, or 0 if none
+     */
+    qint64 resync();
+
+private:
+    /**
+     * @brief Read the total time the system has slept since boot
+     * 
+     * @param sleptMSecs Receives the slept milliseconds
+     * @return bool True if the platform provides a boot-time clock, false otherwise
+     */
+    static bool systemSleepMSecs(qint64* sleptMSecs);
+    
+    static const qint64 SUSPEND_THRESHOLD_MS = 10000; ///< Minimum wall/monotonic divergence treated as suspend by the fallback
+    
+    QElapsedTimer m_clock;    ///< Monotonic counter started with the clock
+    QDateTime m_anchor;       ///< Wall-clock start of the tracked period
+    qint64 m_baseMSecs;       ///< Time already elapsed when the counter was started
+    qint64 m_suspendedMSecs;  ///< Accumulated suspend gaps
+    qint64 m_syncWallMSecs;   ///< Wall clock (ms since epoch) at the last sync
+    qint64 m_syncMonoMSecs;   ///< Monotonic counter at the last sync
+    qint64 m_syncSleepMSecs;  ///< System sleep total at the last sync, or -1 without a boot-time clock
+};
@@ -0,0 +1,463 @@
+/**
+ * @file cborsnapshot.cpp
+ * @brief Implementation of the CborSnapshot class
+ * 
+ * The CborSnapshot streams the database to and from a compact CBOR document
+ * with QCborStreamWriter and QCborStreamReader.
+ * 
+ * @author Cornebidouil
+ * @date Last updated: April 30, 2025
+ */
+
+#include "cborsnapshot.h"
+#include "databasemanager.h"
+#include <QDebug>
+
+// Format marker at the start of every snapshot
+const char* const CborSnapshot::SNAPSHOT_MAGIC = "TODO-Widget snapshot";
+
+/**
+ * @brief Write a snapshot of the database
+ * 
+ * Categories, projects and tasks are small and loaded as lists; time entries
+ * are streamed from a database cursor into an indefinite-length array.
+ * 
+ * @param device The device to write to, opened for writing
+ * @param progressHandler Optional handler called every BATCH_SIZE time entries; returning false aborts the snapshot
+ * @return bool True if the snapshot was written, false otherwise
+ */
+bool CborSnapshot::write(QIODevice* device, const ProgressHandler& progressHandler)
+{
+    DatabaseManager& db = DatabaseManager::instance();
+    QCborStreamWriter writer(device);
+    
+    writer.startArray(6);
+    writer.append(QLatin1String(SNAPSHOT_MAGIC));
+    writer.append(quint64(FORMAT_VERSION));
+    
+    // Categories, indexed for task references
+    const QList<Category> categories = db.loadCategories();
+    QHash<QString, int> categoryIndex;
+    categoryIndex.reserve(categories.size());
+    
+    writer.startArray(categories.size());
+    for (const Category& category : categories) {
+        categoryIndex.insert(category.id(), categoryIndex.size());
+        writer.startArray(4);
+        writer.append(category.id());
+        writer.append(category.name());
+        writer.append(quint64(category.color().rgba()));
+        writer.append(category.isDefault());
+        writer.endArray();
+    }
+    writer.endArray();
+    
+    // Projects, indexed for time entry references
+    const QList<Project> projects = db.loadProjects();
+    QHash<QString, int> projectIndex;
+    projectIndex.reserve(projects.size());
+    
+    writer.startArray(projects.size());
+    for (const Project& project : projects) {
+        projectIndex.insert(project.id(), projectIndex.size());
+        writer.startArray(5);
+        writer.append(project.id());
+        writer.append(project.name());
+        writer.append(quint64(project.color().rgba()));
+        writer.append(project.description());
+        writer.append(project.isActive());
+        writer.endArray();
+    }
+    writer.endArray();
+    
+    // Tasks
+    const QList<Task> tasks = db.loadTasks();
+    writer.startArray(tasks.size());
+    for (const Task& task : tasks) {
+        writer.startArray(9);
+        writer.append(task.id());
+        writer.append(task.title());
+        writer.append(task.description());
+        writer.append(task.isCompleted());
+        appendDateTime(writer, task.createdDate());
+        appendDateTime(writer, task.dueDate());
+        appendReference(writer, categoryIndex, task.categoryId());
+        writer.append(qint64(task.priority()));
+        writer.append(qint64(task.displayOrder()));
+        writer.endArray();
+    }
+    writer.endArray();
+    
+    // Time entries, straight from the cursor
+    int written = categories.size() + projects.size() + tasks.size();
+    bool cancelled = progressHandler && !progressHandler(written);
+    
+    writer.startArray();
+    bool success = !cancelled && db.forEachTimeEntry([&](const TimeEntry& entry) {
+        writer.startArray(6);
+        writer.append(entry.id());
+        appendReference(writer, projectIndex, entry.projectId());
+        appendDateTime(writer, entry.startTime());
+        appendDateTime(writer, entry.endTime());
+        if (entry.isRunning()) {
+            writer.appendNull();
+        } else {
+            writer.append(qint64(entry.duration()));
+        }
+        writer.append(entry.notes());
+        writer.endArray();
+        
+        if (++written % BATCH_SIZE == 0 && progressHandler && !progressHandler(written)) {
+            cancelled = true;
+        }
+        return !cancelled;
+    });
+    writer.endArray();
+    
+    writer.endArray();
+    
+    if (cancelled) {
+        return false;
+    }
+    
+    if (!success) {
+        qWarning() << "Failed to read time entries for snapshot";
+        return false;
+    }
+    
+    return progressHandler ? progressHandler(written) : true;
+}
+
+/**
+ * @brief Restore a snapshot into the database
+ * 
+ * Reads the sections in order, rebuilding the category and project string
+ * tables before the records that refer to them, and writes every section in
+ * batches of BATCH_SIZE records.
+ * 
+ * @param device The device to read from, opened for reading
+ * @param recordCount Optional pointer receiving the number of records restored
+ * @param batchHandler Optional handler called after each written batch; returning false aborts the restore
+ * @return bool True if the whole snapshot was restored, false otherwise
+ */
+bool CborSnapshot::read(QIODevice* device, int* recordCount, const BatchHandler& batchHandler)
+{
+    DatabaseManager& db = DatabaseManager::instance();
+    QCborStreamReader reader(device);
+    int count = 0;
+    int replaced = 0;
+    int* replacedCount = batchHandler ? &replaced : nullptr;
+    
+    if (recordCount) *recordCount = 0;
+    
+    auto written = [&](int size) {
+        count += size;
+        if (recordCount) *recordCount = count;
+        return !batchHandler || batchHandler(size, replaced);
+    };
+    
+    if (!reader.isArray() || !reader.enterContainer()) {
+        qWarning() << "Not a snapshot: expected a CBOR array";
+        return false;
+    }
+    
+    if (readText(reader) != QLatin1String(SNAPSHOT_MAGIC)) {
+        qWarning() << "Not a snapshot: missing format marker";
+        return false;
+    }
+    
+    qint64 version = readInteger(reader, -1);
+    if (version < 1 || version > FORMAT_VERSION) {
+        qWarning() << "Unsupported snapshot version:" << version;
+        return false;
+    }
+    
+    // Categories
+    QStringList categoryIds;
+    QList<Category> categories;
+    if (!reader.isArray() || !reader.enterContainer()) {
+        qWarning() << "Invalid snapshot: missing categories";
+        return false;
+    }
+    while (reader.hasNext()) {
+        if (!enterRecord(reader)) {
+            continue;
+        }
+        
+        Category category;
+        category.setId(readText(reader));
+        category.setName(readText(reader));
+        category.setColor(QColor::fromRgba(QRgb(readInteger(reader))));
+        category.setDefault(readBool(reader));
+        leaveRecord(reader);
+        
+        categoryIds.append(category.id());
+        categories.append(category);
+        if (categories.size() >= BATCH_SIZE) {
+            if (!db.upsertCategories(categories, replacedCount) || !written(categories.size())) return false;
+            categories.clear();
+        }
+    }
+    reader.leaveContainer();
+    if (!categories.isEmpty() && (!db.upsertCategories(categories, replacedCount) || !written(categories.size()))) return false;
+    
+    // Projects
+    QStringList projectIds;
+    QList<Project> projects;
+    if (!reader.isArray() || !reader.enterContainer()) {
+        qWarning() << "Invalid snapshot: missing projects";
+        return false;
+    }
+    while (reader.hasNext()) {
+        if (!enterRecord(reader)) {
+            continue;
+        }
+        
+        Project project;
+        project.setId(readText(reader));
+        project.setName(readText(reader));
+        project.setColor(QColor::fromRgba(QRgb(readInteger(reader))));
+        project.setDescription(readText(reader));
+        project.setActive(readBool(reader));
+        leaveRecord(reader);
+        
+        projectIds.append(project.id());
+        projects.append(project);
+        if (projects.size() >= BATCH_SIZE) {
+            if (!db.upsertProjects(projects, replacedCount) || !written(projects.size())) return false;
+            projects.clear();
+        }
+    }
+    reader.leaveContainer();
+    if (!projects.isEmpty() && (!db.upsertProjects(projects, replacedCount) || !written(projects.size()))) return false;
+    
+    // Tasks
+    QList<Task> tasks;
+    if (!reader.isArray() || !reader.enterContainer()) {
+        qWarning() << "Invalid snapshot: missing tasks";
+        return false;
+    }
+    while (reader.hasNext()) {
+        if (!enterRecord(reader)) {
+            continue;
+        }
+        
+        Task task;
+        task.setId(readText(reader));
+        task.setTitle(readText(reader));
+        task.setDescription(readText(reader));
+        task.setCompleted(readBool(reader));
+        task.setCreatedDate(readDateTime(reader));
+        task.setDueDate(readDateTime(reader));
+        task.setCategoryId(readReference(reader, categoryIds));
+        task.setPriority(int(readInteger(reader)));
+        task.setDisplayOrder(int(readInteger(reader)));
+        leaveRecord(reader);
+        
+        tasks.append(task);
+        if (tasks.size() >= BATCH_SIZE) {
+            if (!db.upsertTasks(tasks, replacedCount) || !written(tasks.size())) return false;
+            tasks.clear();
+        }
+    }
+    reader.leaveContainer();
+    if (!tasks.isEmpty() && (!db.upsertTasks(tasks, replacedCount) || !written(tasks.size()))) return false;
+    
+    // Time entries
+    QList<TimeEntry> entries;
+    if (!reader.isArray() || !reader.enterContainer()) {
+        qWarning() << "Invalid snapshot: missing time entries";
+        return false;
+    }
+    while (reader.hasNext()) {
+        if (!enterRecord(reader)) {
+            continue;
+        }
+        
+        TimeEntry entry;
+        entry.setId(readText(reader));
+        entry.setProjectId(readReference(reader, projectIds));
+        entry.setStartTime(readDateTime(reader));
+        entry.setEndTime(readDateTime(reader));
+        qint64 duration = readInteger(reader, -1);
+        if (duration >= 0) {
+            entry.setDuration(int(duration));
+        }
+        entry.setNotes(readText(reader));
+        leaveRecord(reader);
+        
+        entries.append(entry);
+        if (entries.size() >= BATCH_SIZE) {
+            if (!db.upsertTimeEntries(entries, replacedCount) || !written(entries.size())) return false;
+            entries.clear();
+        }
+    }
+    reader.leaveContainer();
+    if (!entries.isEmpty() && (!db.upsertTimeEntries(entries, replacedCount) || !written(entries.size()))) return false;
+    
+    if (reader.lastError() != QCborError::NoError) {
+        qWarning() << "Invalid snapshot:" << reader.lastError().toString();
+        return false;
+    }
+    
+    return true;
+}
+
+/**
+ * @brief Write a date-time as milliseconds since the epoch, or null
+ * 
+ * @param writer The CBOR writer
+ * @param dateTime The date-time to write
+ */
+void CborSnapshot::appendDateTime(QCborStreamWriter& writer, const QDateTime& dateTime)
+{
+    if (dateTime.isValid()) {
+        writer.append(dateTime.toMSecsSinceEpoch());
+    } else {
+        writer.appendNull();
+    }
+}
+
+/**
+ * @brief Write a reference to a string table entry
+ * 
+ * Writes the table index when the ID is in the table, the ID itself when it
+ * is not, and null for an empty ID.
+ * 
+ * @param writer The CBOR writer
+ * @param table Map of IDs to table indexes
+ * @param id The referenced ID
+ */
+void CborSnapshot::appendReference(QCborStreamWriter& writer, const QHash<QString, int>& table, const QString& id)
+{
+    if (id.isEmpty()) {
+        writer.appendNull();
+        return;
+    }
+    
+    auto it = table.constFind(id);
+    if (it != table.constEnd()) {
+        writer.append(quint64(it.value()));
+    } else {
+        writer.append(id);
+    }
+}
+
+/**
+ * @brief Read a text string, or an empty string for any other item
+ * 
+ * @param reader The CBOR reader, positioned on the item
+ * @return QString The text
+ */
+QString CborSnapshot::readText(QCborStreamReader& reader)
+{
+    if (!reader.isString()) {
+        reader.next();
+        return QString();
+    }
+    
+    QString text;
+    auto chunk = reader.readString();
+    while (chunk.status == QCborStreamReader::Ok) {
+        text += chunk.data;
+        chunk = reader.readString();
+    }
+    
+    return text;
+}
+
+/**
+ * @brief Read an integer, or a default value for any other item
+ * 
+ * @param reader The CBOR reader, positioned on the item
+ * @param defaultValue Value returned for non-integer items
+ * @return qint64 The integer
+ */
+qint64 CborSnapshot::readInteger(QCborStreamReader& reader, qint64 defaultValue)
+{
+    qint64 value = defaultValue;
+    if (reader.isInteger()) {
+        value = reader.toInteger();
+    }
+    
+    reader.next();
+    return value;
+}
+
+/**
+ * @brief Read a boolean, or false for any other item
+ * 
+ * @param reader The CBOR reader, positioned on the item
+ * @return bool The boolean
+ */
+bool CborSnapshot::readBool(QCborStreamReader& reader)
+{
+    bool value = reader.isBool() && reader.toBool();
+    reader.next();
+    return value;
+}
+
+/**
+ * @brief Read a date-time written by appendDateTime()
+ * 
+ * @param reader The CBOR reader, positioned on the item
+ * @return QDateTime The date-time, invalid for null
+ */
+QDateTime CborSnapshot::readDateTime(QCborStreamReader& reader)
+{
+    if (!reader.isInteger()) {
+        reader.next();
+        return QDateTime();
+    }
+    
+    return QDateTime::fromMSecsSinceEpoch(readInteger(reader));
+}
+
+/**
+ * @brief Read a reference written by appendReference()
+ * 
+ * @param reader The CBOR reader, positioned on the item
+ * @param table The string table read so far
+ * @return QString The referenced ID, empty for null or unknown indexes
+ */
+QString CborSnapshot::readReference(QCborStreamReader& reader, const QStringList& table)
+{
+    if (reader.isString()) {
+        return readText(reader);
+    }
+    
+    qint64 index = readInteger(reader, -1);
+    return index >= 0 && index < table.size() ? table.at(int(index)) : QString();
+}
+
+/**
+ * @brief Enter a record array
+ * 
+ * Items that are not arrays are skipped.
+ * 
+ * @param reader The CBOR reader, positioned on the record
+ * @return bool True if the item is an array and was entered
+ */
+bool CborSnapshot::enterRecord(QCborStreamReader& reader)
+{
+    if (!reader.isArray()) {
+        reader.next();
+        return false;
+    }
+    
+    return reader.enterContainer();
+}
+
+/**
+ * @brief Skip unknown trailing fields and leave a record array
+ * 
+ * @param reader The CBOR reader, inside the record
+ */
+void CborSnapshot::leaveRecord(QCborStreamReader& reader)
+{
+    while (reader.hasNext()) {
+        reader.next();
+    }
+    
+    reader.leaveContainer();
+}
@@ -0,0 +1,156 @@
+/**
+ * @file cborsnapshot.h
+ * @brief Definition of the CborSnapshot class
+ * 
+ * This file defines the CborSnapshot class which writes and restores full
+ * backups of the database in a compact, versioned CBOR format.
+ * 
+ * @author Cornebidouil
+ * @date Last updated: April 30, 2025
+ */
+
+#pragma once
+
+#include <QIODevice>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QDateTime>
+#include <QCborStreamReader>
+#include <QCborStreamWriter>
+#include <functional>
+
+/**
+ * @class CborSnapshot
+ * @brief Binary snapshot of categories, projects, tasks and time entries
+ * 
+ * A snapshot is a single CBOR array:
+ * @code
+ * [ "TODO-Widget snapshot", version,
+ *   [ [id, name, rgba, isDefault], ... ],                                   // categories
+ *   [ [id, name, rgba, description, isActive], ... ],                       // projects
+ *   [ [id, title, description, completed, created, due, category,
+ *      priority, displayOrder], ... ],                                      // tasks
+ *   [ [id, project, start, end, duration, notes], ... ] ]                   // time entries
+ * @endcode
+ * Records are positional arrays and date-times are milliseconds since the
+ * epoch, or null. The category and project sections double as string tables:
+ * tasks and time entries refer to them by index, and only fall back to the
+ * ID string for references missing from the table. Readers ignore trailing
+ * record fields they do not know, so later versions can append fields.
+ * 
+ * Both directions work in a single streaming pass: time entries are written
+ * straight from a database cursor, and records are read one at a time and
+ * written to the database in batched transactions.
+ */
+class CborSnapshot {
+public:
+    /**
+     * @brief Handler called after each batch written during a restore
+     * 
+     * Receives the number of records in the batch and how many of them
+     * replaced existing records; returning false aborts the restore.
+     */
+    typedef std::function<bool(int written, int replaced)> BatchHandler;
+    
+    /**
+     * @brief Handler reporting the progress of writing a snapshot
+     * 
+     * Receives the number of records written so far; returning false aborts
+     * the snapshot.
+     */
+    typedef std::function<bool(int written)> ProgressHandler;
+    
+    /**
+     * @brief Write a snapshot of the database
+     * 
+     * @param device The device to write to, opened for writing
+     * @param progressHandler Optional handler reporting the records written so far
+     * @return bool True if the snapshot was written, false otherwise
+     */
+    static bool write(QIODevice* device, const ProgressHandler& progressHandler = ProgressHandler());
+    
+    /**
+     * @brief Restore a snapshot into the database
+     * 
+     * Records are inserted or replaced by ID; records missing from the
+     * snapshot are kept.
+     * 
+     * @param device The device to read from, opened for reading
+     * @param recordCount Optional pointer receiving the number of records restored
+     * @param batchHandler Optional handler called after each written batch; returning false aborts the restore
+     * @return bool True if the whole snapshot was restored, false otherwise
+     */
+    static bool read(QIODevice* device, int* recordCount = nullptr, const BatchHandler& batchHandler = BatchHandler());
+    
+    static const int FORMAT_VERSION = 1; ///< Version written to new snapshots
+
+private:
+    /**
+     * @brief Write a date-time as milliseconds since the epoch, or null
+     * @param writer The CBOR writer
+     * @param dateTime The date-time to write
+     */
+    static void appendDateTime(QCborStreamWriter& writer, const QDateTime& dateTime);
+    
+    /**
+     * @brief Write a reference to a string table entry
+     * @param writer The CBOR writer
+     * @param table Map of IDs to table indexes
+     * @param id The referenced ID
+     */
+    static void appendReference(QCborStreamWriter& writer, const QHash<QString, int>& table, const QString& id);
+    
+    /**
+     * @brief Read a text string, or an empty string for any other item
+     * @param reader The CBOR reader, positioned on the item
+     * @return QString The text
+     */
+    static QString readText(QCborStreamReader& reader);
+    
+    /**
+     * @brief Read an integer, or a default value for any other item
+     * @param reader The CBOR reader, positioned on the item
+     * @param defaultValue Value returned for non-integer items
+     * @return qint64 The integer
+     */
+    static qint64 readInteger(QCborStreamReader& reader, qint64 defaultValue = 0);
+    
+    /**
+     * @brief Read a boolean, or false for any other item
+     * @param reader The CBOR reader, positioned on the item
+     * @return bool The boolean
+     */
+    static bool readBool(QCborStreamReader& reader);
+    
+    /**
+     * @brief Read a date-time written by appendDateTime()
+     * @param reader The CBOR reader, positioned on the item
+     * @return QDateTime The date-time, invalid for null
+     */
+    static QDateTime readDateTime(QCborStreamReader& reader);
+    
+    /**
+     * @brief Read a reference written by appendReference()
+     * @param reader The CBOR reader, positioned on the item
+     * @param table The string table read so far
+     * @return QString The referenced ID, empty for null or unknown indexes
+     */
+    static QString readReference(QCborStreamReader& reader, const QStringList& table);
+    
+    /**
+     * @brief Enter a record array
+     * @param reader The CBOR reader, positioned on the record
+     * @return bool True if the item is an array and was entered
+     */
+    static bool enterRecord(QCborStreamReader& reader);
+    
+    /**
+     * @brief Skip unknown trailing fields and leave a record array
+     * @param reader The CBOR reader, inside the record
+     */
+    static void leaveRecord(QCborStreamReader& reader);
+    
+    static const int BATCH_SIZE = 500; ///< Records written per database transaction
+    static const char* const SNAPSHOT_MAGIC; ///< Format marker at the start of every snapshot
+};
@@ -0,0 +1,324 @@
+/**
+ * @file compresseddevice.cpp
+ * @brief Implementation of the CompressedDevice class
+ * 
+ * The CompressedDevice deflates written data and inflates read data block by
+ * block with zlib.
+ * 
+ * @author Cornebidouil
+ * @date Last updated: April 30, 2025
+ */
+
+#include "compresseddevice.h"
+#include <QDebug>
+
+/**
+ * @brief Constructor
+ * 
+ * @param device The underlying device, already open
+ * @param compression Format written when opened for writing; ignored when reading
+ * @param parent Optional parent QObject
+ */
+CompressedDevice::CompressedDevice(QIODevice* device, Compression compression, QObject* parent)
+    : QIODevice(parent)
+    , m_device(device)
+    , m_compression(compression)
+    , m_stream()
+    , m_streamActive(false)
+    , m_streamEnded(false)
+    , m_error(false)
+{
+}
+
+/**
+ * @brief Destructor
+ * 
+ * Finishes the stream if the device is still open.
+ */
+CompressedDevice::~CompressedDevice()
+{
+    close();
+}
+
+/**
+ * @brief Open the device
+ * 
+ * For reading, the format is detected from the underlying device and zlib is
+ * set up to accept both gzip and zlib headers. For writing, a gzip or zlib
+ * stream is started with the default compression level.
+ * 
+ * @param mode The open mode
+ * @return bool True if the stream was set up, false otherwise
+ */
+bool CompressedDevice::open(OpenMode mode)
+{
+    const bool reading = (mode & ReadWrite) == ReadOnly;
+    const bool writing = (mode & ReadWrite) == WriteOnly;
+    if (!reading && !writing) {
+        qWarning() << "CompressedDevice supports either reading or writing";
+        return false;
+    }
+
+    m_stream = z_stream();
+    m_streamEnded = false;
+    m_error = false;
+
+    int result = Z_OK;
+    if (reading) {
+        m_compression = detect(m_device);
+        if (m_compression != None) {
+            // 32 added to the window bits enables automatic header detection
+            result = inflateInit2(&m_stream, MAX_WBITS + 32);
+        }
+    } else if (m_compression != None) {
+        // 16 added to the window bits selects a gzip header and trailer
+        result = deflateInit2(&m_stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                              m_compression == Gzip ? MAX_WBITS + 16 : MAX_WBITS,
+                              8, Z_DEFAULT_STRATEGY);
+    }
+
+    if (result != Z_OK) {
+        qWarning() << "Failed to initialize compression:" << (m_stream.msg ? m_stream.msg : "unknown error");
+        return false;
+    }
+
+    m_streamActive = m_compression != None;
+    return QIODevice::open(mode);
+}
+
+/**
+ * @brief Finish the stream and close the device
+ */
+void CompressedDevice::close()
+{
+    if (!isOpen()) {
+        return;
+    }
+
+    if (m_streamActive) {
+        if (openMode() & WriteOnly) {
+            m_stream.next_in = nullptr;
+            m_stream.avail_in = 0;
+            if (!m_error) {
+                deflateInput(Z_FINISH);
+            }
+            deflateEnd(&m_stream);
+        } else {
+            inflateEnd(&m_stream);
+        }
+        m_streamActive = false;
+    }
+
+    m_buffer.clear();
+    QIODevice::close();
+}
+
+/**
+ * @brief Check if all data was read
+ * 
+ * @return bool True if the stream ended and no buffered data remains
+ */
+bool CompressedDevice::atEnd() const
+{
+    if (!isOpen()) {
+        return true;
+    }
+    if (QIODevice::bytesAvailable() > 0) {
+        return false;
+    }
+
+    return m_compression == None ? m_device->atEnd() : (m_streamEnded || m_error);
+}
+
+/**
+ * @brief Detect the format of a device from its first bytes
+ * 
+ * gzip streams start with the magic bytes 1f 8b. zlib streams are recognized
+ * by a header with the deflate method, the default 32K window, no preset
+ * dictionary and a valid check value, which rules out text files.
+ * 
+ * @param device The device, open for reading
+ * @return Compression The detected format
+ */
+CompressedDevice::Compression CompressedDevice::detect(QIODevice* device)
+{
+    const QByteArray head = device->peek(2);
+    if (head.size() < 2) {
+        return None;
+    }
+
+    const uchar first = uchar(head.at(0));
+    const uchar second = uchar(head.at(1));
+
+    if (first == 0x1f && second == 0x8b) {
+        return Gzip;
+    }
+
+    if (first == 0x78 && !(second & 0x20) && ((first << 8) | second) % 31 == 0) {
+        return Zlib;
+    }
+
+    return None;
+}
+
+/**
+ * @brief Choose the format for a file from its name
+ * 
+ * @param filePath Path of the file
+ * @return Compression Gzip for ".gz", Zlib for ".zz", None otherwise
+ */
+CompressedDevice::Compression CompressedDevice::compressionForPath(const QString& filePath)
+{
+    if (filePath.endsWith(".gz", Qt::CaseInsensitive)) {
+        return Gzip;
+    }
+    if (filePath.endsWith(".zz", Qt::CaseInsensitive)) {
+        return Zlib;
+    }
+    return None;
+}
+
+/**
+ * @brief Read decompressed data
+ * 
+ * Inflates compressed blocks from the underlying device until the request is
+ * filled or the stream ends. When one gzip member ends and more data follows,
+ * the stream is reset to read the next member.
+ * 
+ * @param data Destination buffer
+ * @param maxSize Size of the destination buffer
+ * @return qint64 Number of bytes read, or -1 on error
+ */
+qint64 CompressedDevice::readData(char* data, qint64 maxSize)
+{
+    if (m_compression == None) {
+        const qint64 read = m_device->read(data, maxSize);
+        if (read < 0) {
+            fail(m_device->errorString());
+        }
+        return read;
+    }
+
+    if (m_streamEnded || m_error) {
+        return m_error ? -1 : 0;
+    }
+
+    const uInt capacity = uInt(qMin(maxSize, qint64(1) << 30));
+    m_stream.next_out = reinterpret_cast<Bytef*>(data);
+    m_stream.avail_out = capacity;
+
+    while (m_stream.avail_out > 0) {
+        if (m_stream.avail_in == 0) {
+            m_buffer.resize(CHUNK_SIZE);
+            const qint64 read = m_device->read(m_buffer.data(), CHUNK_SIZE);
+            if (read < 0) {
+                fail(m_device->errorString());
+                break;
+            }
+            if (read == 0) {
+                fail("Compressed data is truncated");
+                break;
+            }
+            m_stream.next_in = reinterpret_cast<Bytef*>(m_buffer.data());
+            m_stream.avail_in = uInt(read);
+        }
+
+        const int result = inflate(&m_stream, Z_NO_FLUSH);
+
+        if (result == Z_STREAM_END) {
+            if (m_stream.avail_in == 0 && m_device->atEnd()) {
+                m_streamEnded = true;
+                break;
+            }
+            inflateReset(&m_stream);
+        } else if (result != Z_OK && result != Z_BUF_ERROR) {
+            fail(QString("Invalid compressed data: %1").arg(m_stream.msg ? m_stream.msg : "unknown error"));
+            break;
+        }
+    }
+
+    const qint64 produced = capacity - m_stream.avail_out;
+    return produced == 0 && m_error ? -1 : produced;
+}
+
+/**
+ * @brief Write data to be compressed
+ * 
+ * @param data The data
+ * @param size Number of bytes
+ * @return qint64 Number of bytes accepted, or -1 on error
+ */
+qint64 CompressedDevice::writeData(const char* data, qint64 size)
+{
+    if (m_error) {
+        return -1;
+    }
+
+    if (m_compression == None) {
+        if (m_device->write(data, size) != size) {
+            fail(m_device->errorString());
+            return -1;
+        }
+        return size;
+    }
+
+    // Feed the input in pieces that fit zlib's 32-bit counters
+    qint64 written = 0;
+    while (written < size) {
+        const uInt piece = uInt(qMin(size - written, qint64(1) << 30));
+        m_stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data + written));
+        m_stream.avail_in = piece;
+        if (!deflateInput(Z_NO_FLUSH)) {
+            return -1;
+        }
+        written += piece;
+    }
+
+    return size;
+}
+
+/**
+ * @brief Deflate the pending input and write the output
+ * 
+ * With Z_NO_FLUSH this returns once all input was consumed; with Z_FINISH
+ * once the stream trailer was written.
+ * 
+ * @param flush zlib flush mode
+ * @return bool True if all output reached the underlying device
+ */
+bool CompressedDevice::deflateInput(int flush)
+{
+    m_buffer.resize(CHUNK_SIZE);
+
+    int result;
+    do {
+        m_stream.next_out = reinterpret_cast<Bytef*>(m_buffer.data());
+        m_stream.avail_out = CHUNK_SIZE;
+
+        result = deflate(&m_stream, flush);
+        if (result == Z_STREAM_ERROR) {
+            fail("Compression failed");
+            return false;
+        }
+
+        const qint64 produced = CHUNK_SIZE - m_stream.avail_out;
+        if (produced > 0 && m_device->write(m_buffer.constData(), produced) != produced) {
+            fail(m_device->errorString());
+            return false;
+        }
+    } while (m_stream.avail_out == 0 || (flush == Z_FINISH && result != Z_STREAM_END));
+
+    return true;
+}
+
+/**
+ * @brief Record an error
+ * 
+ * @param message Description of the error
+ */
+void CompressedDevice::fail(const QString& message)
+{
+    m_error = true;
+    setErrorString(message);
+    qWarning() << "Compressed stream error:" << message;
+}
@@ -0,0 +1,159 @@
+/**
+ * @file compresseddevice.h
+ * @brief Definition of the CompressedDevice class
+ * 
+ * This file defines the CompressedDevice class which compresses or
+ * decompresses data streamed through another device with zlib.
+ * 
+ * @author Cornebidouil
+ * @date Last updated: April 30, 2025
+ */
+
+#pragma once
+
+#include <QIODevice>
+#include <QByteArray>
+#include <QString>
+#include <QtGlobal>
+
+#if defined(Q_OS_WIN)
+// Stock Qt Windows kits ship no zlib; QtCore bundles and exports one
+#include <QtZlib/zlib.h>
+#else
+#include <zlib.h>
+#endif
+
+/**
+ * @class CompressedDevice
+ * @brief Streaming gzip/zlib filter over another device
+ * 
+ * Opened for writing, data written to the CompressedDevice is deflated in
+ * fixed-size blocks and passed on to the underlying device; close() finishes
+ * the stream. Opened for reading, the format of the underlying device is
+ * detected from its first bytes: gzip and zlib streams are inflated as they
+ * are read, anything else is passed through unchanged, so readers handle
+ * compressed and plain files alike. Concatenated gzip members, as produced by
+ * appending to a compressed file, are read as one stream.
+ * 
+ * Memory use does not depend on the size of the data. The underlying device
+ * must already be open and outlive the CompressedDevice.
+ */
+class CompressedDevice : public QIODevice {
+    Q_OBJECT
+
+public:
+    /**
+     * @enum Compression
+     * @brief Stream format
+     */
+    enum Compression {
+        None,   ///< Uncompressed
+        Gzip,   ///< gzip (RFC 1952), as written by gzip(1)
+        Zlib    ///< zlib (RFC 1950)
+    };
+
+    /**
+     * @brief Constructor
+     * @param device The underlying device, already open
+     * @param compression Format written when opened for writing; ignored when reading
+     * @param parent Optional parent QObject
+     */
+    explicit CompressedDevice(QIODevice* device, Compression compression = Gzip, QObject* parent = nullptr);
+
+    /**
+     * @brief Destructor
+     * 
+     * Finishes the stream if the device is still open.
+     */
+    ~CompressedDevice() override;
+
+    /**
+     * @brief Open the device
+     * 
+     * Only ReadOnly and WriteOnly are supported.
+     * 
+     * @param mode The open mode
+     * @return bool True if the stream was set up, false otherwise
+     */
+    bool open(OpenMode mode) override;
+
+    /**
+     * @brief Finish the stream and close the device
+     * 
+     * When writing, the remaining compressed data and the stream trailer are
+     * written to the underlying device, which stays open.
+     */
+    void close() override;
+
+    /**
+     * @brief The device is always sequential
+     * @return bool True
+     */
+    bool isSequential() const override { return true; }
+
+    /**
+     * @brief Check if all data was read
+     * @return bool True if the stream ended and no buffered data remains
+     */
+    bool atEnd() const override;
+
+    /**
+     * @brief Get the stream format
+     * 
+     * When reading, this is the detected format once the device is open.
+     * 
+     * @return Compression The stream format
+     */
+    Compression compression() const { return m_compression; }
+
+    /**
+     * @brief Check if a compression or I/O error occurred
+     * @return bool True if an error occurred; errorString() describes it
+     */
+    bool hasError() const { return m_error; }
+
+    /**
+     * @brief Detect the format of a device from its first bytes
+     * 
+     * The data is peeked, not consumed.
+     * 
+     * @param device The device, open for reading
+     * @return Compression The detected format
+     */
+    static Compression detect(QIODevice* device);
+
+    /**
+     * @brief Choose the format for a file from its name
+     * @param filePath Path of the file
+     * @return Compression Gzip for ".gz", Zlib for ".zz", None otherwise
+     */
+    static Compression compressionForPath(const QString& filePath);
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override;
+    qint64 writeData(const char* data, qint64 size) override;
+
+private:
+    /**
+     * @brief Deflate the pending input and write the output
+     * @param flush zlib flush mode
+     * @return bool True if all output reached the underlying device
+     */
+    bool deflateInput(int flush);
+
+    /**
+     * @brief Record an error
+     * @param message Description of the error
+     */
+    void fail(const QString& message);
+
+    static const int CHUNK_SIZE = 64 * 1024; ///< Bytes read or written per underlying I/O call
+
+    QIODevice* m_device;          ///< Underlying device
+    Compression m_compression;    ///< Stream format
+    z_stream m_stream;            ///< zlib stream state
+    bool m_streamActive;          ///< True while m_stream is initialized
+    bool m_streamEnded;           ///< True once the compressed input was fully inflated
+    bool m_error;                 ///< True if an error occurred
+    QByteArray m_buffer;          ///< Compressed data read from or to be written to the device
+};
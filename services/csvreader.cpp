@@ -0,0 +1,263 @@
+/**
+ * @file csvreader.cpp
+ * @brief Implementation of the CsvReader class
+ * 
+ * The CsvReader scans a memory-mapped CSV file byte by byte with memchr-based
+ * searches and returns fields as views into the mapping.
+ * 
+ * @author Cornebidouil
+ * @date Last updated: April 30, 2025
+ */
+
+#include "csvreader.h"
+#include <cstring>
+
+/**
+ * @brief Constructor
+ * 
+ * @param filePath Path to the CSV file
+ */
+CsvReader::CsvReader(const QString& filePath)
+    : m_file(filePath)
+    , m_data(nullptr)
+    , m_size(0)
+    , m_pos(0)
+    , m_rowCount(0)
+{
+}
+
+/**
+ * @brief Open and map the file
+ * 
+ * The mapping is private, so unescaping quoted fields in place never touches
+ * the file on disk. A UTF-8 byte order mark is skipped.
+ * 
+ * @return bool True if the file is ready to be parsed
+ */
+bool CsvReader::open()
+{
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_error = "Could not open file: " + m_file.errorString();
+        return false;
+    }
+    
+    m_size = m_file.size();
+    if (m_size > 0) {
+        m_data = reinterpret_cast<char*>(m_file.map(0, m_size, QFileDevice::MapPrivateOption));
+    }
+    
+    if (!m_data) {
+        // Empty files and devices that cannot be mapped are read instead
+        m_fallback = m_file.readAll();
+        m_data = m_fallback.data();
+        m_size = m_fallback.size();
+    }
+    
+    if (m_size >= 3 && std::memcmp(m_data, "\xEF\xBB\xBF", 3) == 0) {
+        m_pos = 3;
+    }
+    
+    return true;
+}
+
+/**
+ * @brief Parse a quoted field starting at the opening quote
+ * 
+ * Jumps from quote to quote with memchr. Doubled quotes are collapsed by
+ * moving the bytes between them left, which keeps the field inside its
+ * original span.
+ * 
+ * @param pos Position of the opening quote; advanced past the closing quote
+ * @param end End of the range
+ * @param field Receives the unescaped field
+ * @return bool True if the closing quote was found
+ */
+bool CsvReader::readQuotedField(qint64& pos, qint64 end, Field& field) const
+{
+    char* out = m_data + pos + 1;
+    field.data = out;
+    qint64 scan = pos + 1;
+    
+    while (scan < end) {
+        const char* quote = static_cast<const char*>(std::memchr(m_data + scan, '"', end - scan));
+        if (!quote) {
+            break;
+        }
+        
+        qint64 quotePos = quote - m_data;
+        qint64 length = quotePos - scan;
+        if (out != m_data + scan) {
+            std::memmove(out, m_data + scan, length);
+        }
+        out += length;
+        
+        if (quotePos + 1 < end && m_data[quotePos + 1] == '"') {
+            *out++ = '"';
+            scan = quotePos + 2;
+            continue;
+        }
+        
+        field.size = int(out - field.data);
+        pos = quotePos + 1;
+        return true;
+    }
+    
+    return false;
+}
+
+/**
+ * @brief Parse the next row of a range
+ * 
+ * Empty lines between rows are skipped. Characters between a closing quote and
+ * the next delimiter are ignored.
+ * 
+ * @param range The range to read from; its begin is advanced past the row
+ * @param fields Receives the fields of the row; its capacity is reused
+ * @param error Optional pointer receiving a description of a parse error
+ * @return bool True if a row was parsed, false at the end of the range or on error
+ */
+bool CsvReader::readRow(Range& range, QVector<Field>& fields, QString* error) const
+{
+    fields.resize(0);
+    
+    qint64 pos = range.begin;
+    const qint64 end = range.end;
+    
+    while (pos < end && (m_data[pos] == '\n' || m_data[pos] == '\r')) {
+        ++pos;
+    }
+    
+    if (pos >= end) {
+        range.begin = end;
+        return false;
+    }
+    
+    for (;;) {
+        Field field;
+        
+        if (pos < end && m_data[pos] == '"') {
+            if (!readQuotedField(pos, end, field)) {
+                if (error) {
+                    *error = QString("Unterminated quoted field at offset %1").arg(pos);
+                }
+                return false;
+            }
+            while (pos < end && m_data[pos] != ',' && m_data[pos] != '\n' && m_data[pos] != '\r') {
+                ++pos;
+            }
+        } else {
+            qint64 start = pos;
+            while (pos < end && m_data[pos] != ',' && m_data[pos] != '\n' && m_data[pos] != '\r') {
+                ++pos;
+            }
+            field.data = m_data + start;
+            field.size = int(pos - start);
+        }
+        
+        fields.append(field);
+        
+        if (pos >= end) {
+            break;
+        }
+        
+        char delimiter = m_data[pos++];
+        if (delimiter == ',') {
+            continue;
+        }
+        
+        if (delimiter == '\r' && pos < end && m_data[pos] == '\n') {
+            ++pos;
+        }
+        break;
+    }
+    
+    range.begin = pos;
+    return true;
+}
+
+/**
+ * @brief Parse the next row
+ * 
+ * @param fields Receives the fields of the row; its capacity is reused
+ * @return bool True if a row was parsed, false at the end of the file or on error
+ */
+bool CsvReader::readRow(QVector<Field>& fields)
+{
+    if (!m_error.isEmpty()) {
+        fields.resize(0);
+        return false;
+    }
+    
+    Range range;
+    range.begin = m_pos;
+    range.end = m_size;
+    
+    if (!readRow(range, fields, &m_error)) {
+        m_pos = range.begin;
+        return false;
+    }
+    
+    m_pos = range.begin;
+    ++m_rowCount;
+    return true;
+}
+
+/**
+ * @brief Split the unread part of the file into ranges of whole records
+ * 
+ * A doubled quote toggles the quote state twice, so simple parity over all
+ * quote characters tells whether a line break is inside a quoted field. The
+ * scan jumps from quote to quote with memchr and only looks for line breaks
+ * outside quotes once a range has reached its target size, so unquoted data
+ * is never walked byte by byte.
+ * 
+ * @param count Requested number of ranges
+ * @return QVector<Range> The ranges, in file order
+ */
+QVector<CsvReader::Range> CsvReader::split(int count) const
+{
+    QVector<Range> ranges;
+    qint64 available = m_size - m_pos;
+    count = qMax(1, count);
+    qint64 target = qMax<qint64>(1, available / count);
+    
+    Range range;
+    range.begin = m_pos;
+    qint64 pos = m_pos;
+    
+    while (pos < m_size && ranges.size() < count - 1) {
+        // Outside quotes: the next quote ends the stretch where a break may split
+        const char* quote = static_cast<const char*>(std::memchr(m_data + pos, '"', m_size - pos));
+        qint64 quotePos = quote ? quote - m_data : m_size;
+        
+        qint64 searchFrom = qMax(pos, range.begin + target - 1);
+        if (searchFrom < quotePos) {
+            const char* newline = static_cast<const char*>(std::memchr(m_data + searchFrom, '\n', quotePos - searchFrom));
+            if (newline) {
+                range.end = newline - m_data + 1;
+                ranges.append(range);
+                range.begin = range.end;
+                pos = range.end;
+                continue;
+            }
+        }
+        
+        if (!quote) {
+            break;
+        }
+        
+        // Inside quotes: skip to the closing quote
+        const char* closing = static_cast<const char*>(std::memchr(m_data + quotePos + 1, '"', m_size - quotePos - 1));
+        if (!closing) {
+            break;
+        }
+        pos = closing - m_data + 1;
+    }
+    
+    range.end = m_size;
+    if (range.begin < range.end) {
+        ranges.append(range);
+    }
+    
+    return ranges;
+}
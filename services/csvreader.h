@@ -0,0 +1,171 @@
+/**
+ * @file csvreader.h
+ * @brief Definition of the CsvReader class
+ * 
+ * This file defines the CsvReader class which parses RFC 4180 CSV files
+ * through a memory mapping, without copying field data.
+ * 
+ * @author Cornebidouil
+ * @date Last updated: April 30, 2025
+ */
+
+#pragma once
+
+#include <QFile>
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+/**
+ * @class CsvReader
+ * @brief Zero-copy CSV parser over a memory-mapped file
+ * 
+ * The file is mapped with a private (copy-on-write) mapping and scanned as
+ * UTF-8 bytes for delimiters, quotes and line breaks. Fields are returned as
+ * views into the mapping; quoted fields are unescaped in place, which never
+ * grows them, so no field allocates until the caller converts it to a QString.
+ * Quoted fields may contain commas, doubled quotes and line breaks, and both
+ * LF and CRLF row endings are accepted.
+ * 
+ * Field views stay valid until the reader is destroyed.
+ * 
+ * For parallel parsing, the unread part of the file can be split into ranges
+ * that start and end on record boundaries. Ranges are disjoint, so they can be
+ * parsed concurrently from different threads with readRow(Range&, ...).
+ */
+class CsvReader {
+public:
+    /**
+     * @struct Field
+     * @brief View of a single field inside the mapped file
+     */
+    struct Field {
+        const char* data = nullptr;   ///< First byte of the field
+        int size = 0;                 ///< Length of the field in bytes
+        
+        /**
+         * @brief Check if the field is empty
+         * @return bool True if the field has no bytes
+         */
+        bool isEmpty() const { return size == 0; }
+        
+        /**
+         * @brief Decode the field
+         * @return QString The field decoded from UTF-8
+         */
+        QString toString() const { return QString::fromUtf8(data, size); }
+        
+        /**
+         * @brief Parse the field as an integer
+         * @param ok Optional pointer set to true if the field is a valid integer
+         * @return int The parsed value, 0 on failure
+         */
+        int toInt(bool* ok = nullptr) const { return QByteArray::fromRawData(data, size).toInt(ok); }
+        
+        /**
+         * @brief Compare the field with an ASCII string
+         * @param text The string to compare with
+         * @return bool True if the field equals the string
+         */
+        bool operator==(const char* text) const { return qstrlen(text) == uint(size) && qstrncmp(data, text, size) == 0; }
+    };
+    
+    /**
+     * @struct Range
+     * @brief Byte range of whole records inside the file
+     */
+    struct Range {
+        qint64 begin = 0;             ///< Offset of the first unread byte
+        qint64 end = 0;               ///< Offset one past the last byte
+    };
+    
+    /**
+     * @brief Constructor
+     * @param filePath Path to the CSV file
+     */
+    explicit CsvReader(const QString& filePath);
+    
+    /**
+     * @brief Open and map the file
+     * 
+     * Falls back to reading the file into memory when it cannot be mapped.
+     * 
+     * @return bool True if the file is ready to be parsed
+     */
+    bool open();
+    
+    /**
+     * @brief Parse the next row
+     * 
+     * @param fields Receives the fields of the row; its capacity is reused
+     * @return bool True if a row was parsed, false at the end of the file or on error
+     */
+    bool readRow(QVector<Field>& fields);
+    
+    /**
+     * @brief Parse the next row of a range
+     * 
+     * Safe to call concurrently for disjoint ranges of the same reader. Does not
+     * update rowCount().
+     * 
+     * @param range The range to read from; its begin is advanced past the row
+     * @param fields Receives the fields of the row; its capacity is reused
+     * @param error Optional pointer receiving a description of a parse error
+     * @return bool True if a row was parsed, false at the end of the range or on error
+     */
+    bool readRow(Range& range, QVector<Field>& fields, QString* error = nullptr) const;
+    
+    /**
+     * @brief Split the unread part of the file into ranges of whole records
+     * 
+     * Split points are placed on the first line break after each target offset
+     * that is outside a quoted field, found with a single quote-parity scan.
+     * Fewer ranges are returned if records are large.
+     * 
+     * @param count Requested number of ranges
+     * @return QVector<Range> The ranges, in file order
+     */
+    QVector<Range> split(int count) const;
+    
+    /**
+     * @brief Get the number of unread bytes
+     * @return qint64 The number of bytes after the parse position
+     */
+    qint64 bytesAvailable() const { return m_size - m_pos; }
+    
+    /**
+     * @brief Get the number of rows parsed so far
+     * @return int The number of rows
+     */
+    int rowCount() const { return m_rowCount; }
+    
+    /**
+     * @brief Check if the file was malformed or unreadable
+     * @return bool True if an error occurred
+     */
+    bool hasError() const { return !m_error.isEmpty(); }
+    
+    /**
+     * @brief Get a description of the error
+     * @return QString The error description, empty if there was none
+     */
+    QString errorString() const { return m_error; }
+
+private:
+    /**
+     * @brief Parse a quoted field starting at the opening quote
+     * @param pos Position of the opening quote; advanced past the closing quote
+     * @param end End of the range
+     * @param field Receives the unescaped field
+     * @return bool True if the closing quote was found
+     */
+    bool readQuotedField(qint64& pos, qint64 end, Field& field) const;
+    
+    QFile m_file;          ///< The CSV file
+    char* m_data;          ///< Start of the mapped or loaded content
+    qint64 m_size;         ///< Size of the content in bytes
+    qint64 m_pos;          ///< Parse position
+    QByteArray m_fallback; ///< Content when the file could not be mapped
+    int m_rowCount;        ///< Rows parsed so far
+    QString m_error;       ///< Error description, empty if no error occurred
+};
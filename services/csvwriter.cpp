@@ -0,0 +1,138 @@
+/**
+ * @file csvwriter.cpp
+ * @brief Implementation of the CsvWriter class
+ * 
+ * The CsvWriter encodes fields following RFC 4180 and writes them to a device
+ * in large blocks.
+ * 
+ * @author Cornebidouil
+ * @date Last updated: April 30, 2025
+ */
+
+#include "csvwriter.h"
+#include <QDebug>
+
+/**
+ * @brief Constructor
+ * 
+ * @param device The device to write to, opened for writing
+ */
+CsvWriter::CsvWriter(QIODevice* device)
+    : m_device(device)
+    , m_rowStarted(false)
+    , m_error(false)
+{
+    m_buffer.reserve(BUFFER_SIZE + 1024);
+}
+
+/**
+ * @brief Destructor
+ * 
+ * Flushes any buffered data.
+ */
+CsvWriter::~CsvWriter()
+{
+    flush();
+}
+
+/**
+ * @brief Start a new field, adding the separator if needed
+ */
+void CsvWriter::beginField()
+{
+    if (m_rowStarted) {
+        m_buffer.append(',');
+    }
+    m_rowStarted = true;
+}
+
+/**
+ * @brief Append a text field to the current row
+ * 
+ * The field is quoted only if it contains a comma, a double quote, CR or LF;
+ * double quotes inside quoted fields are doubled.
+ * 
+ * @param value The field value
+ */
+void CsvWriter::addField(const QString& value)
+{
+    beginField();
+    
+    bool needsQuotes = false;
+    for (const QChar c : value) {
+        if (c == QLatin1Char(',') || c == QLatin1Char('"') || c == QLatin1Char('\r') || c == QLatin1Char('\n')) {
+            needsQuotes = true;
+            break;
+        }
+    }
+    
+    if (needsQuotes) {
+        QString escaped = value;
+        escaped.replace(QLatin1Char('"'), QLatin1String("\"\""));
+        m_buffer.append('"');
+        m_buffer.append(escaped.toUtf8());
+        m_buffer.append('"');
+    } else {
+        m_buffer.append(value.toUtf8());
+    }
+}
+
+/**
+ * @brief Append a numeric field to the current row
+ * 
+ * @param value The field value
+ */
+void CsvWriter::addField(qint64 value)
+{
+    beginField();
+    m_buffer.append(QByteArray::number(value));
+}
+
+/**
+ * @brief Terminate the current row
+ * 
+ * Writes the buffer to the device once it is full.
+ */
+void CsvWriter::endRow()
+{
+    m_buffer.append("\r\n");
+    m_rowStarted = false;
+    
+    if (m_buffer.size() >= BUFFER_SIZE) {
+        flush();
+    }
+}
+
+/**
+ * @brief Write a complete row
+ * 
+ * @param fields The fields of the row
+ */
+void CsvWriter::writeRow(const QStringList& fields)
+{
+    for (const QString& field : fields) {
+        addField(field);
+    }
+    endRow();
+}
+
+/**
+ * @brief Write buffered data to the device
+ * 
+ * @return bool True if all data written so far reached the device
+ */
+bool CsvWriter::flush()
+{
+    if (m_buffer.isEmpty() || m_error) {
+        m_buffer.resize(0);
+        return !m_error;
+    }
+    
+    if (m_device->write(m_buffer) != m_buffer.size()) {
+        qWarning() << "Failed to write CSV data:" << m_device->errorString();
+        m_error = true;
+    }
+    
+    m_buffer.resize(0);
+    return !m_error;
+}
@@ -0,0 +1,92 @@
+/**
+ * @file csvwriter.h
+ * @brief Definition of the CsvWriter class
+ * 
+ * This file defines the CsvWriter class which writes RFC 4180 CSV to a
+ * device through a fixed-size buffer.
+ * 
+ * @author Cornebidouil
+ * @date Last updated: April 30, 2025
+ */
+
+#pragma once
+
+#include <QIODevice>
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+
+/**
+ * @class CsvWriter
+ * @brief Buffered RFC 4180 CSV writer
+ * 
+ * Fields are appended one at a time and encoded as UTF-8 into an internal
+ * buffer that is written to the device whenever it fills up, so the memory
+ * used does not depend on the number of rows. Fields are only quoted when they
+ * contain a comma, a quote or a line break, and rows end with CRLF.
+ * 
+ * The device must be opened without QIODevice::Text so line endings are kept.
+ */
+class CsvWriter {
+public:
+    /**
+     * @brief Constructor
+     * @param device The device to write to, opened for writing
+     */
+    explicit CsvWriter(QIODevice* device);
+    
+    /**
+     * @brief Destructor
+     * 
+     * Flushes any buffered data.
+     */
+    ~CsvWriter();
+    
+    /**
+     * @brief Append a text field to the current row
+     * @param value The field value
+     */
+    void addField(const QString& value);
+    
+    /**
+     * @brief Append a numeric field to the current row
+     * @param value The field value
+     */
+    void addField(qint64 value);
+    
+    /**
+     * @brief Terminate the current row
+     */
+    void endRow();
+    
+    /**
+     * @brief Write a complete row
+     * @param fields The fields of the row
+     */
+    void writeRow(const QStringList& fields);
+    
+    /**
+     * @brief Write buffered data to the device
+     * @return bool True if all data written so far reached the device
+     */
+    bool flush();
+    
+    /**
+     * @brief Check if a write to the device failed
+     * @return bool True if a write failed
+     */
+    bool hasError() const { return m_error; }
+
+private:
+    /**
+     * @brief Start a new field, adding the separator if needed
+     */
+    void beginField();
+    
+    static const int BUFFER_SIZE = 64 * 1024; ///< Buffered bytes before writing to the device
+    
+    QIODevice* m_device;   ///< Device receiving the CSV data
+    QByteArray m_buffer;   ///< Encoded data not yet written
+    bool m_rowStarted;     ///< True once the current row has a field
+    bool m_error;          ///< True if a write to the device failed
+};
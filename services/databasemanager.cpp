@@ -11,9 +11,22 @@
  */
 
 #include "databasemanager.h"
+#include "tracer.h"
 #include <QStandardPaths>
 #include <QDir>
 #include <QDebug>
+#include <QSet>
+#include <QThread>
+#include <QThreadStorage>
+
+// Updates data columns in place on conflict so last_seen survives saves of running
+// entries; a NULL modified_at lets the triggers stamp the write time
+static const char* const TIME_ENTRY_UPSERT =
+    "INSERT INTO time_entries (id, project_id, start_time, end_time, duration, notes, modified_at) "
+    "VALUES (?, ?, ?, ?, ?, ?, ?) "
+    "ON CONFLICT(id) DO UPDATE SET project_id = excluded.project_id, start_time = excluded.start_time, "
+    "end_time = excluded.end_time, duration = excluded.duration, notes = excluded.notes, "
+    "modified_at = COALESCE(excluded.modified_at, time_entries.modified_at)";
 
 /**
  * @brief Get singleton instance
@@ -38,7 +51,7 @@ DatabaseManager& DatabaseManager::instance()
  * @param parent Optional parent QObject
  */
 DatabaseManager::DatabaseManager(QObject* parent)
-    : QObject(parent), m_initialized(false)
+    : QObject(parent), m_initialized(false), m_connectionThread(nullptr)
 {
 }
 
@@ -49,6 +62,9 @@ DatabaseManager::DatabaseManager(QObject* parent)
  */
 DatabaseManager::~DatabaseManager()
 {
+    // Release the cached statement before the connection goes away
+    m_heartbeatQuery = QSqlQuery();
+    
     if (m_database.isOpen()) {
         m_database.close();
     }
@@ -65,12 +81,15 @@ DatabaseManager::~DatabaseManager()
  */
 bool DatabaseManager::initialize()
 {
+    TRACE_FUNCTION("database");
+
     try {
         // If already initialized, skip
         if (m_initialized)
             return true;
 
         m_database = QSqlDatabase::addDatabase("QSQLITE");
+        m_connectionThread = QThread::currentThread();
 
         // Get application data path
         QString dataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
@@ -104,6 +123,10 @@ bool DatabaseManager::initialize()
             }
         } else {
             qDebug() << "Database already exists. Connected to existing database.";
+            
+            if (!migrateTables()) {
+                return false;
+            }
         }
 
         // Create default categories if none exist
@@ -124,6 +147,56 @@ bool DatabaseManager::initialize()
     }
 }
 
+/**
+ * @brief Get the database connection of the calling thread
+ * 
+ * The thread that initialized the manager uses the main connection. Any other
+ * thread gets its own connection to the same file, opened on first use and
+ * closed when the thread finishes, so worker threads can read and write
+ * without touching the main connection. SQLite serializes the writers; the
+ * driver's busy timeout makes a writer wait for the other's transaction.
+ * 
+ * @return QSqlDatabase The connection to use on this thread
+ */
+QSqlDatabase DatabaseManager::connection() const
+{
+    if (QThread::currentThread() == m_connectionThread) {
+        return m_database;
+    }
+    
+    static QThreadStorage<ThreadConnection*> connections;
+    if (!connections.hasLocalData()) {
+        connections.setLocalData(new ThreadConnection(m_database));
+    }
+    return QSqlDatabase::database(connections.localData()->name);
+}
+
+/**
+ * @brief Open a connection for the calling thread
+ * 
+ * @param main The main connection whose settings are copied
+ */
+DatabaseManager::ThreadConnection::ThreadConnection(const QSqlDatabase& main)
+    : name(QString("todowidget-%1").arg(quintptr(QThread::currentThreadId())))
+{
+    QSqlDatabase database = QSqlDatabase::cloneDatabase(main, name);
+    if (!database.open()) {
+        qWarning() << "Failed to open worker database connection:" << database.lastError().text();
+    }
+}
+
+/**
+ * @brief Close the connection when its thread finishes
+ */
+DatabaseManager::ThreadConnection::~ThreadConnection()
+{
+    {
+        QSqlDatabase database = QSqlDatabase::database(name, false);
+        database.close();
+    }
+    QSqlDatabase::removeDatabase(name);
+}
+
 /**
  * @brief Create database tables
  * 
@@ -134,7 +207,7 @@ bool DatabaseManager::initialize()
  */
 bool DatabaseManager::createTables()
 {
-    QSqlQuery query;
+    QSqlQuery query(connection());
 
     // Create tasks table
     if (!query.exec("CREATE TABLE IF NOT EXISTS tasks ("
@@ -176,7 +249,7 @@ bool DatabaseManager::createTables()
 
 bool DatabaseManager::createProjectsTable()
 {
-    QSqlQuery query;
+    QSqlQuery query(connection());
     
     // Create projects table
     if (!query.exec("CREATE TABLE IF NOT EXISTS projects ("
@@ -194,7 +267,7 @@ bool DatabaseManager::createProjectsTable()
 
 bool DatabaseManager::createTimeEntriesTable()
 {
-    QSqlQuery query;
+    QSqlQuery query(connection());
     
     // Create time_entries table
     if (!query.exec("CREATE TABLE IF NOT EXISTS time_entries ("
@@ -204,14 +277,104 @@ bool DatabaseManager::createTimeEntriesTable()
                    "end_time TEXT, "
                    "duration INTEGER, "
                    "notes TEXT, "
+                   "last_seen TEXT, "
+                   "modified_at TEXT, "
                    "FOREIGN KEY (project_id) REFERENCES projects(id) ON DELETE CASCADE)")) {
         qWarning() << "Failed to create time_entries table:" << query.lastError().text();
         return false;
     }
     
+    return createTimeEntryIndexes();
+}
+
+/**
+ * @brief Create the indexes and triggers of the time_entries table
+ * 
+ * Range scans for reports and exports walk entries by start time, and
+ * incremental exports by modification time. The triggers stamp modified_at in
+ * local ISO format on every insert and on every update of a data column, so
+ * every write path keeps it current; heartbeat updates of last_seen do not
+ * count as modifications. Writes supplying their own modified_at, as imports
+ * do to keep the time a record last changed at its source, are not restamped.
+ * 
+ * @return bool True if all objects exist, false otherwise
+ */
+bool DatabaseManager::createTimeEntryIndexes()
+{
+    QSqlQuery query(connection());
+    
+    const QStringList statements = {
+        "CREATE INDEX IF NOT EXISTS idx_time_entries_start_time ON time_entries(start_time)",
+        "CREATE INDEX IF NOT EXISTS idx_time_entries_modified_at ON time_entries(modified_at)",
+        // Recreated so databases with the unconditional triggers pick up the WHEN clauses
+        "DROP TRIGGER IF EXISTS time_entries_modified_on_insert",
+        "DROP TRIGGER IF EXISTS time_entries_modified_on_update",
+        "CREATE TRIGGER time_entries_modified_on_insert AFTER INSERT ON time_entries "
+        "WHEN NEW.modified_at IS NULL "
+        "BEGIN "
+        "UPDATE time_entries SET modified_at = strftime('%Y-%m-%dT%H:%M:%S', 'now', 'localtime') WHERE id = NEW.id; "
+        "END",
+        "CREATE TRIGGER time_entries_modified_on_update "
+        "AFTER UPDATE OF project_id, start_time, end_time, duration, notes ON time_entries "
+        "WHEN NEW.modified_at IS OLD.modified_at "
+        "BEGIN "
+        "UPDATE time_entries SET modified_at = strftime('%Y-%m-%dT%H:%M:%S', 'now', 'localtime') WHERE id = NEW.id; "
+        "END"
+    };
+    
+    for (const QString& statement : statements) {
+        if (!query.exec(statement)) {
+            qWarning() << "Failed to create time_entries index or trigger:" << query.lastError().text();
+            return false;
+        }
+    }
+    
     return true;
 }
 
+/**
+ * @brief Migrate tables of an existing database
+ * 
+ * Adds the last_seen heartbeat and modified_at columns to time_entries for
+ * databases created before they existed, normalizes the empty end times
+ * previously used for running entries to NULL, and creates missing indexes
+ * and triggers. Existing entries are considered modified when they last ended
+ * or started.
+ * 
+ * @return bool True if the migration succeeded or was not needed, false otherwise
+ */
+bool DatabaseManager::migrateTables()
+{
+    QSqlQuery query(connection());
+    
+    QSet<QString> columns;
+    if (query.exec("PRAGMA table_info(time_entries)")) {
+        while (query.next()) {
+            columns.insert(query.value(1).toString());
+        }
+    }
+    
+    if (!columns.contains("last_seen") && !query.exec("ALTER TABLE time_entries ADD COLUMN last_seen TEXT")) {
+        qWarning() << "Failed to add last_seen column:" << query.lastError().text();
+        return false;
+    }
+    
+    if (!columns.contains("modified_at")) {
+        if (!query.exec("ALTER TABLE time_entries ADD COLUMN modified_at TEXT")
+            || !query.exec("UPDATE time_entries SET modified_at = COALESCE(NULLIF(end_time, ''), start_time)")) {
+            qWarning() << "Failed to add modified_at column:" << query.lastError().text();
+            return false;
+        }
+    }
+    
+    if (!query.exec("UPDATE time_entries SET end_time = NULL WHERE end_time = ''")) {
+        qWarning() << "Failed to normalize running time entries:" << query.lastError().text();
+        return false;
+    }
+    
+    return createTimeEntryIndexes();
+}
+
 /**
  * @brief Save multiple tasks
  * 
@@ -228,17 +391,18 @@ bool DatabaseManager::saveTasks(const QList<Task>& tasks)
     }
 
     // Start a transaction for better performance
-    m_database.transaction();
+    QSqlDatabase database = connection();
+    database.transaction();
 
     // Clear existing tasks
-    QSqlQuery clearQuery;
+    QSqlQuery clearQuery(connection());
     if (!clearQuery.exec("DELETE FROM tasks")) {
-        m_database.rollback();
+        database.rollback();
         return false;
     }
 
     // Insert all tasks
-    QSqlQuery query;
+    QSqlQuery query(connection());
     query.prepare("INSERT INTO tasks (id, title, description, completed, created_date, due_date, category_id, priority, display_order) "
                  "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)");
 
@@ -254,13 +418,13 @@ bool DatabaseManager::saveTasks(const QList<Task>& tasks)
         query.bindValue(8, task.displayOrder());
 
         if (!query.exec()) {
-            m_database.rollback();
+            database.rollback();
             qWarning() << "Failed to save task:" << query.lastError().text();
             return false;
         }
     }
 
-    return m_database.commit();
+    return database.commit();
 }
 
 /**
@@ -272,13 +436,15 @@ bool DatabaseManager::saveTasks(const QList<Task>& tasks)
  */
 QList<Task> DatabaseManager::loadTasks()
 {
+    TRACE_FUNCTION("database");
+
     QList<Task> tasks;
 
     if (!m_initialized) {
         return tasks;
     }
 
-    QSqlQuery query("SELECT id, title, description, completed, created_date, due_date, category_id, priority, display_order FROM tasks");
+    QSqlQuery query("SELECT id, title, description, completed, created_date, due_date, category_id, priority, display_order FROM tasks", connection());
 
     while (query.next()) {
         Task task;
@@ -318,7 +484,7 @@ bool DatabaseManager::saveTask(const Task& task)
         return false;
     }
 
-    QSqlQuery query;
+    QSqlQuery query(connection());
     query.prepare("INSERT OR REPLACE INTO tasks (id, title, description, completed, created_date, due_date, category_id, priority, display_order) "
                  "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)");
 
@@ -354,7 +520,7 @@ bool DatabaseManager::deleteTask(const QString& id)
         return false;
     }
 
-    QSqlQuery query;
+    QSqlQuery query(connection());
     query.prepare("DELETE FROM tasks WHERE id = ?");
     query.bindValue(0, id);
 
@@ -382,17 +548,18 @@ bool DatabaseManager::saveCategories(const QList<Category>& categories)
     }
 
     // Start a transaction for better performance
-    m_database.transaction();
+    QSqlDatabase database = connection();
+    database.transaction();
 
     // Clear existing categories
-    QSqlQuery clearQuery;
+    QSqlQuery clearQuery(connection());
     if (!clearQuery.exec("DELETE FROM categories")) {
-        m_database.rollback();
+        database.rollback();
         return false;
     }
 
     // Insert all categories
-    QSqlQuery query;
+    QSqlQuery query(connection());
     query.prepare("INSERT INTO categories (id, name, color, is_default) VALUES (?, ?, ?, ?)");
 
     for (const Category& category : categories) {
@@ -402,13 +569,13 @@ bool DatabaseManager::saveCategories(const QList<Category>& categories)
         query.bindValue(3, category.isDefault() ? 1 : 0);
 
         if (!query.exec()) {
-            m_database.rollback();
+            database.rollback();
             qWarning() << "Failed to save category:" << query.lastError().text();
             return false;
         }
     }
 
-    return m_database.commit();
+    return database.commit();
 }
 
 /**
@@ -420,13 +587,15 @@ bool DatabaseManager::saveCategories(const QList<Category>& categories)
  */
 QList<Category> DatabaseManager::loadCategories()
 {
+    TRACE_FUNCTION("database");
+
     QList<Category> categories;
 
     if (!m_initialized) {
         return categories;
     }
 
-    QSqlQuery query("SELECT id, name, color, is_default FROM categories");
+    QSqlQuery query("SELECT id, name, color, is_default FROM categories", connection());
 
     while (query.next()) {
         Category category;
@@ -458,7 +627,7 @@ bool DatabaseManager::saveCategory(const Category& category)
     }
     qDebug() << "INITIALIZED";
 
-    QSqlQuery query;
+    QSqlQuery query(connection());
     query.prepare("INSERT OR REPLACE INTO categories (id, name, color, is_default) VALUES (?, ?, ?, ?)");
 
     query.bindValue(0, category.id());
@@ -498,17 +667,18 @@ bool DatabaseManager::saveProjects(const QList<Project>& projects)
     }
 
     // Start a transaction for better performance
-    m_database.transaction();
+    QSqlDatabase database = connection();
+    database.transaction();
 
     // Clear existing projects
-    QSqlQuery clearQuery;
+    QSqlQuery clearQuery(connection());
     if (!clearQuery.exec("DELETE FROM projects")) {
-        m_database.rollback();
+        database.rollback();
         return false;
     }
 
     // Insert all projects
-    QSqlQuery query;
+    QSqlQuery query(connection());
     query.prepare("INSERT INTO projects (id, name, color, description, is_active) VALUES (?, ?, ?, ?, ?)");
 
     for (const Project& project : projects) {
@@ -519,13 +689,13 @@ bool DatabaseManager::saveProjects(const QList<Project>& projects)
         query.bindValue(4, project.isActive() ? 1 : 0);
 
         if (!query.exec()) {
-            m_database.rollback();
+            database.rollback();
             qWarning() << "Failed to save project:" << query.lastError().text();
             return false;
         }
     }
 
-    return m_database.commit();
+    return database.commit();
 }
 
 /**
@@ -537,13 +707,15 @@ bool DatabaseManager::saveProjects(const QList<Project>& projects)
  */
 QList<Project> DatabaseManager::loadProjects()
 {
+    TRACE_FUNCTION("database");
+
     QList<Project> projects;
 
     if (!m_initialized) {
         return projects;
     }
 
-    QSqlQuery query("SELECT id, name, color, description, is_active FROM projects");
+    QSqlQuery query("SELECT id, name, color, description, is_active FROM projects", connection());
 
     while (query.next()) {
         Project project;
@@ -574,7 +746,7 @@ bool DatabaseManager::saveProject(const Project& project)
         return false;
     }
 
-    QSqlQuery query;
+    QSqlQuery query(connection());
     query.prepare("INSERT OR REPLACE INTO projects (id, name, color, description, is_active) VALUES (?, ?, ?, ?, ?)");
 
     query.bindValue(0, project.id());
@@ -605,7 +777,7 @@ bool DatabaseManager::deleteProject(const QString& id)
         return false;
     }
 
-    QSqlQuery query;
+    QSqlQuery query(connection());
     query.prepare("DELETE FROM projects WHERE id = ?");
     query.bindValue(0, id);
 
@@ -631,7 +803,7 @@ bool DatabaseManager::deleteCategory(const QString& id)
         return false;
     }
 
-    QSqlQuery query;
+    QSqlQuery query(connection());
     query.prepare("DELETE FROM categories WHERE id = ?");
     query.bindValue(0, id);
 
@@ -659,17 +831,18 @@ bool DatabaseManager::saveTimeEntries(const QList<TimeEntry>& timeEntries)
     }
 
     // Start a transaction for better performance
-    m_database.transaction();
+    QSqlDatabase database = connection();
+    database.transaction();
 
     // Clear existing time entries
-    QSqlQuery clearQuery;
+    QSqlQuery clearQuery(connection());
     if (!clearQuery.exec("DELETE FROM time_entries")) {
-        m_database.rollback();
+        database.rollback();
         return false;
     }
 
     // Insert all time entries
-    QSqlQuery query;
+    QSqlQuery query(connection());
     query.prepare("INSERT INTO time_entries (id, project_id, start_time, end_time, duration, notes) "
                  "VALUES (?, ?, ?, ?, ?, ?)");
 
@@ -677,18 +850,18 @@ bool DatabaseManager::saveTimeEntries(const QList<TimeEntry>& timeEntries)
         query.bindValue(0, entry.id());
         query.bindValue(1, entry.projectId());
         query.bindValue(2, entry.startTime().toString(Qt::ISODate));
-        query.bindValue(3, entry.endTime().isValid() ? entry.endTime().toString(Qt::ISODate) : "");
-        query.bindValue(4, entry.duration());
+        query.bindValue(3, entry.endTime().isValid() ? QVariant(entry.endTime().toString(Qt::ISODate)) : QVariant(QVariant::String));
+        query.bindValue(4, entry.isRunning() ? QVariant(QVariant::Int) : QVariant(entry.duration()));
         query.bindValue(5, entry.notes());
 
         if (!query.exec()) {
-            m_database.rollback();
+            database.rollback();
             qWarning() << "Failed to save time entry:" << query.lastError().text();
             return false;
         }
     }
 
-    return m_database.commit();
+    return database.commit();
 }
 
 /**
@@ -700,32 +873,18 @@ bool DatabaseManager::saveTimeEntries(const QList<TimeEntry>& timeEntries)
  */
 QList<TimeEntry> DatabaseManager::loadTimeEntries()
 {
+    TRACE_FUNCTION("database");
+
     QList<TimeEntry> timeEntries;
 
     if (!m_initialized) {
         return timeEntries;
     }
 
-    QSqlQuery query("SELECT id, project_id, start_time, end_time, duration, notes FROM time_entries");
+    QSqlQuery query("SELECT id, project_id, start_time, end_time, duration, notes, modified_at FROM time_entries", connection());
 
     while (query.next()) {
-        TimeEntry entry;
-        entry.setId(query.value(0).toString());
-        entry.setProjectId(query.value(1).toString());
-        entry.setStartTime(QDateTime::fromString(query.value(2).toString(), Qt::ISODate));
-        
-        QString endTimeStr = query.value(3).toString();
-        if (!endTimeStr.isEmpty()) {
-            entry.setEndTime(QDateTime::fromString(endTimeStr, Qt::ISODate));
-        }
-        
-        if (!query.value(4).isNull()) {
-            entry.setDuration(query.value(4).toInt());
-        }
-        
-        entry.setNotes(query.value(5).toString());
-
-        timeEntries.append(entry);
+        timeEntries.append(timeEntryFromQuery(query));
     }
 
     return timeEntries;
@@ -735,7 +894,8 @@ QList<TimeEntry> DatabaseManager::loadTimeEntries()
  * @brief Save a single time entry
  * 
  * Saves a single time entry to the database. If a time entry with the same ID already exists,
- * it will be replaced with the new time entry.
+ * its data columns are updated in place; the last_seen heartbeat is left untouched so
+ * saving a running entry does not break crash recovery.
  * 
  * @param timeEntry The TimeEntry object to save
  * @return bool True if the time entry was saved successfully, false otherwise
@@ -746,16 +906,18 @@ bool DatabaseManager::saveTimeEntry(const TimeEntry& timeEntry)
         return false;
     }
 
-    QSqlQuery query;
-    query.prepare("INSERT OR REPLACE INTO time_entries (id, project_id, start_time, end_time, duration, notes) "
-                 "VALUES (?, ?, ?, ?, ?, ?)");
+    QSqlQuery query(connection());
+    query.prepare(TIME_ENTRY_UPSERT);
 
     query.bindValue(0, timeEntry.id());
     query.bindValue(1, timeEntry.projectId());
     query.bindValue(2, timeEntry.startTime().toString(Qt::ISODate));
-    query.bindValue(3, timeEntry.endTime().isValid() ? timeEntry.endTime().toString(Qt::ISODate) : "");
-    query.bindValue(4, timeEntry.duration());
+    // Running entries keep a NULL end time and duration until they are stopped
+    query.bindValue(3, timeEntry.endTime().isValid() ? QVariant(timeEntry.endTime().toString(Qt::ISODate)) : QVariant(QVariant::String));
+    query.bindValue(4, timeEntry.isRunning() ? QVariant(QVariant::Int) : QVariant(timeEntry.duration()));
     query.bindValue(5, timeEntry.notes());
+    // Edits made in the application are stamped by the triggers
+    query.bindValue(6, QVariant(QVariant::String));
 
     if (!query.exec()) {
         qWarning() << "Failed to save time entry:" << query.lastError().text();
@@ -765,6 +927,60 @@ bool DatabaseManager::saveTimeEntry(const TimeEntry& timeEntry)
     return true;
 }
 
+/**
+ * @brief Record a heartbeat for all running time entries
+ * 
+ * Updates the last_seen column of every running entry with a single UPDATE.
+ * The statement is prepared once and reused, so a heartbeat costs one tiny
+ * write regardless of how many timers are running.
+ * 
+ * @param now The heartbeat time to record
+ * @return bool True if the heartbeat was recorded, false otherwise
+ */
+bool DatabaseManager::touchRunningTimeEntries(const QDateTime& now)
+{
+    if (!m_initialized) {
+        return false;
+    }
+
+    if (m_heartbeatQuery.lastQuery().isEmpty()) {
+        m_heartbeatQuery = QSqlQuery(m_database);
+        m_heartbeatQuery.prepare("UPDATE time_entries SET last_seen = ? WHERE end_time IS NULL");
+    }
+
+    m_heartbeatQuery.bindValue(0, now.toString(Qt::ISODate));
+
+    if (!m_heartbeatQuery.exec()) {
+        qWarning() << "Failed to record time entry heartbeat:" << m_heartbeatQuery.lastError().text();
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Load the last heartbeat of running time entries
+ * 
+ * @return QMap<QString, QDateTime> Map of running entry IDs to their last heartbeat
+ */
+QMap<QString, QDateTime> DatabaseManager::loadRunningTimeEntryHeartbeats()
+{
+    QMap<QString, QDateTime> heartbeats;
+
+    if (!m_initialized) {
+        return heartbeats;
+    }
+
+    QSqlQuery query("SELECT id, last_seen FROM time_entries WHERE end_time IS NULL AND last_seen IS NOT NULL", connection());
+
+    while (query.next()) {
+        heartbeats.insert(query.value(0).toString(),
+                          QDateTime::fromString(query.value(1).toString(), Qt::ISODate));
+    }
+
+    return heartbeats;
+}
+
 /**
  * @brief Delete a time entry
  * 
@@ -779,7 +995,7 @@ bool DatabaseManager::deleteTimeEntry(const QString& id)
         return false;
     }
 
-    QSqlQuery query;
+    QSqlQuery query(connection());
     query.prepare("DELETE FROM time_entries WHERE id = ?");
     query.bindValue(0, id);
 
@@ -807,8 +1023,8 @@ QList<TimeEntry> DatabaseManager::getTimeEntriesForProject(const QString& projec
         return timeEntries;
     }
 
-    QSqlQuery query;
-    query.prepare("SELECT id, project_id, start_time, end_time, duration, notes FROM time_entries WHERE project_id = ?");
+    QSqlQuery query(connection());
+    query.prepare("SELECT id, project_id, start_time, end_time, duration, notes, modified_at FROM time_entries WHERE project_id = ?");
     query.bindValue(0, projectId);
 
     if (!query.exec()) {
@@ -817,24 +1033,374 @@ QList<TimeEntry> DatabaseManager::getTimeEntriesForProject(const QString& projec
     }
 
     while (query.next()) {
-        TimeEntry entry;
-        entry.setId(query.value(0).toString());
-        entry.setProjectId(query.value(1).toString());
-        entry.setStartTime(QDateTime::fromString(query.value(2).toString(), Qt::ISODate));
-
-        QString endTimeStr = query.value(3).toString();
-        if (!endTimeStr.isEmpty()) {
-            entry.setEndTime(QDateTime::fromString(endTimeStr, Qt::ISODate));
+        timeEntries.append(timeEntryFromQuery(query));
+    }
+
+    return timeEntries;
+}
+
+/**
+ * @brief Visit the time entries overlapping a time range
+ * 
+ * Entries are read through a forward-only query and handed to the visitor one
+ * at a time, so memory use does not depend on the number of entries. Running
+ * entries overlap every range that ends after their start.
+ * 
+ * @param from Start of the range
+ * @param to End of the range (exclusive)
+ * @param visitor Called for each entry in start time order; returning false stops the scan
+ * @return bool True if the scan completed or was stopped by the visitor, false on a query error
+ */
+bool DatabaseManager::forEachTimeEntry(const QDateTime& from, const QDateTime& to,
+                                       const std::function<bool(const TimeEntry&)>& visitor) const
+{
+    TRACE_FUNCTION("database");
+
+    if (!m_initialized) {
+        return false;
+    }
+
+    QSqlQuery query(connection());
+    query.setForwardOnly(true);
+    query.prepare("SELECT id, project_id, start_time, end_time, duration, notes, modified_at FROM time_entries "
+                  "WHERE start_time < ? AND (end_time IS NULL OR end_time > ?) "
+                  "ORDER BY start_time");
+    query.bindValue(0, to.toString(Qt::ISODate));
+    query.bindValue(1, from.toString(Qt::ISODate));
+
+    return visitTimeEntries(query, visitor);
+}
+
+/**
+ * @brief Visit all time entries
+ * 
+ * @param visitor Called for each entry in start time order; returning false stops the scan
+ * @return bool True if the scan completed or was stopped by the visitor, false on a query error
+ */
+bool DatabaseManager::forEachTimeEntry(const std::function<bool(const TimeEntry&)>& visitor) const
+{
+    TRACE_FUNCTION("database");
+
+    if (!m_initialized) {
+        return false;
+    }
+
+    QSqlQuery query(connection());
+    query.setForwardOnly(true);
+    query.prepare("SELECT id, project_id, start_time, end_time, duration, notes, modified_at FROM time_entries ORDER BY start_time");
+
+    return visitTimeEntries(query, visitor);
+}
+
+/**
+ * @brief Visit the time entries modified since a point in time
+ * 
+ * @param since Entries inserted or changed at or after this time are visited
+ * @param visitor Called for each entry in modification order; returning false stops the scan
+ * @return bool True if the scan completed or was stopped by the visitor, false on a query error
+ */
+bool DatabaseManager::forEachTimeEntryModifiedSince(const QDateTime& since,
+                                                    const std::function<bool(const TimeEntry&)>& visitor) const
+{
+    TRACE_FUNCTION("database");
+
+    if (!m_initialized) {
+        return false;
+    }
+
+    QSqlQuery query(connection());
+    query.setForwardOnly(true);
+    query.prepare("SELECT id, project_id, start_time, end_time, duration, notes, modified_at FROM time_entries "
+                  "WHERE modified_at >= ? ORDER BY modified_at");
+    query.bindValue(0, since.toLocalTime().toString(Qt::ISODate));
+
+    return visitTimeEntries(query, visitor);
+}
+
+/**
+ * @brief Run a prepared time entry query and visit its rows
+ * 
+ * @param query Prepared forward-only query selecting the time entry columns
+ * @param visitor Called for each entry; returning false stops the scan
+ * @return bool True if the scan completed or was stopped by the visitor, false on a query error
+ */
+bool DatabaseManager::visitTimeEntries(QSqlQuery& query, const std::function<bool(const TimeEntry&)>& visitor)
+{
+    if (!query.exec()) {
+        qWarning() << "Failed to query time entries:" << query.lastError().text();
+        return false;
+    }
+
+    while (query.next()) {
+        if (!visitor(timeEntryFromQuery(query))) {
+            break;
         }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Build a time entry from the current row of a query
+ * 
+ * The query must select id, project_id, start_time, end_time, duration,
+ * notes and modified_at, in that order.
+ * 
+ * @param query The query positioned on a row
+ * @return TimeEntry The time entry of the row
+ */
+TimeEntry DatabaseManager::timeEntryFromQuery(const QSqlQuery& query)
+{
+    TimeEntry entry;
+    entry.setId(query.value(0).toString());
+    entry.setProjectId(query.value(1).toString());
+    entry.setStartTime(QDateTime::fromString(query.value(2).toString(), Qt::ISODate));
+    
+    QString endTimeStr = query.value(3).toString();
+    if (!endTimeStr.isEmpty()) {
+        entry.setEndTime(QDateTime::fromString(endTimeStr, Qt::ISODate));
+    }
+    
+    if (!query.value(4).isNull()) {
+        entry.setDuration(query.value(4).toInt());
+    }
+    
+    entry.setNotes(query.value(5).toString());
+    entry.setModifiedAt(QDateTime::fromString(query.value(6).toString(), Qt::ISODate));
+    
+    return entry;
+}
+
+/**
+ * @brief Insert or replace a batch of tasks
+ * 
+ * @param tasks The tasks to insert or replace
+ * @param replacedCount Optional pointer receiving the number of records that already existed
+ * @return bool True if the whole batch was written, false otherwise
+ */
+bool DatabaseManager::upsertTasks(const QList<Task>& tasks, int* replacedCount)
+{
+    TRACE_FUNCTION("database");
+
+    if (!m_initialized) {
+        return false;
+    }
+
+    QSqlDatabase database = connection();
+    database.transaction();
+
+    if (replacedCount) {
+        QStringList ids;
+        ids.reserve(tasks.size());
+        for (const Task& task : tasks) {
+            ids.append(task.id());
+        }
+        *replacedCount = countExisting("tasks", ids);
+    }
 
-        if (!query.value(4).isNull()) {
-            entry.setDuration(query.value(4).toInt());
+    QSqlQuery query(connection());
+    query.prepare("INSERT OR REPLACE INTO tasks (id, title, description, completed, created_date, due_date, category_id, priority, display_order) "
+                 "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)");
+
+    for (const Task& task : tasks) {
+        query.bindValue(0, task.id());
+        query.bindValue(1, task.title());
+        query.bindValue(2, task.description());
+        query.bindValue(3, task.isCompleted() ? 1 : 0);
+        query.bindValue(4, task.createdDate().toString(Qt::ISODate));
+        query.bindValue(5, task.dueDate().isValid() ? task.dueDate().toString(Qt::ISODate) : "");
+        query.bindValue(6, task.categoryId());
+        query.bindValue(7, task.priority());
+        query.bindValue(8, task.displayOrder());
+
+        if (!query.exec()) {
+            database.rollback();
+            qWarning() << "Failed to upsert task:" << query.lastError().text();
+            return false;
         }
+    }
 
-        entry.setNotes(query.value(5).toString());
+    return database.commit();
+}
 
-        timeEntries.append(entry);
+/**
+ * @brief Insert or replace a batch of categories
+ * 
+ * @param categories The categories to insert or replace
+ * @param replacedCount Optional pointer receiving the number of records that already existed
+ * @return bool True if the whole batch was written, false otherwise
+ */
+bool DatabaseManager::upsertCategories(const QList<Category>& categories, int* replacedCount)
+{
+    TRACE_FUNCTION("database");
+
+    if (!m_initialized) {
+        return false;
     }
 
-    return timeEntries;
+    QSqlDatabase database = connection();
+    database.transaction();
+
+    if (replacedCount) {
+        QStringList ids;
+        ids.reserve(categories.size());
+        for (const Category& category : categories) {
+            ids.append(category.id());
+        }
+        *replacedCount = countExisting("categories", ids);
+    }
+
+    QSqlQuery query(connection());
+    query.prepare("INSERT OR REPLACE INTO categories (id, name, color, is_default) VALUES (?, ?, ?, ?)");
+
+    for (const Category& category : categories) {
+        query.bindValue(0, category.id());
+        query.bindValue(1, category.name());
+        query.bindValue(2, category.color().name());
+        query.bindValue(3, category.isDefault() ? 1 : 0);
+
+        if (!query.exec()) {
+            database.rollback();
+            qWarning() << "Failed to upsert category:" << query.lastError().text();
+            return false;
+        }
+    }
+
+    return database.commit();
+}
+
+/**
+ * @brief Insert or replace a batch of time entries
+ * 
+ * @param timeEntries The time entries to insert or replace
+ * @param replacedCount Optional pointer receiving the number of records that already existed
+ * @return bool True if the whole batch was written, false otherwise
+ */
+bool DatabaseManager::upsertTimeEntries(const QList<TimeEntry>& timeEntries, int* replacedCount)
+{
+    TRACE_FUNCTION("database");
+
+    if (!m_initialized) {
+        return false;
+    }
+
+    QSqlDatabase database = connection();
+    database.transaction();
+
+    if (replacedCount) {
+        QStringList ids;
+        ids.reserve(timeEntries.size());
+        for (const TimeEntry& timeEntry : timeEntries) {
+            ids.append(timeEntry.id());
+        }
+        *replacedCount = countExisting("time_entries", ids);
+    }
+
+    QSqlQuery query(connection());
+    query.prepare(TIME_ENTRY_UPSERT);
+
+    for (const TimeEntry& timeEntry : timeEntries) {
+        query.bindValue(0, timeEntry.id());
+        query.bindValue(1, timeEntry.projectId());
+        query.bindValue(2, timeEntry.startTime().toString(Qt::ISODate));
+        // Running entries keep a NULL end time and duration until they are stopped
+        query.bindValue(3, timeEntry.endTime().isValid() ? QVariant(timeEntry.endTime().toString(Qt::ISODate)) : QVariant(QVariant::String));
+        query.bindValue(4, timeEntry.isRunning() ? QVariant(QVariant::Int) : QVariant(timeEntry.duration()));
+        query.bindValue(5, timeEntry.notes());
+        // Imported entries keep the modification time they were exported with
+        query.bindValue(6, timeEntry.modifiedAt().isValid() ? QVariant(timeEntry.modifiedAt().toLocalTime().toString(Qt::ISODate)) : QVariant(QVariant::String));
+
+        if (!query.exec()) {
+            database.rollback();
+            qWarning() << "Failed to upsert time entry:" << query.lastError().text();
+            return false;
+        }
+    }
+
+    return database.commit();
+}
+
+/**
+ * @brief Insert or replace a batch of projects
+ * 
+ * @param projects The projects to insert or replace
+ * @param replacedCount Optional pointer receiving the number of records that already existed
+ * @return bool True if the whole batch was written, false otherwise
+ */
+bool DatabaseManager::upsertProjects(const QList<Project>& projects, int* replacedCount)
+{
+    TRACE_FUNCTION("database");
+
+    if (!m_initialized) {
+        return false;
+    }
+
+    QSqlDatabase database = connection();
+    database.transaction();
+
+    if (replacedCount) {
+        QStringList ids;
+        ids.reserve(projects.size());
+        for (const Project& project : projects) {
+            ids.append(project.id());
+        }
+        *replacedCount = countExisting("projects", ids);
+    }
+
+    QSqlQuery query(connection());
+    query.prepare("INSERT OR REPLACE INTO projects (id, name, color, description, is_active) VALUES (?, ?, ?, ?, ?)");
+
+    for (const Project& project : projects) {
+        query.bindValue(0, project.id());
+        query.bindValue(1, project.name());
+        query.bindValue(2, project.color().name(QColor::HexArgb));
+        query.bindValue(3, project.description());
+        query.bindValue(4, project.isActive() ? 1 : 0);
+
+        if (!query.exec()) {
+            database.rollback();
+            qWarning() << "Failed to upsert project:" << query.lastError().text();
+            return false;
+        }
+    }
+
+    return database.commit();
+}
+
+/**
+ * @brief Count the IDs of a batch that already exist in a table
+ * 
+ * Runs one indexed IN query per few hundred IDs, which stays below SQLite's
+ * bound parameter limit.
+ * 
+ * @param table Name of the table; must be one of the application's tables
+ * @param ids The IDs to look up
+ * @return int Number of IDs present in the table
+ */
+int DatabaseManager::countExisting(const QString& table, const QStringList& ids) const
+{
+    const int maxParameters = 500;
+    int existing = 0;
+    
+    QSqlQuery query(connection());
+    for (int first = 0; first < ids.size(); first += maxParameters) {
+        const int size = qMin(maxParameters, ids.size() - first);
+        QStringList placeholders;
+        for (int i = 0; i < size; ++i) {
+            placeholders.append("?");
+        }
+        
+        query.prepare(QString("SELECT COUNT(*) FROM %1 WHERE id IN (%2)").arg(table, placeholders.join(", ")));
+        for (int i = 0; i < size; ++i) {
+            query.bindValue(i, ids.at(first + i));
+        }
+        
+        if (query.exec() && query.next()) {
+            existing += query.value(0).toInt();
+        } else {
+            qWarning() << "Failed to look up existing records:" << query.lastError().text();
+        }
+    }
+    
+    return existing;
 }
@@ -13,9 +13,13 @@
 #pragma once
 
 #include <QObject>
+#include <QMap>
+#include <QStringList>
 #include <QSqlDatabase>
 #include <QSqlError>
 #include <QSqlQuery>
+#include <QThread>
+#include <functional>
 #include "../models/task.h"
 #include "../models/category.h"
 #include "../models/timeentry.h"
@@ -28,6 +32,8 @@
  * The DatabaseManager class provides a centralized interface for all database
  * operations in the application. It is implemented as a singleton to ensure
  * that there is only one database connection throughout the application.
+ * Worker threads transparently get their own connection to the same file,
+ * since Qt connections must stay on the thread that opened them.
  * 
  * It handles:
  * - Establishing and initializing the database connection
@@ -106,6 +112,18 @@ public:
      * @return bool True if the task was deleted successfully, false otherwise
      */
     bool deleteTask(const QString& id);
+    
+    /**
+     * @brief Insert or replace a batch of tasks
+     * 
+     * Unlike saveTasks(), existing tasks are kept. The batch is written in a
+     * single transaction through one prepared statement.
+     * 
+     * @param tasks The tasks to insert or replace
+     * @param replacedCount Optional pointer receiving the number of records that already existed
+     * @return bool True if the whole batch was written, false otherwise
+     */
+    bool upsertTasks(const QList<Task>& tasks, int* replacedCount = nullptr);
 
     /**
      * @brief Save multiple categories
@@ -147,6 +165,18 @@ public:
      * @return bool True if the category was deleted successfully, false otherwise
      */
     bool deleteCategory(const QString& id);
+    
+    /**
+     * @brief Insert or replace a batch of categories
+     * 
+     * Unlike saveCategories(), existing categories are kept. The batch is
+     * written in a single transaction through one prepared statement.
+     * 
+     * @param categories The categories to insert or replace
+     * @param replacedCount Optional pointer receiving the number of records that already existed
+     * @return bool True if the whole batch was written, false otherwise
+     */
+    bool upsertCategories(const QList<Category>& categories, int* replacedCount = nullptr);
 
     /**
      * @brief Save multiple time entries
@@ -188,6 +218,19 @@ public:
      * @return bool True if the time entry was deleted successfully, false otherwise
      */
     bool deleteTimeEntry(const QString& id);
+    
+    /**
+     * @brief Insert or replace a batch of time entries
+     * 
+     * Unlike saveTimeEntries(), existing entries are kept. The batch is written
+     * in a single transaction through one prepared statement. Valid
+     * modification times of the entries are stored as they are.
+     * 
+     * @param timeEntries The time entries to insert or replace
+     * @param replacedCount Optional pointer receiving the number of records that already existed
+     * @return bool True if the whole batch was written, false otherwise
+     */
+    bool upsertTimeEntries(const QList<TimeEntry>& timeEntries, int* replacedCount = nullptr);
 
     /**
      * @brief Save multiple projects
@@ -229,6 +272,18 @@ public:
      * @return bool True if the project was deleted successfully, false otherwise
      */
     bool deleteProject(const QString& id);
+    
+    /**
+     * @brief Insert or replace a batch of projects
+     * 
+     * Unlike saveProjects(), existing projects are kept. The batch is written
+     * in a single transaction through one prepared statement.
+     * 
+     * @param projects The projects to insert or replace
+     * @param replacedCount Optional pointer receiving the number of records that already existed
+     * @return bool True if the whole batch was written, false otherwise
+     */
+    bool upsertProjects(const QList<Project>& projects, int* replacedCount = nullptr);
 
     /**
      * @brief Get time entries for a project
@@ -240,7 +295,81 @@ public:
      */
     QList<TimeEntry> getTimeEntriesForProject(const QString& projectId) const;
 
+    /**
+     * @brief Record a heartbeat for all running time entries
+     * 
+     * Sets last_seen on every running entry through a cached prepared statement.
+     * 
+     * @param now The heartbeat time to record
+     * @return bool True if the heartbeat was recorded, false otherwise
+     */
+    bool touchRunningTimeEntries(const QDateTime& now);
+
+    /**
+     * @brief Load the last heartbeat of running time entries
+     * 
+     * Used at startup to decide whether running entries left by a previous
+     * session should be resumed or closed.
+     * 
+     * @return QMap<QString, QDateTime> Map of running entry IDs to their last heartbeat
+     */
+    QMap<QString, QDateTime> loadRunningTimeEntryHeartbeats();
+
+    /**
+     * @brief Visit the time entries overlapping a time range
+     * 
+     * Streams entries from a forward-only cursor instead of building a list,
+     * for exports that may cover years of entries.
+     * 
+     * @param from Start of the range
+     * @param to End of the range (exclusive)
+     * @param visitor Called for each entry in start time order; returning false stops the scan
+     * @return bool True if the scan completed or was stopped by the visitor, false on a query error
+     */
+    bool forEachTimeEntry(const QDateTime& from, const QDateTime& to,
+                          const std::function<bool(const TimeEntry&)>& visitor) const;
+    
+    /**
+     * @brief Visit all time entries
+     * 
+     * Streams every entry from a forward-only cursor, in start time order.
+     * 
+     * @param visitor Called for each entry; returning false stops the scan
+     * @return bool True if the scan completed or was stopped by the visitor, false on a query error
+     */
+    bool forEachTimeEntry(const std::function<bool(const TimeEntry&)>& visitor) const;
+    
+    /**
+     * @brief Visit the time entries modified since a point in time
+     * 
+     * Every insert or change of a time entry stamps its modified_at column, so
+     * this yields exactly the entries an incremental export has to include.
+     * Deleted entries are not reported.
+     * 
+     * @param since Entries inserted or changed at or after this time are visited
+     * @param visitor Called for each entry in modification order; returning false stops the scan
+     * @return bool True if the scan completed or was stopped by the visitor, false on a query error
+     */
+    bool forEachTimeEntryModifiedSince(const QDateTime& since,
+                                       const std::function<bool(const TimeEntry&)>& visitor) const;
+
 private:
+    /**
+     * @brief Build a time entry from the current row of a query
+     * 
+     * @param query The query positioned on a row selecting the time entry columns
+     * @return TimeEntry The time entry of the row
+     */
+    static TimeEntry timeEntryFromQuery(const QSqlQuery& query);
+    
+    /**
+     * @brief Run a prepared time entry query and visit its rows
+     * 
+     * @param query Prepared forward-only query selecting the time entry columns
+     * @param visitor Called for each entry; returning false stops the scan
+     * @return bool True if the scan completed or was stopped by the visitor, false on a query error
+     */
+    static bool visitTimeEntries(QSqlQuery& query, const std::function<bool(const TimeEntry&)>& visitor);
     /**
      * @brief Private constructor
      * 
@@ -316,6 +445,67 @@ private:
      */
     bool createTimeEntriesTable();
 
+    /**
+     * @brief Create the indexes and triggers of the time_entries table
+     * 
+     * Creates the start time and modification time indexes and the triggers
+     * maintaining modified_at if they don't exist.
+     * 
+     * @return bool True if all objects exist, false otherwise
+     */
+    bool createTimeEntryIndexes();
+
+    /**
+     * @brief Migrate tables of an existing database
+     * 
+     * Brings databases created by older versions up to the current schema.
+     * 
+     * @return bool True if the migration succeeded, false otherwise
+     */
+    bool migrateTables();
+
+    /**
+     * @brief Get the database connection of the calling thread
+     * 
+     * Every query goes through this connection. Threads other than the one
+     * that initialized the manager get a connection of their own.
+     * 
+     * @return QSqlDatabase The connection to use on this thread
+     */
+    QSqlDatabase connection() const;
+
+    /**
+     * @brief Count the IDs of a batch that already exist in a table
+     * 
+     * @param table Name of the table
+     * @param ids The IDs to look up
+     * @return int Number of IDs present in the table
+     */
+    int countExisting(const QString& table, const QStringList& ids) const;
+
+    /**
+     * @struct ThreadConnection
+     * @brief Database connection owned by a worker thread
+     * 
+     * Removed from the connection registry when the thread finishes.
+     */
+    struct ThreadConnection {
+        QString name; ///< Connection name, unique per thread
+        
+        /**
+         * @brief Open a connection for the calling thread
+         * @param main The main connection whose settings are copied
+         */
+        explicit ThreadConnection(const QSqlDatabase& main);
+        
+        /**
+         * @brief Close and remove the connection
+         */
+        ~ThreadConnection();
+    };
+
     QSqlDatabase m_database;  ///< The SQLite database connection
     bool m_initialized;       ///< Flag indicating if the database is initialized
+    QSqlQuery m_heartbeatQuery; ///< Prepared heartbeat statement, reused for every heartbeat
+    QThread* m_connectionThread; ///< Thread owning m_database, the one that initialized the manager
 };
@@ -0,0 +1,187 @@
+/**
+ * @file icalendarwriter.cpp
+ * @brief Implementation of the ICalendarWriter class
+ * 
+ * The ICalendarWriter encodes content lines following RFC 5545 and writes
+ * them to a device in large blocks.
+ * 
+ * @author Cornebidouil
+ * @date Last updated: April 30, 2025
+ */
+
+#include "icalendarwriter.h"
+#include <QDebug>
+
+/**
+ * @brief Constructor
+ * 
+ * @param device The device to write to, opened for writing
+ */
+ICalendarWriter::ICalendarWriter(QIODevice* device)
+    : m_device(device)
+    , m_error(false)
+{
+    m_buffer.reserve(BUFFER_SIZE + 1024);
+}
+
+/**
+ * @brief Destructor
+ * 
+ * Flushes any buffered data.
+ */
+ICalendarWriter::~ICalendarWriter()
+{
+    flush();
+}
+
+/**
+ * @brief Start the calendar object
+ * 
+ * Writes the VCALENDAR header with the mandatory VERSION and PRODID
+ * properties.
+ * 
+ * @param productId Value of the PRODID property
+ */
+void ICalendarWriter::beginCalendar(const QString& productId)
+{
+    beginComponent("VCALENDAR");
+    writeValue("VERSION", "2.0");
+    writeLine("PRODID", productId.toUtf8());
+    writeValue("CALSCALE", "GREGORIAN");
+}
+
+/**
+ * @brief End the calendar object
+ */
+void ICalendarWriter::endCalendar()
+{
+    endComponent("VCALENDAR");
+}
+
+/**
+ * @brief Start a component
+ * 
+ * @param name Component name, e.g. "VEVENT"
+ */
+void ICalendarWriter::beginComponent(const char* name)
+{
+    writeLine("BEGIN", name);
+}
+
+/**
+ * @brief End a component
+ * 
+ * Writes the buffer to the device once it is full.
+ * 
+ * @param name Component name, e.g. "VEVENT"
+ */
+void ICalendarWriter::endComponent(const char* name)
+{
+    writeLine("END", name);
+    
+    if (m_buffer.size() >= BUFFER_SIZE) {
+        flush();
+    }
+}
+
+/**
+ * @brief Write a text property
+ * 
+ * @param name Property name
+ * @param value The text
+ */
+void ICalendarWriter::writeText(const char* name, const QString& value)
+{
+    // The escaped characters are ASCII, which never occurs inside a UTF-8
+    // multi-byte sequence, so the encoded bytes can be scanned directly
+    const QByteArray utf8 = value.toUtf8();
+    QByteArray escaped;
+    escaped.reserve(utf8.size() + 8);
+    
+    for (const char c : utf8) {
+        switch (c) {
+        case '\\': escaped.append("\\\\"); break;
+        case ';': escaped.append("\\;"); break;
+        case ',': escaped.append("\\,"); break;
+        case '\n': escaped.append("\\n"); break;
+        case '\r': break;
+        default: escaped.append(c);
+        }
+    }
+    
+    writeLine(name, escaped);
+}
+
+/**
+ * @brief Write a date-time property in UTC
+ * 
+ * @param name Property name
+ * @param value The time
+ */
+void ICalendarWriter::writeDateTime(const char* name, const QDateTime& value)
+{
+    writeLine(name, value.toUTC().toString("yyyyMMdd'T'HHmmss'Z'").toLatin1());
+}
+
+/**
+ * @brief Write a property whose value needs no escaping
+ * 
+ * @param name Property name
+ * @param value The value
+ */
+void ICalendarWriter::writeValue(const char* name, const QByteArray& value)
+{
+    writeLine(name, value);
+}
+
+/**
+ * @brief Write a content line, folding it if needed
+ * 
+ * Folded lines continue with CRLF and a single space. Folds are placed before
+ * a UTF-8 lead byte, never inside a multi-byte sequence.
+ * 
+ * @param name Property name
+ * @param value Encoded property value
+ */
+void ICalendarWriter::writeLine(const char* name, const QByteArray& value)
+{
+    const QByteArray line = QByteArray(name) + ':' + value;
+    
+    int lineStart = 0;
+    int limit = LINE_LENGTH;
+    while (line.size() - lineStart > limit) {
+        int fold = lineStart + limit;
+        while (fold > lineStart && (uchar(line.at(fold)) & 0xC0) == 0x80) {
+            --fold;
+        }
+        m_buffer.append(line.constData() + lineStart, fold - lineStart);
+        m_buffer.append("\r\n ");
+        lineStart = fold;
+        // The leading space of a continuation line counts towards its length
+        limit = LINE_LENGTH - 1;
+    }
+    
+    m_buffer.append(line.constData() + lineStart, line.size() - lineStart);
+    m_buffer.append("\r\n");
+}
+
+/**
+ * @brief Write buffered data to the device
+ * 
+ * @return bool True if all data written so far reached the device
+ */
+bool ICalendarWriter::flush()
+{
+    if (m_buffer.isEmpty() || m_error) {
+        m_buffer.resize(0);
+        return !m_error;
+    }
+    
+    if (m_device->write(m_buffer) != m_buffer.size()) {
+        qWarning() << "Failed to write calendar data:" << m_device->errorString();
+        m_error = true;
+    }
+    
+    m_buffer.resize(0);
+    return !m_error;
+}
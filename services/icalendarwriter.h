@@ -0,0 +1,119 @@
+/**
+ * @file icalendarwriter.h
+ * @brief Definition of the ICalendarWriter class
+ * 
+ * This file defines the ICalendarWriter class which writes RFC 5545
+ * iCalendar data to a device through a fixed-size buffer.
+ * 
+ * @author Cornebidouil
+ * @date Last updated: April 30, 2025
+ */
+
+#pragma once
+
+#include <QIODevice>
+#include <QByteArray>
+#include <QString>
+#include <QDateTime>
+
+/**
+ * @class ICalendarWriter
+ * @brief Buffered RFC 5545 iCalendar writer
+ * 
+ * Components and properties are written one at a time and encoded as UTF-8
+ * into an internal buffer that is written to the device whenever it fills up,
+ * so the memory used does not depend on the number of components. Text values
+ * are escaped, times are written in UTC, and content lines longer than 75
+ * octets are folded without splitting UTF-8 sequences. Lines end with CRLF.
+ * 
+ * The device must be opened without QIODevice::Text so line endings are kept.
+ */
+class ICalendarWriter {
+public:
+    /**
+     * @brief Constructor
+     * @param device The device to write to, opened for writing
+     */
+    explicit ICalendarWriter(QIODevice* device);
+    
+    /**
+     * @brief Destructor
+     * 
+     * Flushes any buffered data.
+     */
+    ~ICalendarWriter();
+    
+    /**
+     * @brief Start the calendar object
+     * @param productId Value of the PRODID property
+     */
+    void beginCalendar(const QString& productId);
+    
+    /**
+     * @brief End the calendar object
+     */
+    void endCalendar();
+    
+    /**
+     * @brief Start a component
+     * @param name Component name, e.g. "VEVENT"
+     */
+    void beginComponent(const char* name);
+    
+    /**
+     * @brief End a component
+     * @param name Component name, e.g. "VEVENT"
+     */
+    void endComponent(const char* name);
+    
+    /**
+     * @brief Write a text property
+     * 
+     * Backslashes, semicolons, commas and line breaks are escaped.
+     * 
+     * @param name Property name
+     * @param value The text
+     */
+    void writeText(const char* name, const QString& value);
+    
+    /**
+     * @brief Write a date-time property in UTC
+     * @param name Property name
+     * @param value The time
+     */
+    void writeDateTime(const char* name, const QDateTime& value);
+    
+    /**
+     * @brief Write a property whose value needs no escaping
+     * @param name Property name
+     * @param value The value, e.g. a number or an enumerated keyword
+     */
+    void writeValue(const char* name, const QByteArray& value);
+    
+    /**
+     * @brief Write buffered data to the device
+     * @return bool True if all data written so far reached the device
+     */
+    bool flush();
+    
+    /**
+     * @brief Check if a write to the device failed
+     * @return bool True if a write failed
+     */
+    bool hasError() const { return m_error; }
+
+private:
+    /**
+     * @brief Write a content line, folding it if needed
+     * @param name Property name
+     * @param value Encoded property value
+     */
+    void writeLine(const char* name, const QByteArray& value);
+    
+    static const int BUFFER_SIZE = 64 * 1024; ///< Buffered bytes before writing to the device
+    static const int LINE_LENGTH = 75;        ///< Maximum octets per content line before folding
+    
+    QIODevice* m_device;   ///< Device receiving the calendar data
+    QByteArray m_buffer;   ///< Encoded data not yet written
+    bool m_error;          ///< True if a write to the device failed
+};
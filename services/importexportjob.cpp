@@ -0,0 +1,89 @@
+/**
+ * @file importexportjob.cpp
+ * @brief Implementation of the ImportExportJob class
+ * 
+ * The ImportExportJob runs its work on the global thread pool and forwards
+ * throttled progress reports to the GUI thread.
+ * 
+ * @author Cornebidouil
+ * @date Last updated: April 30, 2025
+ */
+
+#include "importexportjob.h"
+#include <QElapsedTimer>
+#include <QtConcurrent>
+
+/**
+ * @brief Constructor
+ * 
+ * @param work The work to run
+ * @param parent Optional parent QObject
+ */
+ImportExportJob::ImportExportJob(const Work& work, QObject* parent)
+    : QObject(parent)
+    , m_work(work)
+    , m_cancelled(0)
+{
+}
+
+/**
+ * @brief Destructor
+ * 
+ * Cancels a running job and waits for it to stop, since the worker uses
+ * this object.
+ */
+ImportExportJob::~ImportExportJob()
+{
+    cancel();
+    m_future.waitForFinished();
+}
+
+/**
+ * @brief Start the job on the global thread pool
+ */
+void ImportExportJob::start()
+{
+    if (isRunning()) {
+        return;
+    }
+
+    m_cancelled.storeRelease(0);
+    m_future = QtConcurrent::run([this]() {
+        run();
+    });
+}
+
+/**
+ * @brief Ask the job to stop
+ */
+void ImportExportJob::cancel()
+{
+    m_cancelled.storeRelease(1);
+}
+
+/**
+ * @brief Run the work
+ * 
+ * Signals emitted here are queued to receivers on the GUI thread. The summary
+ * is stored before finished() is emitted, so receivers see the final counts.
+ */
+void ImportExportJob::run()
+{
+    ImportExportService service;
+
+    QElapsedTimer sinceProgress;
+    sinceProgress.start();
+
+    service.setProgressHandler([this, &sinceProgress](qint64 bytesDone, qint64 bytesTotal, int records) {
+        if (sinceProgress.elapsed() >= PROGRESS_INTERVAL_MS) {
+            sinceProgress.restart();
+            emit progress(bytesDone, bytesTotal, records);
+        }
+        return m_cancelled.loadAcquire() == 0;
+    });
+
+    bool success = m_work(service);
+
+    m_summary = service.summary();
+    emit finished(success && !m_summary.cancelled);
+}
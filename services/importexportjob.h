@@ -0,0 +1,127 @@
+/**
+ * @file importexportjob.h
+ * @brief Definition of the ImportExportJob class
+ * 
+ * This file defines the ImportExportJob class which runs an import or export
+ * on a worker thread with progress reporting and cancellation.
+ * 
+ * @author Cornebidouil
+ * @date Last updated: April 30, 2025
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QFuture>
+#include <QAtomicInt>
+#include <functional>
+#include "importexportservice.h"
+
+/**
+ * @class ImportExportJob
+ * @brief Background import or export
+ * 
+ * The work is a function running ImportExportService operations; it is
+ * started on the global thread pool with a service of its own, whose database
+ * access goes through the worker thread's connection, so the GUI thread keeps
+ * processing events. Progress is reported through the progress() signal at
+ * most every PROGRESS_INTERVAL_MS, and finished() is emitted once with the
+ * summary available from summary().
+ * 
+ * Imports commit each batch in its own transaction: cancelling stops after the
+ * current batch and keeps the batches already written. Destroying a running
+ * job cancels it and waits for the worker.
+ * 
+ * @code
+ * auto* job = new ImportExportJob([path](ImportExportService& service) {
+ *     return service.importTimeEntriesFromJsonToDatabase(path);
+ * }, this);
+ * connect(job, &ImportExportJob::finished, this, [job](bool success) { ... job->deleteLater(); });
+ * job->start();
+ * @endcode
+ */
+class ImportExportJob : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief The work of a job
+     * 
+     * Runs on a worker thread and returns true if it succeeded.
+     */
+    typedef std::function<bool(ImportExportService& service)> Work;
+
+    /**
+     * @brief Constructor
+     * @param work The work to run
+     * @param parent Optional parent QObject
+     */
+    explicit ImportExportJob(const Work& work, QObject* parent = nullptr);
+
+    /**
+     * @brief Destructor
+     * 
+     * Cancels a running job and waits for it to stop.
+     */
+    ~ImportExportJob() override;
+
+    /**
+     * @brief Start the job on the global thread pool
+     * 
+     * Does nothing if the job is already running.
+     */
+    void start();
+
+    /**
+     * @brief Ask the job to stop
+     * 
+     * Thread-safe. The job stops at its next progress report.
+     */
+    void cancel();
+
+    /**
+     * @brief Check if the job is running
+     * @return bool True between start() and the end of the work
+     */
+    bool isRunning() const { return m_future.isRunning(); }
+
+    /**
+     * @brief Get the records handled by the job
+     * 
+     * Complete once finished() was emitted.
+     * 
+     * @return ImportExportService::Summary The summary of the job
+     */
+    ImportExportService::Summary summary() const { return m_summary; }
+
+signals:
+    /**
+     * @brief Emitted while the job runs
+     * @param bytesDone Bytes of the file processed
+     * @param bytesTotal Size of the file, 0 if unknown
+     * @param records Records handled so far
+     */
+    void progress(qint64 bytesDone, qint64 bytesTotal, int records);
+
+    /**
+     * @brief Emitted once when the job ends
+     * @param success True if the work completed without error or cancellation
+     */
+    void finished(bool success);
+
+private:
+    /**
+     * @brief Run the work
+     * 
+     * Runs on the worker thread.
+     */
+    void run();
+
+    static const int PROGRESS_INTERVAL_MS = 100; ///< Minimum time between progress signals
+
+    Work m_work;                               ///< The work to run
+    QFuture<void> m_future;                    ///< The running work
+    QAtomicInt m_cancelled;                    ///< Non-zero once cancel() was called
+    ImportExportService::Summary m_summary;    ///< Records handled, set when the work ends
+};
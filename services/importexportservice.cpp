@@ -3,7 +3,8 @@
  * @brief Implementation of the ImportExportService class
  * 
  * This file implements the ImportExportService class which provides functionality
- * for importing and exporting tasks and categories in various file formats (JSON, CSV).
+ * for importing and exporting tasks and categories in various file formats (JSON,
+ * JSON Lines, CSV).
  * It handles serialization and deserialization of application data for backup,
  * migration, or sharing purposes.
  * 
@@ -12,332 +13,1885 @@
  */
 
 #include "importexportservice.h"
+#include "databasemanager.h"
+#include "csvwriter.h"
+#include "jsonstreamreader.h"
+#include "jsonstreamwriter.h"
+#include "csvreader.h"
+#include "cborsnapshot.h"
+#include "compresseddevice.h"
+#include "icalendarwriter.h"
 #include <QFile>
-#include <QJsonDocument>
-#include <QJsonArray>
+#include <QTemporaryFile>
+#include <QSaveFile>
+#include <QDataStream>
 #include <QJsonObject>
-#include <QTextStream>
+#include <QJsonDocument>
+#include <QSet>
+#include <QThread>
+#include <QUuid>
+#include <QFuture>
+#include <QtConcurrent>
 #include <QDebug>
+#include <cstring>
+
+/**
+ * @brief Constructor
+ * 
+ * Creates a new ImportExportService instance.
+ * 
+ * @param parent Optional parent QObject
+ */
+ImportExportService::ImportExportService(QObject* parent)
+    : QObject(parent)
+    , m_bytesDone(0)
+    , m_bytesTotal(0)
+{
+}
+
+/**
+ * @brief Set the handler receiving progress reports
+ * 
+ * @param handler Called with bytes done, bytes total and records handled; returning false cancels
+ */
+void ImportExportService::setProgressHandler(const ProgressHandler& handler)
+{
+    m_progressHandler = handler;
+}
+
+/**
+ * @brief Report progress to the handler
+ * 
+ * @return bool False if the handler cancelled the operation
+ */
+bool ImportExportService::reportProgress()
+{
+    if (m_summary.cancelled) {
+        return false;
+    }
+
+    if (m_progressHandler && !m_progressHandler(m_bytesDone, m_bytesTotal,
+                                                m_summary.written() + m_summary.skipped + m_summary.exported)) {
+        m_summary.cancelled = true;
+        qDebug() << "Import/export cancelled";
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Count an exported record and report progress periodically
+ * 
+ * @param file The file being written, whose position gives the bytes written
+ * @return bool False if the operation was cancelled
+ */
+bool ImportExportService::recordExported(const QFileDevice& file)
+{
+    if (++m_summary.exported % IMPORT_BATCH_SIZE != 0) {
+        return !m_summary.cancelled;
+    }
+
+    m_bytesDone = file.pos();
+    return reportProgress();
+}
+
+/**
+ * @brief Write an export file
+ * 
+ * Opens the file, compressed as its extension asks, and hands the device to
+ * the writer, which calls recorded() after each record. The export fails if
+ * the writer fails, the operation was cancelled or the device reports an
+ * error once closed.
+ * 
+ * @param filePath Path to the output file
+ * @param append True to append to an existing file instead of replacing it
+ * @param write Writes the records to the device; returns false on failure
+ * @return bool True if export was successful, false otherwise
+ */
+bool ImportExportService::writeExportFile(const QString& filePath, bool append,
+                                          const std::function<bool(QIODevice* device, const std::function<bool()>& recorded)>& write)
+{
+    QIODevice::OpenMode mode = QIODevice::WriteOnly;
+    if (append) {
+        mode |= QIODevice::Append;
+    }
+
+    QFile file(filePath);
+    if (!file.open(mode)) {
+        qWarning() << "Could not open file for writing:" << filePath;
+        return false;
+    }
+
+    CompressedDevice device(&file, CompressedDevice::compressionForPath(filePath));
+    if (!device.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    bool success = write(&device, [this, &file]() {
+        return recordExported(file);
+    });
+
+    success = success && !m_summary.cancelled;
+    device.close();
+    file.close();
+    return success && !device.hasError();
+}
+
+/**
+ * @brief Write an export file of JSON objects
+ * 
+ * The records are visited by forEachRecord, which passes each object to the
+ * record writer and stops when it returns false.
+ * 
+ * @param filePath Path to the output file
+ * @param jsonLines True for JSON Lines, false for a JSON array
+ * @param append True to append to an existing file instead of replacing it
+ * @param forEachRecord Visits the records; returns false on failure
+ * @return bool True if export was successful, false otherwise
+ */
+bool ImportExportService::writeJsonExport(const QString& filePath, bool jsonLines, bool append,
+                                          const std::function<bool(const JsonRecordWriter& write)>& forEachRecord)
+{
+    return writeExportFile(filePath, append, [&](QIODevice* device, const std::function<bool()>& recorded) {
+        JsonStreamWriter json(device, jsonLines ? JsonStreamWriter::JsonLines : JsonStreamWriter::Array);
+        json.beginArray();
+
+        bool success = forEachRecord([&json, &recorded](const QJsonObject& object) {
+            json.writeObject(object);
+            return !json.hasError() && recorded();
+        });
+
+        json.endArray();
+        return json.flush() && success;
+    });
+}
+
+/**
+ * @brief Write a batch in one transaction and account for it
+ * 
+ * Records replacing an existing record with the same ID count as updated,
+ * the others as inserted. The batch is cleared once written.
+ * 
+ * @param batch The records to write
+ * @param upsert The DatabaseManager method writing the batch
+ * @return bool False if the write failed or the operation was cancelled
+ */
+template <typename T>
+bool ImportExportService::writeBatch(QList<T>& batch, bool (DatabaseManager::*upsert)(const QList<T>&, int*))
+{
+    int replaced = 0;
+    if (!(DatabaseManager::instance().*upsert)(batch, &replaced)) {
+        return false;
+    }
+
+    m_summary.inserted += batch.size() - replaced;
+    m_summary.updated += replaced;
+    batch.clear();
+
+    return reportProgress();
+}
+
+/**
+ * @brief Add a record known to the database
+ * 
+ * Content hashes are reference counted: a record replacing one with the same
+ * ID releases the old hash, so content no row holds any more is not taken
+ * for a duplicate.
+ * 
+ * @param id ID of the record
+ * @param hash Content hash of the record
+ * @param modified Modification time of the record
+ */
+void ImportExportService::MergeIndex::add(const QString& id, quint64 hash, const QDateTime& modified)
+{
+    auto replaced = records.find(id);
+    if (replaced != records.end()) {
+        auto count = hashes.find(replaced.value().first);
+        if (count != hashes.end() && --count.value() == 0) {
+            hashes.erase(count);
+        }
+        replaced.value() = qMakePair(hash, modified);
+    } else {
+        records.insert(id, qMakePair(hash, modified));
+    }
+    ++hashes[hash];
+}
+
+/**
+ * @brief Classify an imported record of a merge import
+ * 
+ * One hash lookup by ID and at most one by content. Records with a new ID are
+ * inserted unless their content already exists under another ID. Records with
+ * a known ID are skipped if identical, otherwise resolved by the policy.
+ * Accepted records are added to the index, so later records of the same file
+ * are compared with them, and a record replacing one accepted earlier takes
+ * its place in the write list.
+ * 
+ * @param record The imported record
+ * @param modified Modification time of the imported record
+ * @param policy How to resolve a conflicting record
+ * @param index Existing and accepted records, updated with the decision
+ * @param writes Records to write, updated with the decision
+ */
+template <typename T>
+void ImportExportService::mergeRecord(T record, const QDateTime& modified, MergePolicy policy,
+                                      MergeIndex& index, QList<T>& writes)
+{
+    const quint64 hash = record.contentHash();
+    auto existing = index.records.constFind(record.id());
+
+    if (existing == index.records.constEnd()) {
+        if (index.hashes.contains(hash)) {
+            ++index.skipped;
+            return;
+        }
+    } else if (existing.value().first == hash) {
+        ++index.skipped;
+        return;
+    } else {
+        bool accept = true;
+        switch (policy) {
+        case SkipConflicts:
+            accept = false;
+            break;
+        case Overwrite:
+            break;
+        case KeepNewest:
+            accept = modified.isValid() && (!existing.value().second.isValid() || modified > existing.value().second);
+            break;
+        case KeepBoth:
+            accept = !index.hashes.contains(hash);
+            record.setId(QUuid::createUuid().toString().remove('{').remove('}'));
+            break;
+        }
+
+        if (!accept) {
+            ++index.skipped;
+            return;
+        }
+    }
+
+    const bool known = index.records.contains(record.id());
+    auto pending = index.pending.constFind(record.id());
+    if (pending != index.pending.constEnd()) {
+        writes[pending.value()] = record;
+    } else {
+        if (known) {
+            ++index.updated;
+        } else {
+            ++index.inserted;
+        }
+        index.pending.insert(record.id(), writes.size());
+        writes.append(record);
+    }
+
+    index.add(record.id(), hash, modified);
+}
+
+/**
+ * @brief Write the records accepted by a merge import in one transaction
+ * 
+ * The counts of the index are added to the summary once the records were
+ * written.
+ * 
+ * @param index The accepted records
+ * @param writes The records to write
+ * @param upsert The DatabaseManager method writing the records
+ * @return bool True if the records were written, false otherwise
+ */
+template <typename T>
+bool ImportExportService::commitMerge(const MergeIndex& index, const QList<T>& writes,
+                                      bool (DatabaseManager::*upsert)(const QList<T>&, int*))
+{
+    if (!writes.isEmpty() && !(DatabaseManager::instance().*upsert)(writes, nullptr)) {
+        return false;
+    }
+
+    m_summary.inserted += index.inserted;
+    m_summary.updated += index.updated;
+    m_summary.skipped += index.skipped;
+
+    qDebug() << "Merged" << index.inserted << "new and" << index.updated << "updated records,"
+             << index.skipped << "skipped";
+    return reportProgress();
+}
+
+/**
+ * @brief Export tasks to JSON format
+ * 
+ * Serializes a list of tasks to a JSON file.
+ * The file will contain a JSON array of task objects, written one element at
+ * a time.
+ * 
+ * @param filePath Path to the output file
+ * @param tasks List of Task objects to export
+ * @return bool True if export was successful, false otherwise
+ */
+bool ImportExportService::exportTasksToJson(const QString& filePath, const QList<Task>& tasks)
+{
+    return writeJsonExport(filePath, false, false, [&tasks](const JsonRecordWriter& write) {
+        for (const Task& task : tasks) {
+            if (!write(task.toJson())) {
+                return false;
+            }
+        }
+        return true;
+    });
+}
+
+/**
+ * @brief Export tasks to CSV format
+ * 
+ * Serializes a list of tasks to a CSV file.
+ * The file will include a header row and a row for each task. Fields are
+ * escaped following RFC 4180, so titles and descriptions may contain commas,
+ * quotes and line breaks.
+ * 
+ * @param filePath Path to the output file
+ * @param tasks List of Task objects to export
+ * @return bool True if export was successful, false otherwise
+ */
+bool ImportExportService::exportTasksToCsv(const QString& filePath, const QList<Task>& tasks)
+{
+    return writeExportFile(filePath, false, [&tasks](QIODevice* device, const std::function<bool()>& recorded) {
+        CsvWriter csv(device);
+
+        // Write header row
+        csv.writeRow(QStringList() << "ID" << "Title" << "Description" << "Completed" << "CreatedDate" << "DueDate" << "CategoryID" << "Priority");
+
+        // Write task rows
+        bool success = true;
+        for (const Task& task : tasks) {
+            csv.addField(task.id());
+            csv.addField(task.title());
+            csv.addField(task.description());
+            csv.addField(qint64(task.isCompleted() ? 1 : 0));
+            csv.addField(task.createdDate().toString(Qt::ISODate));
+            csv.addField(task.dueDate().isValid() ? task.dueDate().toString(Qt::ISODate) : QString());
+            csv.addField(task.categoryId());
+            csv.addField(qint64(task.priority()));
+            csv.endRow();
+            if (csv.hasError() || !recorded()) {
+                success = false;
+                break;
+            }
+        }
+
+        return csv.flush() && success;
+    });
+}
+
+/**
+ * @brief Export categories to JSON format
+ * 
+ * Serializes a list of categories to a JSON file.
+ * The file will contain a JSON array of category objects, written one element
+ * at a time.
+ * 
+ * @param filePath Path to the output file
+ * @param categories List of Category objects to export
+ * @return bool True if export was successful, false otherwise
+ */
+bool ImportExportService::exportCategoriesToJson(const QString& filePath, const QList<Category>& categories)
+{
+    return writeJsonExport(filePath, false, false, [&categories](const JsonRecordWriter& write) {
+        for (const Category& category : categories) {
+            if (!write(category.toJson())) {
+                return false;
+            }
+        }
+        return true;
+    });
+}
+
+/**
+ * @brief Export projects to JSON format
+ * 
+ * Serializes a list of projects to a JSON file.
+ * The file will contain a JSON array of project objects, written one element
+ * at a time.
+ * 
+ * @param filePath Path to the output file
+ * @param projects List of Project objects to export
+ * @return bool True if export was successful, false otherwise
+ */
+bool ImportExportService::exportProjectsToJson(const QString& filePath, const QList<Project>& projects)
+{
+    return writeJsonExport(filePath, false, false, [&projects](const JsonRecordWriter& write) {
+        for (const Project& project : projects) {
+            if (!write(project.toJson())) {
+                return false;
+            }
+        }
+        return true;
+    });
+}
+
+/**
+ * @brief Export all time entries to JSON format
+ * 
+ * Streams every time entry from a database cursor to a JSON array. Each entry
+ * also carries the name of its project, so it can be matched on import into a
+ * database where the project has a different ID.
+ * 
+ * @param filePath Path to the output file
+ * @param projectNames Map of project IDs to project names
+ * @return bool True if export was successful, false otherwise
+ */
+bool ImportExportService::exportTimeEntriesToJson(const QString& filePath, const QHash<QString, QString>& projectNames)
+{
+    return writeJsonExport(filePath, false, false, [&projectNames](const JsonRecordWriter& write) {
+        return DatabaseManager::instance().forEachTimeEntry([&](const TimeEntry& entry) {
+            return write(timeEntryToJson(entry, projectNames));
+        });
+    });
+}
+
+/**
+ * @brief Export raw time entries to CSV format
+ * 
+ * Entries are read from a database cursor and written through a buffered
+ * RFC 4180 writer, so memory use stays constant however many entries the range
+ * holds. Running entries have an empty end time and their duration so far.
+ * 
+ * @param filePath Path to the output file
+ * @param startDate First day of the range
+ * @param endDate Last day of the range (inclusive)
+ * @param projectNames Map of project IDs to project names
+ * @return bool True if export was successful, false otherwise
+ */
+bool ImportExportService::exportTimeEntriesToCsv(const QString& filePath, const QDate& startDate, const QDate& endDate,
+                                                 const QHash<QString, QString>& projectNames)
+{
+    return writeExportFile(filePath, false, [&](QIODevice* device, const std::function<bool()>& recorded) {
+        CsvWriter csv(device);
+        csv.writeRow(QStringList() << "ID" << "Project" << "ProjectID" << "StartTime" << "EndTime" << "DurationSeconds" << "Notes");
+
+        QDateTime from(startDate, QTime(0, 0));
+        QDateTime to(endDate.addDays(1), QTime(0, 0));
+
+        bool success = DatabaseManager::instance().forEachTimeEntry(from, to, [&](const TimeEntry& entry) {
+            csv.addField(entry.id());
+            csv.addField(projectNames.value(entry.projectId()));
+            csv.addField(entry.projectId());
+            csv.addField(entry.startTime().toString(Qt::ISODate));
+            csv.addField(entry.isRunning() ? QString() : entry.endTime().toString(Qt::ISODate));
+            csv.addField(qint64(entry.duration()));
+            csv.addField(entry.notes());
+            csv.endRow();
+            return !csv.hasError() && recorded();
+        });
+
+        return csv.flush() && success;
+    });
+}
+
+/**
+ * @brief Export tasks to JSON Lines format
+ * 
+ * @param filePath Path to the output file
+ * @param tasks List of Task objects to export
+ * @param append True to append to an existing file instead of replacing it
+ * @return bool True if export was successful, false otherwise
+ */
+bool ImportExportService::exportTasksToJsonLines(const QString& filePath, const QList<Task>& tasks, bool append)
+{
+    return writeJsonExport(filePath, true, append, [&tasks](const JsonRecordWriter& write) {
+        for (const Task& task : tasks) {
+            if (!write(task.toJson())) {
+                return false;
+            }
+        }
+        return true;
+    });
+}
+
+/**
+ * @brief Export time entries to JSON Lines format
+ * 
+ * Entries come straight from a database cursor. For incremental exports the
+ * cursor only walks the entries whose modification stamp is at or after
+ * modifiedSince, using its index.
+ * 
+ * @param filePath Path to the output file
+ * @param projectNames Map of project IDs to project names
+ * @param modifiedSince Only export entries modified at or after this time; all entries if invalid
+ * @param append True to append to an existing file instead of replacing it
+ * @return bool True if export was successful, false otherwise
+ */
+bool ImportExportService::exportTimeEntriesToJsonLines(const QString& filePath, const QHash<QString, QString>& projectNames,
+                                                       const QDateTime& modifiedSince, bool append)
+{
+    return writeJsonExport(filePath, true, append, [&](const JsonRecordWriter& write) {
+        auto writeEntry = [&](const TimeEntry& entry) {
+            return write(timeEntryToJson(entry, projectNames));
+        };
+
+        return modifiedSince.isValid()
+            ? DatabaseManager::instance().forEachTimeEntryModifiedSince(modifiedSince, writeEntry)
+            : DatabaseManager::instance().forEachTimeEntry(writeEntry);
+    });
+}
+
+/**
+ * @brief Export a binary snapshot of the whole database
+ * 
+ * @param filePath Path to the output file
+ * @return bool True if export was successful, false otherwise
+ */
+bool ImportExportService::exportSnapshot(const QString& filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Could not open file for writing:" << filePath;
+        return false;
+    }
+
+    CompressedDevice device(&file, CompressedDevice::compressionForPath(filePath));
+    if (!device.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    bool success = CborSnapshot::write(&device, [this, &file](int written) {
+        m_summary.exported = written;
+        m_bytesDone = file.pos();
+        return reportProgress();
+    });
+    device.close();
+    file.close();
+
+    if (device.hasError() || file.error() != QFileDevice::NoError) {
+        qWarning() << "Failed to write snapshot:" << (device.hasError() ? device.errorString() : file.errorString());
+        return false;
+    }
+
+    return success;
+}
+
+/**
+ * @brief Restore a binary snapshot into the database
+ * 
+ * Compressed snapshots are inflated to a temporary file first, since the CBOR
+ * reader expects a device it can peek into.
+ * 
+ * @param filePath Path to the input file
+ * @param importedCount Optional pointer receiving the number of records restored
+ * @return bool True if the whole snapshot was restored, false otherwise
+ */
+bool ImportExportService::importSnapshot(const QString& filePath, int* importedCount)
+{
+    QTemporaryFile uncompressed;
+    QString path;
+    if (!uncompressedPath(filePath, uncompressed, &path)) {
+        return false;
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Could not open file for reading:" << filePath;
+        return false;
+    }
+
+    m_bytesDone = 0;
+    m_bytesTotal = file.size();
+
+    return CborSnapshot::read(&file, importedCount, [this, &file](int written, int replaced) {
+        m_summary.inserted += written - replaced;
+        m_summary.updated += replaced;
+        m_bytesDone = file.pos();
+        return reportProgress();
+    });
+}
+
+/**
+ * @brief Import tasks from JSON format
+ * 
+ * Deserializes tasks from a JSON file.
+ * The file should contain a JSON array of task objects, which is read one
+ * element at a time instead of being loaded as a whole document.
+ * 
+ * @param filePath Path to the input file
+ * @param ok Optional pointer to boolean that will be set to true if import was successful
+ * @return QList<Task> List of imported Task objects
+ */
+QList<Task> ImportExportService::importTasksFromJson(const QString& filePath, bool* ok)
+{
+    QList<Task> tasks;
+
+    bool success = readJsonArray(filePath, [&tasks](const QJsonObject& object) {
+        tasks.append(Task::fromJson(object));
+        return true;
+    });
+
+    if (ok) *ok = success;
+    return tasks;
+}
+
+/**
+ * @brief Import tasks from CSV format
+ * 
+ * Deserializes tasks from a CSV file.
+ * The file should include a header row and a row for each task. The file is
+ * memory-mapped, parsed in parallel without copying fields, and quoted fields
+ * may span several lines.
+ * 
+ * @param filePath Path to the input file
+ * @param ok Optional pointer to boolean that will be set to true if import was successful
+ * @return QList<Task> List of imported Task objects
+ */
+QList<Task> ImportExportService::importTasksFromCsv(const QString& filePath, bool* ok)
+{
+    QList<Task> tasks;
+
+    bool success = readTasksFromCsv(filePath, [&tasks](const QList<Task>& chunk) {
+        tasks += chunk;
+        return true;
+    });
+
+    if (ok) *ok = success;
+    return tasks;
+}
+
+/**
+ * @brief Import tasks from CSV format straight into the database
+ * 
+ * Each parsed chunk is written in batches of IMPORT_BATCH_SIZE, one
+ * transaction per batch, while later chunks are still being parsed.
+ * 
+ * @param filePath Path to the input file
+ * @param importedCount Optional pointer receiving the number of tasks written
+ * @return bool True if the whole file was imported, false otherwise
+ */
+bool ImportExportService::importTasksFromCsvToDatabase(const QString& filePath, int* importedCount)
+{
+    const int writtenBefore = m_summary.written();
+
+    bool success = readTasksFromCsv(filePath, [this](const QList<Task>& chunk) {
+        for (int i = 0; i < chunk.size(); i += IMPORT_BATCH_SIZE) {
+            QList<Task> batch = chunk.mid(i, IMPORT_BATCH_SIZE);
+            if (!writeBatch(batch, &DatabaseManager::upsertTasks)) {
+                return false;
+            }
+        }
+        return true;
+    });
+
+    if (importedCount) *importedCount = m_summary.written() - writtenBefore;
+    return success;
+}
+
+/**
+ * @brief Parse the records of a CSV file in parallel
+ * 
+ * The header row is read first; the rest of the file is split into several
+ * ranges per core so uneven rows still balance across the pool. Every future
+ * is waited for before returning, since workers read the reader's mapping.
+ * 
+ * @param filePath Path to the input file
+ * @param parserForHeader Chooses the row parser for the header row
+ * @param sink Called with the records of each chunk; returning false aborts the import
+ * @return bool True if the whole file was parsed and handled, false otherwise
+ */
+template <typename T>
+bool ImportExportService::readCsv(const QString& filePath,
+                                  const std::function<CsvRowParser<T>(const QVector<CsvReader::Field>&)>& parserForHeader,
+                                  const std::function<bool(const QList<T>&)>& sink)
+{
+    QTemporaryFile uncompressed;
+    QString path;
+    if (!uncompressedPath(filePath, uncompressed, &path)) {
+        return false;
+    }
+
+    CsvReader reader(path);
+    if (!reader.open()) {
+        qWarning() << "Could not open file for reading:" << filePath << reader.errorString();
+        return false;
+    }
+
+    QVector<CsvReader::Field> header;
+    reader.readRow(header);
+
+    const CsvRowParser<T> parseRow = parserForHeader(header);
+    if (!parseRow) {
+        qWarning() << "Unexpected CSV header in file:" << filePath;
+        return false;
+    }
+
+    m_bytesDone = 0;
+    m_bytesTotal = reader.bytesAvailable();
+
+    // Small files are not worth the hand-off to the thread pool
+    if (m_bytesTotal < PARALLEL_PARSE_THRESHOLD) {
+        CsvChunk<T> chunk = parseCsvChunk(reader, reader.split(1).value(0), parseRow);
+        m_bytesDone = m_bytesTotal;
+        m_summary.skipped += chunk.skipped;
+        if (!chunk.error.isEmpty()) {
+            qWarning() << "Invalid CSV format in file:" << filePath << chunk.error;
+            return false;
+        }
+        return sink(chunk.records);
+    }
+
+    const QVector<CsvReader::Range> ranges = reader.split(QThread::idealThreadCount() * 4);
+
+    QList<QFuture<CsvChunk<T>>> futures;
+    for (const CsvReader::Range& range : ranges) {
+        futures.append(QtConcurrent::run([&reader, range, &parseRow]() {
+            return parseCsvChunk(reader, range, parseRow);
+        }));
+    }
+
+    bool success = true;
+    for (int i = 0; i < futures.size(); ++i) {
+        CsvChunk<T> chunk = futures[i].result();
+        if (!success) {
+            continue;
+        }
+
+        m_bytesDone += ranges.at(i).end - ranges.at(i).begin;
+        m_summary.skipped += chunk.skipped;
+
+        if (!chunk.error.isEmpty()) {
+            qWarning() << "Invalid CSV format in file:" << filePath << chunk.error;
+            success = false;
+        } else if (!sink(chunk.records)) {
+            success = false;
+        }
+    }
+
+    return success;
+}
+
+/**
+ * @brief Parse the records of one range of a CSV file
+ * 
+ * @param reader The reader holding the mapped file
+ * @param range The range to parse
+ * @param parseRow The row parser
+ * @return CsvChunk The parsed records and any parse error
+ */
+template <typename T>
+ImportExportService::CsvChunk<T> ImportExportService::parseCsvChunk(const CsvReader& reader, CsvReader::Range range,
+                                                                    const CsvRowParser<T>& parseRow)
+{
+    CsvChunk<T> chunk;
+    QVector<CsvReader::Field> fields;
+
+    while (reader.readRow(range, fields, &chunk.error)) {
+        T record;
+        if (parseRow(fields, record)) {
+            chunk.records.append(record);
+        } else {
+            ++chunk.skipped;
+        }
+    }
+
+    return chunk;
+}
+
+/**
+ * @brief Parse the tasks of a CSV file in parallel
+ * 
+ * Files written by exportTasksToCsv() have a fixed column order, so the
+ * header row is skipped.
+ * 
+ * @param filePath Path to the input file
+ * @param sink Called with the tasks of each chunk; returning false aborts the import
+ * @return bool True if the whole file was parsed and handled, false otherwise
+ */
+bool ImportExportService::readTasksFromCsv(const QString& filePath, const std::function<bool(const QList<Task>&)>& sink)
+{
+    return readCsv<Task>(filePath, [](const QVector<CsvReader::Field>&) {
+        return CsvRowParser<Task>([](const QVector<CsvReader::Field>& fields, Task& task) {
+            bool rowOk = true;
+            task = taskFromCsvFields(fields, &rowOk);
+            return rowOk;
+        });
+    }, sink);
+}
+
+/**
+ * @brief Import time entries exported by another time tracker
+ * 
+ * The header is matched against the mapping once; rows are then parsed in
+ * parallel. Project names are resolved on the calling thread with one hash
+ * lookup per row against the existing projects. Projects seen for the first
+ * time are written in their own transaction just before the batch using them,
+ * so no entry is written before its project; a failed batch leaves the
+ * projects created for it in place.
+ * 
+ * @param filePath Path to the input file
+ * @param mapping Which columns hold which fields
+ * @return bool True if the whole file was imported, false otherwise
+ */
+bool ImportExportService::importTimeEntriesFromExternalCsv(const QString& filePath, const TimeEntryCsvMapping& mapping)
+{
+    auto parserForHeader = [&mapping](const QVector<CsvReader::Field>& header) {
+        TimeEntryCsvColumns columns;
+        for (int i = 0; i < header.size(); ++i) {
+            const QString name = header.at(i).toString().trimmed();
+            if (name.compare(mapping.startColumn, Qt::CaseInsensitive) == 0) columns.start = i;
+            else if (name.compare(mapping.endColumn, Qt::CaseInsensitive) == 0) columns.end = i;
+            else if (name.compare(mapping.durationColumn, Qt::CaseInsensitive) == 0) columns.duration = i;
+            else if (name.compare(mapping.projectColumn, Qt::CaseInsensitive) == 0) columns.project = i;
+            else if (name.compare(mapping.notesColumn, Qt::CaseInsensitive) == 0) columns.notes = i;
+        }
+
+        if (columns.start < 0 || (columns.end < 0 && columns.duration < 0)) {
+            qWarning() << "CSV header lacks a start column, or both an end and a duration column";
+            return CsvRowParser<CsvTimeEntry>();
+        }
+
+        return CsvRowParser<CsvTimeEntry>([columns, mapping](const QVector<CsvReader::Field>& fields, CsvTimeEntry& record) {
+            return timeEntryFromCsvFields(fields, columns, mapping, record);
+        });
+    };
+
+    QHash<QString, QString> projectIds = ProjectLookup::fromDatabase().idsByName;
+    QList<Project> newProjects;
+    QList<TimeEntry> batch;
+    batch.reserve(IMPORT_BATCH_SIZE);
+
+    auto flush = [&]() {
+        if (!newProjects.isEmpty()) {
+            if (!DatabaseManager::instance().upsertProjects(newProjects)) {
+                return false;
+            }
+            newProjects.clear();
+        }
+        return batch.isEmpty() || writeBatch(batch, &DatabaseManager::upsertTimeEntries);
+    };
+
+    bool success = readCsv<CsvTimeEntry>(filePath, parserForHeader, [&](const QList<CsvTimeEntry>& chunk) {
+        for (const CsvTimeEntry& record : chunk) {
+            const QString& name = record.projectName.isEmpty() ? mapping.defaultProject : record.projectName;
+
+            auto projectId = projectIds.constFind(name);
+            if (projectId == projectIds.constEnd()) {
+                Project project(name, QColor::fromHsv(int(qHash(name) % 360), 160, 210));
+                newProjects.append(project);
+                projectId = projectIds.insert(name, project.id());
+            }
+
+            batch.append(record.entry);
+            batch.last().setProjectId(projectId.value());
+
+            if (batch.size() >= IMPORT_BATCH_SIZE && !flush()) {
+                return false;
+            }
+        }
+        return true;
+    });
+
+    return success && flush();
+}
+
+/**
+ * @brief Create a time entry from the fields of an external CSV row
+ * 
+ * Missing end times are computed from the duration and missing durations
+ * from the end time.
+ * 
+ * @param fields The fields of the row
+ * @param columns Positions of the mapped columns
+ * @param mapping The column mapping
+ * @param record Receives the entry and its project name
+ * @return bool True if the row holds a valid, finished entry
+ */
+bool ImportExportService::timeEntryFromCsvFields(const QVector<CsvReader::Field>& fields, const TimeEntryCsvColumns& columns,
+                                                 const TimeEntryCsvMapping& mapping, CsvTimeEntry& record)
+{
+    auto field = [&fields](int column) {
+        return column >= 0 && column < fields.size() ? fields.at(column).toString().trimmed() : QString();
+    };
+    auto dateTime = [&mapping](const QString& text) {
+        return mapping.dateTimeFormat.isEmpty() ? QDateTime::fromString(text, Qt::ISODate)
+                                                : QDateTime::fromString(text, mapping.dateTimeFormat);
+    };
+
+    const QDateTime start = dateTime(field(columns.start));
+    if (!start.isValid()) {
+        return false;
+    }
+
+    QDateTime end = dateTime(field(columns.end));
+    int duration = parseDuration(field(columns.duration), mapping.durationUnit);
+
+    if (end.isValid()) {
+        if (end < start) {
+            return false;
+        }
+        if (duration < 0) {
+            duration = int(start.secsTo(end));
+        }
+    } else if (duration >= 0) {
+        end = start.addSecs(duration);
+    } else {
+        return false;
+    }
+
+    record.entry.setStartTime(start);
+    record.entry.setEndTime(end);
+    record.entry.setDuration(duration);
+    record.entry.setNotes(field(columns.notes));
+    record.projectName = field(columns.project);
+    return true;
+}
+
+/**
+ * @brief Parse a duration field
+ * 
+ * Accepts h:mm and h:mm:ss, or a plain number in the given unit, which may
+ * have a fraction (e.g. 1.5 hours).
+ * 
+ * @param text The field
+ * @param unit Unit of plain numbers
+ * @return int The duration in seconds, -1 if the field is empty or invalid
+ */
+int ImportExportService::parseDuration(const QString& text, TimeEntryCsvMapping::DurationUnit unit)
+{
+    if (text.isEmpty()) {
+        return -1;
+    }
+
+    if (text.contains(':')) {
+        const QStringList parts = text.split(':');
+        if (parts.size() > 3) {
+            return -1;
+        }
+
+        int seconds = 0;
+        for (int i = 0; i < 3; ++i) {
+            bool ok = true;
+            const int value = i < parts.size() ? parts.at(i).toInt(&ok) : 0;
+            if (!ok || value < 0) {
+                return -1;
+            }
+            seconds = seconds * 60 + value;
+        }
+        return seconds;
+    }
+
+    bool ok = false;
+    const double value = text.toDouble(&ok);
+    if (!ok || value < 0) {
+        return -1;
+    }
+
+    const int scale = unit == TimeEntryCsvMapping::Hours ? 3600 : unit == TimeEntryCsvMapping::Minutes ? 60 : 1;
+    return qRound(value * scale);
+}
+
+/**
+ * @brief Import categories from JSON format
+ * 
+ * Deserializes categories from a JSON file.
+ * The file should contain a JSON array of category objects, which is read one
+ * element at a time instead of being loaded as a whole document.
+ * 
+ * @param filePath Path to the input file
+ * @param ok Optional pointer to boolean that will be set to true if import was successful
+ * @return QList<Category> List of imported Category objects
+ */
+QList<Category> ImportExportService::importCategoriesFromJson(const QString& filePath, bool* ok)
+{
+    QList<Category> categories;
+
+    bool success = readJsonArray(filePath, [&categories](const QJsonObject& object) {
+        categories.append(Category::fromJson(object));
+        return true;
+    });
+
+    if (ok) *ok = success;
+    return categories;
+}
+
+/**
+ * @brief Import projects from JSON format
+ * 
+ * Deserializes projects from a JSON file, one element at a time.
+ * 
+ * @param filePath Path to the input file
+ * @param ok Optional pointer to boolean that will be set to true if import was successful
+ * @return QList<Project> List of imported Project objects
+ */
+QList<Project> ImportExportService::importProjectsFromJson(const QString& filePath, bool* ok)
+{
+    QList<Project> projects;
+
+    bool success = readJsonArray(filePath, [&projects](const QJsonObject& object) {
+        projects.append(Project::fromJson(object));
+        return true;
+    });
+
+    if (ok) *ok = success;
+    return projects;
+}
+
+/**
+ * @brief Import time entries from JSON format
+ * 
+ * Deserializes time entries from a JSON file, one element at a time. Project
+ * references are returned as they appear in the file.
+ * 
+ * @param filePath Path to the input file
+ * @param ok Optional pointer to boolean that will be set to true if import was successful
+ * @return QList<TimeEntry> List of imported TimeEntry objects
+ */
+QList<TimeEntry> ImportExportService::importTimeEntriesFromJson(const QString& filePath, bool* ok)
+{
+    QList<TimeEntry> entries;
+
+    bool success = readJsonArray(filePath, [&entries](const QJsonObject& object) {
+        entries.append(TimeEntry::fromJson(object));
+        return true;
+    });
+
+    if (ok) *ok = success;
+    return entries;
+}
+
+/**
+ * @brief Import projects from JSON format straight into the database
+ * 
+ * @param filePath Path to the input file
+ * @param importedCount Optional pointer receiving the number of projects written
+ * @return bool True if the whole file was imported, false otherwise
+ */
+bool ImportExportService::importProjectsFromJsonToDatabase(const QString& filePath, int* importedCount)
+{
+    QList<Project> batch;
+    batch.reserve(IMPORT_BATCH_SIZE);
+    const int writtenBefore = m_summary.written();
+
+    bool success = readJsonArray(filePath, [this, &batch](const QJsonObject& object) {
+        batch.append(Project::fromJson(object));
+        return batch.size() < IMPORT_BATCH_SIZE || writeBatch(batch, &DatabaseManager::upsertProjects);
+    });
+
+    if (success && !batch.isEmpty()) {
+        success = writeBatch(batch, &DatabaseManager::upsertProjects);
+    }
+
+    if (importedCount) *importedCount = m_summary.written() - writtenBefore;
+    return success;
+}
+
+/**
+ * @brief Import time entries from JSON format straight into the database
+ * 
+ * Project references are resolved against the projects in the database with
+ * two hash lookups: by ID first, then by the exported project name. Entries
+ * whose project cannot be resolved are skipped.
+ * 
+ * @param filePath Path to the input file
+ * @param importedCount Optional pointer receiving the number of entries written
+ * @param skippedCount Optional pointer receiving the number of entries without a known project
+ * @return bool True if the whole file was imported, false otherwise
+ */
+bool ImportExportService::importTimeEntriesFromJsonToDatabase(const QString& filePath, int* importedCount, int* skippedCount)
+{
+    const ProjectLookup projects = ProjectLookup::fromDatabase();
+
+    QList<TimeEntry> batch;
+    batch.reserve(IMPORT_BATCH_SIZE);
+    const int writtenBefore = m_summary.written();
+    int skipped = 0;
+
+    bool success = readJsonArray(filePath, [&](const QJsonObject& object) {
+        TimeEntry entry = TimeEntry::fromJson(object);
+        if (!projects.resolve(entry, object.value("projectName").toString())) {
+            ++skipped;
+            return true;
+        }
+
+        batch.append(entry);
+        return batch.size() < IMPORT_BATCH_SIZE || writeBatch(batch, &DatabaseManager::upsertTimeEntries);
+    });
+
+    if (success && !batch.isEmpty()) {
+        success = writeBatch(batch, &DatabaseManager::upsertTimeEntries);
+    }
+
+    if (skipped > 0) {
+        qWarning() << "Skipped" << skipped << "time entries with an unknown project";
+    }
+
+    m_summary.skipped += skipped;
+    if (importedCount) *importedCount = m_summary.written() - writtenBefore;
+    if (skippedCount) *skippedCount = skipped;
+    return success;
+}
+
+/**
+ * @brief Import tasks from JSON format straight into the database
+ * 
+ * Tasks are collected into batches of IMPORT_BATCH_SIZE and each batch is
+ * written in one transaction, so at most one batch is held in memory.
+ * 
+ * @param filePath Path to the input file
+ * @param importedCount Optional pointer receiving the number of tasks written
+ * @return bool True if the whole file was imported, false otherwise
+ */
+bool ImportExportService::importTasksFromJsonToDatabase(const QString& filePath, int* importedCount)
+{
+    QList<Task> batch;
+    batch.reserve(IMPORT_BATCH_SIZE);
+    const int writtenBefore = m_summary.written();
+
+    bool success = readJsonArray(filePath, [this, &batch](const QJsonObject& object) {
+        batch.append(Task::fromJson(object));
+        return batch.size() < IMPORT_BATCH_SIZE || writeBatch(batch, &DatabaseManager::upsertTasks);
+    });
+
+    if (success && !batch.isEmpty()) {
+        success = writeBatch(batch, &DatabaseManager::upsertTasks);
+    }
+
+    if (importedCount) *importedCount = m_summary.written() - writtenBefore;
+    return success;
+}
+
+/**
+ * @brief Import categories from JSON format straight into the database
+ * 
+ * @param filePath Path to the input file
+ * @param importedCount Optional pointer receiving the number of categories written
+ * @return bool True if the whole file was imported, false otherwise
+ */
+bool ImportExportService::importCategoriesFromJsonToDatabase(const QString& filePath, int* importedCount)
+{
+    QList<Category> batch;
+    batch.reserve(IMPORT_BATCH_SIZE);
+    const int writtenBefore = m_summary.written();
+
+    bool success = readJsonArray(filePath, [this, &batch](const QJsonObject& object) {
+        batch.append(Category::fromJson(object));
+        return batch.size() < IMPORT_BATCH_SIZE || writeBatch(batch, &DatabaseManager::upsertCategories);
+    });
+
+    if (success && !batch.isEmpty()) {
+        success = writeBatch(batch, &DatabaseManager::upsertCategories);
+    }
+
+    if (importedCount) *importedCount = m_summary.written() - writtenBefore;
+    return success;
+}
 
 /**
- * @brief Constructor
+ * @brief Import tasks from JSON Lines format straight into the database
  * 
- * Creates a new ImportExportService instance.
+ * @param filePath Path to the input file
+ * @param importedCount Optional pointer receiving the number of tasks written
+ * @return bool True if the whole file was imported, false otherwise
+ */
+bool ImportExportService::importTasksFromJsonLinesToDatabase(const QString& filePath, int* importedCount)
+{
+    QList<Task> batch;
+    batch.reserve(IMPORT_BATCH_SIZE);
+    const int writtenBefore = m_summary.written();
+
+    bool success = readJsonLines(filePath, [this, &batch](const QList<QJsonObject>& objects) {
+        for (const QJsonObject& object : objects) {
+            batch.append(Task::fromJson(object));
+            if (batch.size() >= IMPORT_BATCH_SIZE && !writeBatch(batch, &DatabaseManager::upsertTasks)) {
+                return false;
+            }
+        }
+        return true;
+    });
+
+    if (success && !batch.isEmpty()) {
+        success = writeBatch(batch, &DatabaseManager::upsertTasks);
+    }
+
+    if (importedCount) *importedCount = m_summary.written() - writtenBefore;
+    return success;
+}
+
+/**
+ * @brief Import time entries from JSON Lines format straight into the database
  * 
- * @param parent Optional parent QObject
+ * @param filePath Path to the input file
+ * @param importedCount Optional pointer receiving the number of entries written
+ * @param skippedCount Optional pointer receiving the number of entries without a known project
+ * @return bool True if the whole file was imported, false otherwise
  */
-ImportExportService::ImportExportService(QObject* parent)
-    : QObject(parent)
+bool ImportExportService::importTimeEntriesFromJsonLinesToDatabase(const QString& filePath, int* importedCount,
+                                                                   int* skippedCount)
 {
+    const ProjectLookup projects = ProjectLookup::fromDatabase();
+
+    QList<TimeEntry> batch;
+    batch.reserve(IMPORT_BATCH_SIZE);
+    const int writtenBefore = m_summary.written();
+    int skipped = 0;
+
+    bool success = readJsonLines(filePath, [&](const QList<QJsonObject>& objects) {
+        for (const QJsonObject& object : objects) {
+            TimeEntry entry = TimeEntry::fromJson(object);
+            if (!projects.resolve(entry, object.value("projectName").toString())) {
+                ++skipped;
+                continue;
+            }
+
+            batch.append(entry);
+            if (batch.size() >= IMPORT_BATCH_SIZE && !writeBatch(batch, &DatabaseManager::upsertTimeEntries)) {
+                return false;
+            }
+        }
+        return true;
+    });
+
+    if (success && !batch.isEmpty()) {
+        success = writeBatch(batch, &DatabaseManager::upsertTimeEntries);
+    }
+
+    if (skipped > 0) {
+        qWarning() << "Skipped" << skipped << "time entries with an unknown project";
+    }
+
+    m_summary.skipped += skipped;
+    if (importedCount) *importedCount = m_summary.written() - writtenBefore;
+    if (skippedCount) *skippedCount = skipped;
+    return success;
 }
 
 /**
- * @brief Export tasks to JSON format
+ * @brief Export due tasks and finished time entries as an iCalendar feed
  * 
- * Serializes a list of tasks to a JSON file.
- * The file will contain a JSON array of task objects.
+ * A first pass hashes every item, which is much cheaper than formatting it,
+ * and compares the hashes with the index of the last export. Only if
+ * something changed is the feed written in a second pass, through a QSaveFile
+ * so calendar apps reading the feed never see a partial file. Time entries
+ * are streamed from a database cursor in both passes.
  * 
  * @param filePath Path to the output file
- * @param tasks List of Task objects to export
- * @return bool True if export was successful, false otherwise
+ * @param tasks Tasks to export; tasks without a due date are left out
+ * @param projectNames Map of project IDs to project names
+ * @param rewritten Optional pointer set to true if the feed was written, false if it was up to date
+ * @return bool True if the feed is up to date, false otherwise
  */
-bool ImportExportService::exportTasksToJson(const QString& filePath, const QList<Task>& tasks)
+bool ImportExportService::exportCalendar(const QString& filePath, const QList<Task>& tasks,
+                                         const QHash<QString, QString>& projectNames, bool* rewritten)
 {
-    QFile file(filePath);
+    if (rewritten) *rewritten = false;
+
+    const QString indexPath = filePath + ".index";
+    const CalendarIndex previous = QFile::exists(filePath) ? loadCalendarIndex(indexPath) : CalendarIndex();
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+
+    CalendarIndex index;
+    index.reserve(previous.size());
+    int changed = 0;
+
+    auto track = [&](const QString& uid, quint64 hash) {
+        auto old = previous.constFind(uid);
+        if (old != previous.constEnd() && old.value().hash == hash) {
+            index.insert(uid, old.value());
+            return;
+        }
+
+        CalendarItemState state;
+        state.hash = hash;
+        state.sequence = old != previous.constEnd() ? old.value().sequence + 1 : 0;
+        state.stamp = now;
+        index.insert(uid, state);
+        ++changed;
+    };
+
+    for (const Task& task : tasks) {
+        if (task.dueDate().isValid()) {
+            track("task-" + task.id(), task.contentHash());
+        }
+    }
+
+    bool success = DatabaseManager::instance().forEachTimeEntry([&](const TimeEntry& entry) {
+        if (!entry.isRunning()) {
+            // The project name is part of the event, so renaming a project changes its entries
+            track("entry-" + entry.id(), entry.contentHash() ^ (quint64(qHash(projectNames.value(entry.projectId()))) << 32));
+        }
+        return true;
+    });
+    if (!success) {
+        return false;
+    }
+
+    // Every item is in the index of the last export with the same hash and
+    // none was removed
+    if (changed == 0 && index.size() == previous.size()) {
+        qDebug() << "Calendar is up to date:" << filePath;
+        return true;
+    }
+
+    QSaveFile file(filePath);
     if (!file.open(QIODevice::WriteOnly)) {
         qWarning() << "Could not open file for writing:" << filePath;
         return false;
     }
 
-    QJsonArray taskArray;
+    CompressedDevice device(&file, CompressedDevice::compressionForPath(filePath));
+    if (!device.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    ICalendarWriter calendar(&device);
+    calendar.beginCalendar("-//Cornebidouil//TODO-Widget//EN");
+
     for (const Task& task : tasks) {
-        taskArray.append(task.toJson());
+        if (!task.dueDate().isValid()) {
+            continue;
+        }
+        const QString uid = "task-" + task.id();
+        writeCalendarTask(calendar, uid, task, index.value(uid));
+        if (calendar.hasError() || !recordExported(file)) {
+            success = false;
+            break;
+        }
     }
 
-    QJsonDocument doc(taskArray);
-    file.write(doc.toJson());
-    file.close();
+    success = success && DatabaseManager::instance().forEachTimeEntry([&](const TimeEntry& entry) {
+        if (entry.isRunning()) {
+            return true;
+        }
+        const QString uid = "entry-" + entry.id();
+        writeCalendarEntry(calendar, uid, entry, projectNames.value(entry.projectId()), index.value(uid));
+        return !calendar.hasError() && recordExported(file);
+    });
 
-    return true;
+    calendar.endCalendar();
+    success = calendar.flush() && success && !m_summary.cancelled;
+    device.close();
+    success = success && !device.hasError() && file.commit();
+
+    if (!success) {
+        return false;
+    }
+
+    qDebug() << "Calendar written with" << changed << "changed items:" << filePath;
+    if (rewritten) *rewritten = true;
+    return saveCalendarIndex(indexPath, index);
 }
 
 /**
- * @brief Export tasks to CSV format
+ * @brief Load the item states of a calendar feed
  * 
- * Serializes a list of tasks to a CSV file.
- * The file will include a header row and a row for each task.
+ * @param indexPath Path to the index file
+ * @return CalendarIndex The item states, empty if the index is missing or invalid
+ */
+ImportExportService::CalendarIndex ImportExportService::loadCalendarIndex(const QString& indexPath)
+{
+    CalendarIndex index;
+
+    QFile file(indexPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return index;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_12);
+
+    quint32 magic = 0;
+    quint32 count = 0;
+    stream >> magic >> count;
+    if (magic != CALENDAR_INDEX_MAGIC) {
+        qWarning() << "Ignoring invalid calendar index:" << indexPath;
+        return index;
+    }
+
+    index.reserve(int(count));
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString uid;
+        CalendarItemState state;
+        stream >> uid >> state.hash >> state.sequence >> state.stamp;
+        index.insert(uid, state);
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        qWarning() << "Ignoring truncated calendar index:" << indexPath;
+        index.clear();
+    }
+
+    return index;
+}
+
+/**
+ * @brief Save the item states of a calendar feed
  * 
- * @param filePath Path to the output file
- * @param tasks List of Task objects to export
- * @return bool True if export was successful, false otherwise
+ * @param indexPath Path to the index file
+ * @param index The item states
+ * @return bool True if the index was saved, false otherwise
  */
-bool ImportExportService::exportTasksToCsv(const QString& filePath, const QList<Task>& tasks)
+bool ImportExportService::saveCalendarIndex(const QString& indexPath, const CalendarIndex& index)
 {
-    QFile file(filePath);
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        qWarning() << "Could not open file for writing:" << filePath;
+    QSaveFile file(indexPath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Could not open file for writing:" << indexPath;
         return false;
     }
 
-    QTextStream out(&file);
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_12);
+    stream << CALENDAR_INDEX_MAGIC << quint32(index.size());
+
+    for (auto it = index.constBegin(); it != index.constEnd(); ++it) {
+        stream << it.key() << it.value().hash << it.value().sequence << it.value().stamp;
+    }
 
-    // Write header row
-    out << "ID,Title,Description,Completed,CreatedDate,DueDate,CategoryID,Priority\n";
+    return stream.status() == QDataStream::Ok && file.commit();
+}
 
-    // Write task rows
-    for (const Task& task : tasks) {
-        out << taskToCsvLine(task) << "\n";
+/**
+ * @brief Write the VTODO of a task
+ * 
+ * Task priorities 1 to 5 map to iCalendar priorities 9 (lowest) to 1
+ * (highest).
+ * 
+ * @param calendar The calendar writer
+ * @param uid UID of the item
+ * @param task The task
+ * @param state State of the item
+ */
+void ImportExportService::writeCalendarTask(ICalendarWriter& calendar, const QString& uid, const Task& task,
+                                            const CalendarItemState& state)
+{
+    calendar.beginComponent("VTODO");
+    calendar.writeText("UID", uid);
+    calendar.writeDateTime("DTSTAMP", state.stamp);
+    calendar.writeValue("SEQUENCE", QByteArray::number(state.sequence));
+    if (task.createdDate().isValid()) {
+        calendar.writeDateTime("CREATED", task.createdDate());
     }
+    calendar.writeDateTime("DUE", task.dueDate());
+    calendar.writeText("SUMMARY", task.title());
+    if (!task.description().isEmpty()) {
+        calendar.writeText("DESCRIPTION", task.description());
+    }
+    calendar.writeValue("PRIORITY", QByteArray::number(qBound(1, 11 - 2 * task.priority(), 9)));
+    calendar.writeValue("STATUS", task.isCompleted() ? "COMPLETED" : "NEEDS-ACTION");
+    calendar.endComponent("VTODO");
+}
 
-    file.close();
-    return true;
+/**
+ * @brief Write the VEVENT of a time entry
+ * 
+ * Entries are marked transparent so tracked time does not show as busy.
+ * 
+ * @param calendar The calendar writer
+ * @param uid UID of the item
+ * @param entry The time entry
+ * @param projectName Name of the entry's project
+ * @param state State of the item
+ */
+void ImportExportService::writeCalendarEntry(ICalendarWriter& calendar, const QString& uid, const TimeEntry& entry,
+                                             const QString& projectName, const CalendarItemState& state)
+{
+    calendar.beginComponent("VEVENT");
+    calendar.writeText("UID", uid);
+    calendar.writeDateTime("DTSTAMP", state.stamp);
+    calendar.writeValue("SEQUENCE", QByteArray::number(state.sequence));
+    calendar.writeDateTime("DTSTART", entry.startTime());
+    calendar.writeDateTime("DTEND", entry.endTime());
+    calendar.writeText("SUMMARY", projectName.isEmpty() ? tr("Time entry") : projectName);
+    if (!entry.notes().isEmpty()) {
+        calendar.writeText("DESCRIPTION", entry.notes());
+    }
+    calendar.writeValue("TRANSP", "TRANSPARENT");
+    calendar.endComponent("VEVENT");
 }
 
 /**
- * @brief Export categories to JSON format
+ * @brief Merge tasks from JSON format into the database
  * 
- * Serializes a list of categories to a JSON file.
- * The file will contain a JSON array of category objects.
+ * The fingerprints of the existing tasks are loaded into hash tables once,
+ * so each imported task costs a constant number of lookups and the merge is
+ * linear in the number of existing and imported tasks. The accepted tasks are
+ * held in memory and written with one prepared statement in one transaction.
  * 
- * @param filePath Path to the output file
- * @param categories List of Category objects to export
- * @return bool True if export was successful, false otherwise
+ * @param filePath Path to the input file
+ * @param policy How to resolve conflicting records
+ * @return bool True if the whole file was merged, false otherwise
  */
-bool ImportExportService::exportCategoriesToJson(const QString& filePath, const QList<Category>& categories)
+bool ImportExportService::mergeTasksFromJson(const QString& filePath, MergePolicy policy)
 {
-    QFile file(filePath);
-    if (!file.open(QIODevice::WriteOnly)) {
-        qWarning() << "Could not open file for writing:" << filePath;
+    // Creation dates say nothing about which copy changed last
+    if (policy == KeepNewest) {
+        qWarning() << "Cannot merge tasks: KeepNewest needs modification times, which tasks do not record";
         return false;
     }
 
-    QJsonArray categoryArray;
-    for (const Category& category : categories) {
-        categoryArray.append(category.toJson());
+    const QList<Task> existing = DatabaseManager::instance().loadTasks();
+
+    MergeIndex index;
+    index.records.reserve(existing.size());
+    index.hashes.reserve(existing.size());
+    for (const Task& task : existing) {
+        index.add(task.id(), task.contentHash(), QDateTime());
     }
 
-    QJsonDocument doc(categoryArray);
-    file.write(doc.toJson());
-    file.close();
+    QList<Task> writes;
+    int read = 0;
 
-    return true;
+    bool success = readJsonArray(filePath, [&](const QJsonObject& object) {
+        const Task task = Task::fromJson(object);
+        mergeRecord(task, QDateTime(), policy, index, writes);
+        return ++read % IMPORT_BATCH_SIZE != 0 || reportProgress();
+    });
+
+    return success && commitMerge(index, writes, &DatabaseManager::upsertTasks);
 }
 
 /**
- * @brief Import tasks from JSON format
+ * @brief Merge time entries from JSON format into the database
  * 
- * Deserializes tasks from a JSON file.
- * The file should contain a JSON array of task objects.
+ * The existing entries are streamed from a database cursor into the hash
+ * tables, keeping only their fingerprints. Projects are resolved before the
+ * content hash is computed, so an entry exported from a database where its
+ * project has another ID still matches its copy. Entries whose project cannot
+ * be resolved are skipped.
  * 
  * @param filePath Path to the input file
- * @param ok Optional pointer to boolean that will be set to true if import was successful
- * @return QList<Task> List of imported Task objects
+ * @param policy How to resolve conflicting records
+ * @return bool True if the whole file was merged, false otherwise
  */
-QList<Task> ImportExportService::importTasksFromJson(const QString& filePath, bool* ok)
+bool ImportExportService::mergeTimeEntriesFromJson(const QString& filePath, MergePolicy policy)
 {
-    QList<Task> tasks;
+    MergeIndex index;
+    bool success = DatabaseManager::instance().forEachTimeEntry([&index](const TimeEntry& entry) {
+        index.add(entry.id(), entry.contentHash(), entry.modifiedAt());
+        return true;
+    });
+    if (!success) {
+        return false;
+    }
 
-    QFile file(filePath);
+    const ProjectLookup projects = ProjectLookup::fromDatabase();
+    QList<TimeEntry> writes;
+    int read = 0;
+    int unresolved = 0;
+
+    success = readJsonArray(filePath, [&](const QJsonObject& object) {
+        TimeEntry entry = TimeEntry::fromJson(object);
+        if (projects.resolve(entry, object.value("projectName").toString())) {
+            mergeRecord(entry, entry.modifiedAt(), policy, index, writes);
+        } else {
+            ++unresolved;
+        }
+        return ++read % IMPORT_BATCH_SIZE != 0 || reportProgress();
+    });
+
+    if (unresolved > 0) {
+        qWarning() << "Skipped" << unresolved << "time entries with an unknown project";
+        index.skipped += unresolved;
+    }
+
+    return success && commitMerge(index, writes, &DatabaseManager::upsertTimeEntries);
+}
+
+/**
+ * @brief Parse the objects of a JSON Lines file in parallel
+ * 
+ * The file is memory-mapped and cut into ranges ending at line breaks. A raw
+ * line break cannot occur inside a JSON value, so every range holds whole
+ * records and can be parsed independently. Every future is waited for before
+ * the mapping is released.
+ * 
+ * @param filePath Path to the input file
+ * @param sink Called with the objects of each chunk; returning false aborts the import
+ * @return bool True if the whole file was parsed and handled, false otherwise
+ */
+bool ImportExportService::readJsonLines(const QString& filePath, const std::function<bool(const QList<QJsonObject>&)>& sink)
+{
+    QTemporaryFile uncompressed;
+    QString path;
+    if (!uncompressedPath(filePath, uncompressed, &path)) {
+        return false;
+    }
+
+    QFile file(path);
     if (!file.open(QIODevice::ReadOnly)) {
         qWarning() << "Could not open file for reading:" << filePath;
-        if (ok) *ok = false;
-        return tasks;
+        return false;
     }
 
-    QByteArray data = file.readAll();
-    file.close();
+    const qint64 size = file.size();
+    if (size == 0) {
+        return true;
+    }
 
-    QJsonDocument doc = QJsonDocument::fromJson(data);
-    if (doc.isNull() || !doc.isArray()) {
-        qWarning() << "Invalid JSON format in file:" << filePath;
-        if (ok) *ok = false;
-        return tasks;
+    const char* data = reinterpret_cast<const char*>(file.map(0, size, QFile::MapPrivateOption));
+    if (!data) {
+        qWarning() << "Could not map file:" << filePath << file.errorString();
+        return false;
     }
 
-    QJsonArray taskArray = doc.array();
-    for (const QJsonValue& value : taskArray) {
-        if (value.isObject()) {
-            tasks.append(Task::fromJson(value.toObject()));
+    // Small files are not worth the hand-off to the thread pool
+    const int rangeCount = size < PARALLEL_PARSE_THRESHOLD ? 1 : QThread::idealThreadCount() * 4;
+
+    QVector<qint64> bounds;
+    bounds.append(0);
+    for (int i = 1; i < rangeCount; ++i) {
+        qint64 pos = qMax(bounds.last(), size * i / rangeCount);
+        const void* newline = pos < size ? memchr(data + pos, '\n', size_t(size - pos)) : nullptr;
+        if (!newline) {
+            break;
         }
+        bounds.append(static_cast<const char*>(newline) - data + 1);
     }
+    bounds.append(size);
 
-    if (ok) *ok = true;
-    return tasks;
+    QList<QFuture<JsonLinesChunk>> futures;
+    for (int i = 0; i + 1 < bounds.size(); ++i) {
+        const qint64 begin = bounds.at(i);
+        const qint64 end = bounds.at(i + 1);
+        futures.append(QtConcurrent::run([data, begin, end]() {
+            return parseJsonLines(data + begin, end - begin, begin);
+        }));
+    }
+
+    m_bytesDone = 0;
+    m_bytesTotal = size;
+
+    bool success = true;
+    for (int i = 0; i < futures.size(); ++i) {
+        JsonLinesChunk chunk = futures[i].result();
+        if (!success) {
+            continue;
+        }
+
+        m_bytesDone = bounds.at(i + 1);
+
+        if (!chunk.error.isEmpty()) {
+            qWarning() << "Invalid JSON Lines format in file:" << filePath << chunk.error;
+            success = false;
+        } else if (!sink(chunk.objects)) {
+            success = false;
+        }
+    }
+
+    return success;
 }
 
 /**
- * @brief Import tasks from CSV format
+ * @brief Parse the lines of one range of a JSON Lines file
  * 
- * Deserializes tasks from a CSV file.
- * The file should include a header row and a row for each task.
+ * Blank lines and carriage returns before line breaks are ignored. Lines are
+ * parsed in place without copying them.
  * 
- * @param filePath Path to the input file
- * @param ok Optional pointer to boolean that will be set to true if import was successful
- * @return QList<Task> List of imported Task objects
+ * @param data Start of the range
+ * @param size Length of the range in bytes
+ * @param offset Offset of the range in the file, for error messages
+ * @return JsonLinesChunk The parsed objects and any parse error
  */
-QList<Task> ImportExportService::importTasksFromCsv(const QString& filePath, bool* ok)
+ImportExportService::JsonLinesChunk ImportExportService::parseJsonLines(const char* data, qint64 size, qint64 offset)
 {
-    QList<Task> tasks;
+    JsonLinesChunk chunk;
+    qint64 pos = 0;
 
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning() << "Could not open file for reading:" << filePath;
-        if (ok) *ok = false;
-        return tasks;
+    while (pos < size) {
+        const void* newline = memchr(data + pos, '\n', size_t(size - pos));
+        qint64 end = newline ? static_cast<const char*>(newline) - data : size;
+        const qint64 next = end + 1;
+
+        if (end > pos && data[end - 1] == '\r') {
+            --end;
+        }
+
+        if (end > pos) {
+            QJsonParseError error;
+            const QJsonDocument document = QJsonDocument::fromJson(QByteArray::fromRawData(data + pos, int(end - pos)), &error);
+            if (error.error != QJsonParseError::NoError) {
+                chunk.error = QString("%1 at offset %2").arg(error.errorString()).arg(offset + pos + error.offset);
+                break;
+            }
+            if (!document.isObject()) {
+                chunk.error = QString("line at offset %1 is not an object").arg(offset + pos);
+                break;
+            }
+            chunk.objects.append(document.object());
+        }
+
+        pos = next;
     }
 
-    QTextStream in(&file);
+    return chunk;
+}
 
-    // Skip header row
-    if (!in.atEnd()) {
-        in.readLine();
+/**
+ * @brief Build the project lookup from the projects in the database
+ * 
+ * @return ProjectLookup The lookup
+ */
+ImportExportService::ProjectLookup ImportExportService::ProjectLookup::fromDatabase()
+{
+    ProjectLookup lookup;
+    for (const Project& project : DatabaseManager::instance().loadProjects()) {
+        lookup.ids.insert(project.id());
+        lookup.idsByName.insert(project.name(), project.id());
     }
+    return lookup;
+}
 
-    // Read task rows
-    while (!in.atEnd()) {
-        QString line = in.readLine();
-        bool lineOk = true;
-        Task task = taskFromCsvLine(line, &lineOk);
+/**
+ * @brief Point an entry at an existing project
+ * 
+ * Two hash lookups: by ID first, then by the exported project name.
+ * 
+ * @param entry The entry to resolve
+ * @param projectName The project name exported with the entry
+ * @return bool True if the entry's project exists
+ */
+bool ImportExportService::ProjectLookup::resolve(TimeEntry& entry, const QString& projectName) const
+{
+    if (ids.contains(entry.projectId())) {
+        return true;
+    }
 
-        if (lineOk) {
-            tasks.append(task);
-        }
+    auto resolved = idsByName.constFind(projectName);
+    if (resolved == idsByName.constEnd()) {
+        return false;
     }
 
-    file.close();
-    if (ok) *ok = true;
-    return tasks;
+    entry.setProjectId(resolved.value());
+    return true;
 }
 
 /**
- * @brief Import categories from JSON format
+ * @brief Serialize a time entry with its project name
  * 
- * Deserializes categories from a JSON file.
- * The file should contain a JSON array of category objects.
+ * The name lets imports match the project in a database where it has a
+ * different ID.
  * 
- * @param filePath Path to the input file
- * @param ok Optional pointer to boolean that will be set to true if import was successful
- * @return QList<Category> List of imported Category objects
+ * @param entry The entry to serialize
+ * @param projectNames Map of project IDs to project names
+ * @return QJsonObject The entry object
  */
-QList<Category> ImportExportService::importCategoriesFromJson(const QString& filePath, bool* ok)
+QJsonObject ImportExportService::timeEntryToJson(const TimeEntry& entry, const QHash<QString, QString>& projectNames)
 {
-    QList<Category> categories;
+    QJsonObject object = entry.toJson();
+    auto name = projectNames.constFind(entry.projectId());
+    if (name != projectNames.constEnd()) {
+        object["projectName"] = name.value();
+    }
+    return object;
+}
 
+/**
+ * @brief Stream the objects of a JSON array file
+ * 
+ * @param filePath Path to the input file
+ * @param handler Called for each object; returning false aborts the import
+ * @return bool True if the whole array was read and handled, false otherwise
+ */
+bool ImportExportService::readJsonArray(const QString& filePath, const std::function<bool(const QJsonObject&)>& handler)
+{
     QFile file(filePath);
     if (!file.open(QIODevice::ReadOnly)) {
         qWarning() << "Could not open file for reading:" << filePath;
-        if (ok) *ok = false;
-        return categories;
+        return false;
     }
 
-    QByteArray data = file.readAll();
-    file.close();
-
-    QJsonDocument doc = QJsonDocument::fromJson(data);
-    if (doc.isNull() || !doc.isArray()) {
-        qWarning() << "Invalid JSON format in file:" << filePath;
-        if (ok) *ok = false;
-        return categories;
+    CompressedDevice device(&file);
+    if (!device.open(QIODevice::ReadOnly)) {
+        return false;
     }
 
-    QJsonArray categoryArray = doc.array();
-    for (const QJsonValue& value : categoryArray) {
-        if (value.isObject()) {
-            categories.append(Category::fromJson(value.toObject()));
+    JsonStreamReader reader(&device);
+    QJsonObject object;
+    m_bytesDone = 0;
+    m_bytesTotal = file.size();
+
+    if (reader.readArrayStart()) {
+        while (reader.readNextObject(object)) {
+            m_bytesDone = file.pos();
+            if (!handler(object)) {
+                return false;
+            }
         }
     }
 
-    if (ok) *ok = true;
-    return categories;
+    if (device.hasError()) {
+        qWarning() << "Could not read file:" << filePath << device.errorString();
+        return false;
+    }
+
+    if (reader.hasError()) {
+        qWarning() << "Invalid JSON format in file:" << filePath << reader.errorString();
+        return false;
+    }
+
+    return true;
 }
 
 /**
- * @brief Convert a task to a CSV line
+ * @brief Get a path to the uncompressed contents of a file
  * 
- * Helper method that serializes a Task object to a CSV line string.
- * Handles proper escaping of fields and formats dates according to ISO standard.
+ * Plain files are used as they are. Compressed files are inflated block by
+ * block into the temporary file, for readers that map the file or need random
+ * access.
  * 
- * @param task The Task object to convert
- * @return QString The formatted CSV line
+ * @param filePath Path to the input file
+ * @param temporary Temporary file receiving the inflated contents; must outlive the use of path
+ * @param path Receives the path to read
+ * @return bool True if path can be read, false otherwise
  */
-QString ImportExportService::taskToCsvLine(const Task& task)
+bool ImportExportService::uncompressedPath(const QString& filePath, QTemporaryFile& temporary, QString* path)
 {
-    // Format: ID,Title,Description,Completed,CreatedDate,DueDate,CategoryID,Priority
-    QString line;
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Could not open file for reading:" << filePath;
+        return false;
+    }
+
+    if (CompressedDevice::detect(&file) == CompressedDevice::None) {
+        *path = filePath;
+        return true;
+    }
 
-    // Escape quotes and handle commas in title and description
-    QString escapedTitle = task.title();
-    escapedTitle.replace("\"", "\"\"");  // Double quotes to escape quotes
-    if (escapedTitle.contains(',')) {
-        escapedTitle = "\"" + escapedTitle + "\"";  // Quote fields with commas
+    CompressedDevice device(&file);
+    if (!device.open(QIODevice::ReadOnly) || !temporary.open()) {
+        qWarning() << "Could not decompress file:" << filePath;
+        return false;
     }
 
-    QString escapedDesc = task.description();
-    escapedDesc.replace("\"", "\"\"");
-    if (escapedDesc.contains(',')) {
-        escapedDesc = "\"" + escapedDesc + "\"";
+    QByteArray chunk(64 * 1024, Qt::Uninitialized);
+    qint64 read;
+    while ((read = device.read(chunk.data(), chunk.size())) > 0) {
+        if (temporary.write(chunk.constData(), read) != read) {
+            qWarning() << "Could not write decompressed data:" << temporary.errorString();
+            return false;
+        }
     }
 
-    // Build the CSV line with each field
-    line += task.id() + ",";
-    line += escapedTitle + ",";
-    line += escapedDesc + ",";
-    line += QString(task.isCompleted() ? "1" : "0") + ",";
-    line += task.createdDate().toString(Qt::ISODate) + ",";
-    line += (task.dueDate().isValid() ? task.dueDate().toString(Qt::ISODate) : "") + ",";
-    line += task.categoryId() + ",";
-    line += QString::number(task.priority());
+    if (read < 0 || device.hasError()) {
+        qWarning() << "Could not decompress file:" << filePath << device.errorString();
+        return false;
+    }
 
-    return line;
+    // Closing keeps the file until the QTemporaryFile is destroyed
+    temporary.close();
+    *path = temporary.fileName();
+    return true;
 }
 
 /**
- * @brief Convert a CSV line to a task
+ * @brief Convert CSV fields to a task
  * 
- * Helper method that deserializes a Task object from a CSV line string.
- * Handles quoted fields and proper parsing of dates.
+ * Helper method that deserializes a Task object from the fields of a CSV row.
+ * Only the text fields are decoded into QStrings.
  * 
- * @param line The CSV line to parse
+ * @param fields The fields of the row
  * @param ok Optional pointer to boolean that will be set to true if parsing was successful
  * @return Task The parsed Task object
  */
-Task ImportExportService::taskFromCsvLine(const QString& line, bool* ok)
+Task ImportExportService::taskFromCsvFields(const QVector<CsvReader::Field>& fields, bool* ok)
 {
     Task task;
 
     if (ok) *ok = false;
 
-    // Parse CSV line with proper handling of quoted fields
-    QStringList fields;
-    bool inQuotes = false;
-    QString field;
-
-    // Custom CSV parser to handle quoted fields correctly
-    for (int i = 0; i < line.length(); ++i) {
-        QChar c = line.at(i);
-
-        if (c == '\"') {
-            if (i + 1 < line.length() && line.at(i + 1) == '\"') {
-                // Handle escaped quote (two consecutive quotes)
-                field += '\"';
-                ++i; // Skip the next quote
-            } else {
-                // Toggle quote mode
-                inQuotes = !inQuotes;
-            }
-        } else if (c == ',' && !inQuotes) {
-            // End of field (comma outside quotes)
-            fields.append(field);
-            field.clear();
-        } else {
-            // Normal character
-            field += c;
-        }
-    }
-
-    // Add the last field
-    fields.append(field);
-
     // Validate field count
     if (fields.size() != 8) {
         qWarning() << "Invalid CSV line format, expected 8 fields but got" << fields.size();
@@ -345,17 +1899,17 @@ Task ImportExportService::taskFromCsvLine(const QString& line, bool* ok)
     }
 
     // Parse fields into a Task object
-    task.setId(fields[0]);
-    task.setTitle(fields[1]);
-    task.setDescription(fields[2]);
+    task.setId(fields[0].toString());
+    task.setTitle(fields[1].toString());
+    task.setDescription(fields[2].toString());
     task.setCompleted(fields[3] == "1");
-    task.setCreatedDate(QDateTime::fromString(fields[4], Qt::ISODate));
+    task.setCreatedDate(QDateTime::fromString(fields[4].toString(), Qt::ISODate));
 
     if (!fields[5].isEmpty()) {
-        task.setDueDate(QDateTime::fromString(fields[5], Qt::ISODate));
+        task.setDueDate(QDateTime::fromString(fields[5].toString(), Qt::ISODate));
     }
 
-    task.setCategoryId(fields[6]);
+    task.setCategoryId(fields[6].toString());
     task.setPriority(fields[7].toInt());
 
     if (ok) *ok = true;
@@ -14,17 +14,41 @@
 #include <QObject>
 #include <QString>
 #include <QList>
+#include <QHash>
+#include <QDate>
+#include <QDateTime>
+#include <QJsonObject>
+#include <QSet>
+#include <QPair>
+#include <QTemporaryFile>
+#include <functional>
 #include "../models/task.h"
 #include "../models/category.h"
+#include "../models/project.h"
+#include "../models/timeentry.h"
+#include "csvreader.h"
+
+class DatabaseManager;
+class QFileDevice;
+class ICalendarWriter;
 
 /**
  * @class ImportExportService
  * @brief Service for importing and exporting application data
  * 
  * The ImportExportService class provides methods for importing and exporting
- * tasks and categories in various formats (JSON, CSV). This allows users to
- * backup their data, transfer it between devices, or integrate with other
- * applications.
+ * tasks, categories, projects and time entries in various formats (JSON,
+ * JSON Lines, CSV, binary snapshots). This allows users to backup their data, transfer it
+ * between devices, or integrate with other applications.
+ * 
+ * Exports are written incrementally and imports are read incrementally, so
+ * large files do not need to fit in memory. Exports to paths ending in ".gz"
+ * (or ".zz" for zlib) are compressed while they are written, and every import
+ * detects and inflates gzip or zlib input on its own.
+ * 
+ * Operations can run on any thread; ImportExportJob runs them in the
+ * background with progress reports and cancellation, and summary() counts the
+ * records inserted, updated, skipped and exported.
  */
 class ImportExportService : public QObject {
     Q_OBJECT
@@ -39,6 +63,93 @@ public:
      */
     explicit ImportExportService(QObject* parent = nullptr);
 
+    /**
+     * @struct Summary
+     * @brief Records handled by the operations of this service
+     * 
+     * Counts accumulate over all calls on the same service instance.
+     */
+    struct Summary {
+        int inserted = 0;        ///< New records written to the database
+        int updated = 0;         ///< Existing records replaced in the database
+        int skipped = 0;         ///< Records read but not written, e.g. invalid rows
+        int exported = 0;        ///< Records written to export files
+        bool cancelled = false;  ///< True if the progress handler cancelled an operation
+        
+        /**
+         * @brief Get the number of records written to the database
+         * @return int Inserted plus updated records
+         */
+        int written() const { return inserted + updated; }
+    };
+
+    /**
+     * @struct TimeEntryCsvMapping
+     * @brief Column mapping for time entries exported by other time trackers
+     * 
+     * Columns are found by their header name, ignoring case and surrounding
+     * spaces. The start column and either the end or the duration column must
+     * be present; the others are optional.
+     */
+    struct TimeEntryCsvMapping {
+        /**
+         * @enum DurationUnit
+         * @brief Unit of durations written as plain numbers
+         * 
+         * Durations written as h:mm or h:mm:ss are always understood.
+         */
+        enum DurationUnit {
+            Seconds,
+            Minutes,
+            Hours
+        };
+        
+        QString startColumn = "start";        ///< Header of the start time column
+        QString endColumn = "end";            ///< Header of the end time column
+        QString durationColumn = "duration";  ///< Header of the duration column
+        QString projectColumn = "project";    ///< Header of the project name column
+        QString notesColumn = "notes";        ///< Header of the notes column
+        QString dateTimeFormat;               ///< QDateTime format of the times, ISO 8601 if empty
+        DurationUnit durationUnit = Seconds;  ///< Unit of plain number durations
+        QString defaultProject = "Imported";  ///< Project of rows without a project name
+    };
+
+    /**
+     * @enum MergePolicy
+     * @brief How merge imports resolve records whose ID already exists with different content
+     */
+    enum MergePolicy {
+        SkipConflicts,  ///< Keep the existing record
+        Overwrite,      ///< Replace the existing record with the imported one
+        KeepNewest,     ///< Keep whichever record was modified last; the existing one on ties
+        KeepBoth        ///< Keep the existing record and insert the imported one under a new ID
+    };
+
+    /**
+     * @brief Handler receiving progress reports
+     * 
+     * Called with the bytes processed, the total bytes (0 if unknown) and the
+     * records handled so far, after every database batch or every
+     * IMPORT_BATCH_SIZE exported records. Returning false cancels the running
+     * operation, which then returns false; batches already committed stay.
+     */
+    typedef std::function<bool(qint64 bytesDone, qint64 bytesTotal, int records)> ProgressHandler;
+
+    /**
+     * @brief Set the handler receiving progress reports
+     * 
+     * The handler is called on the thread running the operation.
+     * 
+     * @param handler The handler, or an empty function to stop reporting
+     */
+    void setProgressHandler(const ProgressHandler& handler);
+
+    /**
+     * @brief Get the records handled so far
+     * @return const Summary& The accumulated counts
+     */
+    const Summary& summary() const { return m_summary; }
+
     // Export functions
     /**
      * @brief Export tasks to a JSON file
@@ -72,6 +183,73 @@ public:
      * @return bool True if export was successful, false otherwise
      */
     bool exportCategoriesToJson(const QString& filePath, const QList<Category>& categories);
+    
+    /**
+     * @brief Export projects to a JSON file
+     * 
+     * Serializes a list of projects to JSON format and saves it to a file.
+     * 
+     * @param filePath Path to the output file
+     * @param projects List of projects to export
+     * @return bool True if export was successful, false otherwise
+     */
+    bool exportProjectsToJson(const QString& filePath, const QList<Project>& projects);
+    
+    /**
+     * @brief Export all time entries to a JSON file
+     * 
+     * Streams every time entry from the database to the file. Entries carry
+     * their project name next to the project ID.
+     * 
+     * @param filePath Path to the output file
+     * @param projectNames Map of project IDs to project names
+     * @return bool True if export was successful, false otherwise
+     */
+    bool exportTimeEntriesToJson(const QString& filePath, const QHash<QString, QString>& projectNames);
+    
+    /**
+     * @brief Export raw time entries to a CSV file
+     * 
+     * Streams every time entry overlapping the date range from the database
+     * to the file, without loading the entries into memory first.
+     * 
+     * @param filePath Path to the output file
+     * @param startDate First day of the range
+     * @param endDate Last day of the range (inclusive)
+     * @param projectNames Map of project IDs to project names
+     * @return bool True if export was successful, false otherwise
+     */
+    bool exportTimeEntriesToCsv(const QString& filePath, const QDate& startDate, const QDate& endDate,
+                                const QHash<QString, QString>& projectNames);
+    
+    /**
+     * @brief Export tasks to a JSON Lines file
+     * 
+     * Writes one task object per line.
+     * 
+     * @param filePath Path to the output file
+     * @param tasks List of tasks to export
+     * @param append True to append to an existing file instead of replacing it
+     * @return bool True if export was successful, false otherwise
+     */
+    bool exportTasksToJsonLines(const QString& filePath, const QList<Task>& tasks, bool append = false);
+    
+    /**
+     * @brief Export time entries to a JSON Lines file
+     * 
+     * Streams time entries from the database, one object per line. With a
+     * valid modifiedSince only the entries inserted or changed since then are
+     * written, so periodic exports can be appended to the same file; on import
+     * later lines replace earlier ones with the same ID.
+     * 
+     * @param filePath Path to the output file
+     * @param projectNames Map of project IDs to project names
+     * @param modifiedSince Only export entries modified at or after this time; all entries if invalid
+     * @param append True to append to an existing file instead of replacing it
+     * @return bool True if export was successful, false otherwise
+     */
+    bool exportTimeEntriesToJsonLines(const QString& filePath, const QHash<QString, QString>& projectNames,
+                                      const QDateTime& modifiedSince = QDateTime(), bool append = false);
 
     // Import functions
     /**
@@ -106,26 +284,569 @@ public:
      * @return QList<Category> List of imported categories
      */
     QList<Category> importCategoriesFromJson(const QString& filePath, bool* ok = nullptr);
+    
+    /**
+     * @brief Import projects from a JSON file
+     * 
+     * Reads a JSON file and deserializes it into a list of projects.
+     * 
+     * @param filePath Path to the input file
+     * @param ok Optional pointer to a bool that will be set to true if import was successful
+     * @return QList<Project> List of imported projects
+     */
+    QList<Project> importProjectsFromJson(const QString& filePath, bool* ok = nullptr);
+    
+    /**
+     * @brief Import time entries from a JSON file
+     * 
+     * Reads a JSON file and deserializes it into a list of time entries.
+     * 
+     * @param filePath Path to the input file
+     * @param ok Optional pointer to a bool that will be set to true if import was successful
+     * @return QList<TimeEntry> List of imported time entries
+     */
+    QList<TimeEntry> importTimeEntriesFromJson(const QString& filePath, bool* ok = nullptr);
+    
+    /**
+     * @brief Import projects from a JSON file straight into the database
+     * 
+     * Streams the file and writes the projects in batches. Existing projects
+     * with the same ID are replaced.
+     * 
+     * @param filePath Path to the input file
+     * @param importedCount Optional pointer receiving the number of projects written
+     * @return bool True if the whole file was imported, false otherwise
+     */
+    bool importProjectsFromJsonToDatabase(const QString& filePath, int* importedCount = nullptr);
+    
+    /**
+     * @brief Import time entries from a JSON file straight into the database
+     * 
+     * Streams the file and writes the entries in batches. Each entry's project
+     * is resolved by ID, or by project name when the ID is unknown; entries
+     * whose project cannot be resolved are skipped.
+     * 
+     * @param filePath Path to the input file
+     * @param importedCount Optional pointer receiving the number of entries written
+     * @param skippedCount Optional pointer receiving the number of entries without a known project
+     * @return bool True if the whole file was imported, false otherwise
+     */
+    bool importTimeEntriesFromJsonToDatabase(const QString& filePath, int* importedCount = nullptr,
+                                             int* skippedCount = nullptr);
+    
+    /**
+     * @brief Import tasks from a JSON file straight into the database
+     * 
+     * Streams the file one task at a time and writes them in batches, so memory
+     * use does not grow with the size of the file. Existing tasks with the same
+     * ID are replaced.
+     * 
+     * @param filePath Path to the input file
+     * @param importedCount Optional pointer receiving the number of tasks written
+     * @return bool True if the whole file was imported, false otherwise
+     */
+    bool importTasksFromJsonToDatabase(const QString& filePath, int* importedCount = nullptr);
+    
+    /**
+     * @brief Import categories from a JSON file straight into the database
+     * 
+     * Streams the file one category at a time and writes them in batches.
+     * Existing categories with the same ID are replaced.
+     * 
+     * @param filePath Path to the input file
+     * @param importedCount Optional pointer receiving the number of categories written
+     * @return bool True if the whole file was imported, false otherwise
+     */
+    bool importCategoriesFromJsonToDatabase(const QString& filePath, int* importedCount = nullptr);
+    
+    /**
+     * @brief Import tasks from a CSV file straight into the database
+     * 
+     * Parses the file in parallel and writes the tasks in batches, in file
+     * order. Existing tasks with the same ID are replaced.
+     * 
+     * @param filePath Path to the input file
+     * @param importedCount Optional pointer receiving the number of tasks written
+     * @return bool True if the whole file was imported, false otherwise
+     */
+    bool importTasksFromCsvToDatabase(const QString& filePath, int* importedCount = nullptr);
+    
+    /**
+     * @brief Import tasks from a JSON Lines file straight into the database
+     * 
+     * Parses the lines in parallel and writes the tasks in batches, in file
+     * order. Existing tasks with the same ID are replaced.
+     * 
+     * @param filePath Path to the input file
+     * @param importedCount Optional pointer receiving the number of tasks written
+     * @return bool True if the whole file was imported, false otherwise
+     */
+    bool importTasksFromJsonLinesToDatabase(const QString& filePath, int* importedCount = nullptr);
+    
+    /**
+     * @brief Import time entries from a JSON Lines file straight into the database
+     * 
+     * Parses the lines in parallel and writes the entries in batches, in file
+     * order. Projects are resolved as for JSON imports; entries whose project
+     * cannot be resolved are skipped.
+     * 
+     * @param filePath Path to the input file
+     * @param importedCount Optional pointer receiving the number of entries written
+     * @param skippedCount Optional pointer receiving the number of entries without a known project
+     * @return bool True if the whole file was imported, false otherwise
+     */
+    bool importTimeEntriesFromJsonLinesToDatabase(const QString& filePath, int* importedCount = nullptr,
+                                                  int* skippedCount = nullptr);
+    
+    /**
+     * @brief Import time entries exported by another time tracker
+     * 
+     * Parses the CSV file in parallel using the column mapping and writes the
+     * entries in batches under new IDs. Projects are matched by name and
+     * created when no project of that name exists. Rows without a valid start
+     * time, or with neither an end time nor a duration, are skipped.
+     * 
+     * @param filePath Path to the input file
+     * @param mapping Which columns hold which fields
+     * @return bool True if the whole file was imported, false otherwise
+     */
+    bool importTimeEntriesFromExternalCsv(const QString& filePath, const TimeEntryCsvMapping& mapping);
+    
+    // Calendar feed
+    /**
+     * @brief Export due tasks and finished time entries as an iCalendar feed
+     * 
+     * Writes a VTODO for every task with a due date and a VEVENT for every
+     * finished time entry. A content hash per item is kept in an index file
+     * next to the feed ("<filePath>.index"). When no item was added, changed
+     * or removed since the last export, the feed is left untouched; otherwise
+     * it is rewritten atomically, and changed items get a new DTSTAMP and a
+     * higher SEQUENCE so calendar apps pick up the change.
+     * 
+     * @param filePath Path to the output file
+     * @param tasks Tasks to export; tasks without a due date are left out
+     * @param projectNames Map of project IDs to project names
+     * @param rewritten Optional pointer set to true if the feed was written, false if it was up to date
+     * @return bool True if the feed is up to date, false otherwise
+     */
+    bool exportCalendar(const QString& filePath, const QList<Task>& tasks,
+                        const QHash<QString, QString>& projectNames, bool* rewritten = nullptr);
+    
+    // Merge imports
+    /**
+     * @brief Merge tasks from a JSON file into the database
+     * 
+     * Records are matched by ID. Records identical to an existing task, by ID
+     * or by content, are skipped; records whose ID exists with different
+     * content are resolved by the policy. Tasks carry no modification time,
+     * so KeepNewest is refused. All changes are written in a
+     * single transaction once the whole file was read, so a failed or
+     * cancelled merge leaves the database unchanged.
+     * 
+     * @param filePath Path to the input file
+     * @param policy How to resolve conflicting records
+     * @return bool True if the whole file was merged, false otherwise
+     */
+    bool mergeTasksFromJson(const QString& filePath, MergePolicy policy);
+    
+    /**
+     * @brief Merge time entries from a JSON file into the database
+     * 
+     * As mergeTasksFromJson(), with projects resolved as for JSON imports
+     * before the entries are compared. KeepNewest compares the modification
+     * times exported with the entries; entries from exports without them
+     * count as older than the existing ones.
+     * 
+     * @param filePath Path to the input file
+     * @param policy How to resolve conflicting records
+     * @return bool True if the whole file was merged, false otherwise
+     */
+    bool mergeTimeEntriesFromJson(const QString& filePath, MergePolicy policy);
+    
+    // Full backup
+    /**
+     * @brief Export a binary snapshot of the whole database
+     * 
+     * Writes categories, projects, tasks and time entries in the compact CBOR
+     * snapshot format (see CborSnapshot).
+     * 
+     * @param filePath Path to the output file
+     * @return bool True if export was successful, false otherwise
+     */
+    bool exportSnapshot(const QString& filePath);
+    
+    /**
+     * @brief Restore a binary snapshot into the database
+     * 
+     * Records are inserted or replaced by ID. Controllers must reload their
+     * data afterwards.
+     * 
+     * @param filePath Path to the input file
+     * @param importedCount Optional pointer receiving the number of records restored
+     * @return bool True if the whole snapshot was restored, false otherwise
+     */
+    bool importSnapshot(const QString& filePath, int* importedCount = nullptr);
 
 private:
     /**
-     * @brief Convert a task to a CSV line
+     * @brief Report progress to the handler
+     * @return bool False if the handler cancelled the operation
+     */
+    bool reportProgress();
+    
+    /**
+     * @brief Count an exported record and report progress periodically
+     * @param file The file being written
+     * @return bool False if the operation was cancelled
+     */
+    bool recordExported(const QFileDevice& file);
+    
+    /**
+     * @brief Writes one record of an export; returns false to stop the export
+     */
+    typedef std::function<bool(const QJsonObject&)> JsonRecordWriter;
+    
+    /**
+     * @brief Write an export file
      * 
-     * Helper method that serializes a single task to a CSV-formatted string.
+     * Opens and closes the file and its compression, and checks for errors
+     * and cancellation, around a writer that emits the records.
      * 
-     * @param task The task to convert
-     * @return QString CSV-formatted representation of the task
+     * @param filePath Path to the output file
+     * @param append True to append to an existing file instead of replacing it
+     * @param write Writes the records to the device, calling recorded() after each
+     * @return bool True if export was successful, false otherwise
      */
-    QString taskToCsvLine(const Task& task);
+    bool writeExportFile(const QString& filePath, bool append,
+                         const std::function<bool(QIODevice* device, const std::function<bool()>& recorded)>& write);
     
     /**
-     * @brief Create a task from a CSV line
+     * @brief Write an export file of JSON objects
      * 
-     * Helper method that deserializes a single task from a CSV-formatted string.
+     * @param filePath Path to the output file
+     * @param jsonLines True for JSON Lines, false for a JSON array
+     * @param append True to append to an existing file instead of replacing it
+     * @param forEachRecord Passes every record to the record writer
+     * @return bool True if export was successful, false otherwise
+     */
+    bool writeJsonExport(const QString& filePath, bool jsonLines, bool append,
+                         const std::function<bool(const JsonRecordWriter& write)>& forEachRecord);
+    
+    /**
+     * @brief Write a batch in one transaction and account for it
      * 
-     * @param line CSV-formatted string representing a task
+     * @param batch The records to write; cleared once written
+     * @param upsert The DatabaseManager method writing the batch
+     * @return bool False if the write failed or the operation was cancelled
+     */
+    template <typename T>
+    bool writeBatch(QList<T>& batch, bool (DatabaseManager::*upsert)(const QList<T>&, int*));
+    
+    /**
+     * @struct MergeIndex
+     * @brief Existing and accepted records of a merge import
+     */
+    struct MergeIndex {
+        QHash<QString, QPair<quint64, QDateTime>> records; ///< Content hash and modification time by ID
+        QHash<quint64, int> hashes;                        ///< Number of records by content hash
+        QHash<QString, int> pending;                       ///< Index in the write list by ID
+        int inserted = 0;                                  ///< Records to insert
+        int updated = 0;                                   ///< Records to replace
+        int skipped = 0;                                   ///< Identical or rejected records
+        
+        /**
+         * @brief Add a record known to the database
+         * 
+         * A record replacing one with the same ID releases the old content hash.
+         * 
+         * @param id ID of the record
+         * @param hash Content hash of the record
+         * @param modified Modification time of the record
+         */
+        void add(const QString& id, quint64 hash, const QDateTime& modified);
+    };
+    
+    /**
+     * @brief Classify an imported record of a merge import
+     * 
+     * @param record The imported record
+     * @param modified Modification time of the imported record
+     * @param policy How to resolve a conflicting record
+     * @param index Existing and accepted records, updated with the decision
+     * @param writes Records to write, updated with the decision
+     */
+    template <typename T>
+    static void mergeRecord(T record, const QDateTime& modified, MergePolicy policy,
+                            MergeIndex& index, QList<T>& writes);
+    
+    /**
+     * @brief Write the records accepted by a merge import in one transaction
+     * 
+     * @param index The accepted records
+     * @param writes The records to write
+     * @param upsert The DatabaseManager method writing the records
+     * @return bool True if the records were written, false otherwise
+     */
+    template <typename T>
+    bool commitMerge(const MergeIndex& index, const QList<T>& writes,
+                     bool (DatabaseManager::*upsert)(const QList<T>&, int*));
+    
+    /**
+     * @struct CsvChunk
+     * @brief Records parsed from one range of a CSV file
+     */
+    template <typename T>
+    struct CsvChunk {
+        QList<T> records;     ///< Records of the range, in file order
+        int skipped = 0;      ///< Invalid rows left out
+        QString error;        ///< Parse error, empty if the range was parsed completely
+    };
+    
+    /**
+     * @brief Parser of one CSV row
+     * 
+     * Fills the record from the fields of the row and returns false for an
+     * invalid row, which is skipped. Called concurrently from worker threads.
+     */
+    template <typename T>
+    using CsvRowParser = std::function<bool(const QVector<CsvReader::Field>& fields, T& record)>;
+    
+    /**
+     * @brief Parse the records of a CSV file in parallel
+     * 
+     * The header row is read first and handed to parserForHeader, which
+     * returns the row parser or an empty function if the header does not fit.
+     * The rest of the file is split into ranges of whole records which are
+     * parsed on the global thread pool. Chunks are handed to the sink in file
+     * order as soon as all earlier chunks were handled.
+     * 
+     * @param filePath Path to the input file
+     * @param parserForHeader Chooses the row parser for the header row
+     * @param sink Called with the records of each chunk; returning false aborts the import
+     * @return bool True if the whole file was parsed and handled, false otherwise
+     */
+    template <typename T>
+    bool readCsv(const QString& filePath,
+                 const std::function<CsvRowParser<T>(const QVector<CsvReader::Field>& header)>& parserForHeader,
+                 const std::function<bool(const QList<T>&)>& sink);
+    
+    /**
+     * @brief Parse the records of one range of a CSV file
+     * 
+     * Runs on a worker thread.
+     * 
+     * @param reader The reader holding the mapped file
+     * @param range The range to parse
+     * @param parseRow The row parser
+     * @return CsvChunk The parsed records and any parse error
+     */
+    template <typename T>
+    static CsvChunk<T> parseCsvChunk(const CsvReader& reader, CsvReader::Range range, const CsvRowParser<T>& parseRow);
+    
+    /**
+     * @brief Parse the tasks of a CSV file in parallel
+     * 
+     * @param filePath Path to the input file
+     * @param sink Called with the tasks of each chunk; returning false aborts the import
+     * @return bool True if the whole file was parsed and handled, false otherwise
+     */
+    bool readTasksFromCsv(const QString& filePath, const std::function<bool(const QList<Task>&)>& sink);
+    
+    /**
+     * @struct CsvTimeEntry
+     * @brief Time entry parsed from an external CSV export
+     */
+    struct CsvTimeEntry {
+        TimeEntry entry;      ///< The entry, without a project ID
+        QString projectName;  ///< Project named by the row, empty if none
+    };
+    
+    /**
+     * @struct TimeEntryCsvColumns
+     * @brief Positions of the mapped columns in a CSV header, -1 if absent
+     */
+    struct TimeEntryCsvColumns {
+        int start = -1;       ///< Start time column
+        int end = -1;         ///< End time column
+        int duration = -1;    ///< Duration column
+        int project = -1;     ///< Project name column
+        int notes = -1;       ///< Notes column
+    };
+    
+    /**
+     * @brief Create a time entry from the fields of an external CSV row
+     * 
+     * @param fields The fields of the row
+     * @param columns Positions of the mapped columns
+     * @param mapping The column mapping
+     * @param record Receives the entry and its project name
+     * @return bool True if the row holds a valid, finished entry
+     */
+    static bool timeEntryFromCsvFields(const QVector<CsvReader::Field>& fields, const TimeEntryCsvColumns& columns,
+                                       const TimeEntryCsvMapping& mapping, CsvTimeEntry& record);
+    
+    /**
+     * @brief Parse a duration field
+     * @param text The field
+     * @param unit Unit of plain numbers
+     * @return int The duration in seconds, -1 if the field is empty or invalid
+     */
+    static int parseDuration(const QString& text, TimeEntryCsvMapping::DurationUnit unit);
+    
+    static const qint64 PARALLEL_PARSE_THRESHOLD = 1024 * 1024; ///< Bytes below which files are parsed in one chunk
+    
+    /**
+     * @struct JsonLinesChunk
+     * @brief Objects parsed from one range of a JSON Lines file
+     */
+    struct JsonLinesChunk {
+        QList<QJsonObject> objects; ///< Objects of the range, in file order
+        QString error;              ///< Parse error, empty if the range was parsed completely
+    };
+    
+    /**
+     * @brief Parse the objects of a JSON Lines file in parallel
+     * 
+     * The file is split at line breaks into ranges which are parsed on the
+     * global thread pool. Chunks are handed to the sink in file order.
+     * 
+     * @param filePath Path to the input file
+     * @param sink Called with the objects of each chunk; returning false aborts the import
+     * @return bool True if the whole file was parsed and handled, false otherwise
+     */
+    bool readJsonLines(const QString& filePath, const std::function<bool(const QList<QJsonObject>&)>& sink);
+    
+    /**
+     * @brief Parse the lines of one range of a JSON Lines file
+     * 
+     * Runs on a worker thread.
+     * 
+     * @param data Start of the range
+     * @param size Length of the range in bytes
+     * @param offset Offset of the range in the file, for error messages
+     * @return JsonLinesChunk The parsed objects and any parse error
+     */
+    static JsonLinesChunk parseJsonLines(const char* data, qint64 size, qint64 offset);
+    
+    /**
+     * @struct ProjectLookup
+     * @brief Resolves the projects of imported time entries
+     * 
+     * Entries keep their project ID if it exists in the database, otherwise
+     * they are matched by the exported project name.
+     */
+    struct ProjectLookup {
+        QSet<QString> ids;                  ///< IDs of the existing projects
+        QHash<QString, QString> idsByName;  ///< Existing project IDs by project name
+        
+        /**
+         * @brief Build the lookup from the projects in the database
+         * @return ProjectLookup The lookup
+         */
+        static ProjectLookup fromDatabase();
+        
+        /**
+         * @brief Point an entry at an existing project
+         * @param entry The entry to resolve
+         * @param projectName The project name exported with the entry
+         * @return bool True if the entry's project exists
+         */
+        bool resolve(TimeEntry& entry, const QString& projectName) const;
+    };
+    
+    /**
+     * @brief Serialize a time entry with its project name
+     * 
+     * @param entry The entry to serialize
+     * @param projectNames Map of project IDs to project names
+     * @return QJsonObject The entry object
+     */
+    static QJsonObject timeEntryToJson(const TimeEntry& entry, const QHash<QString, QString>& projectNames);
+
+    /**
+     * @struct CalendarItemState
+     * @brief State of one calendar feed item as of the last export
+     */
+    struct CalendarItemState {
+        quint64 hash = 0;       ///< Content hash of the item
+        quint32 sequence = 0;   ///< SEQUENCE, incremented on every change
+        QDateTime stamp;        ///< DTSTAMP, the export that saw the last change
+    };
+    
+    typedef QHash<QString, CalendarItemState> CalendarIndex; ///< Item states by UID
+    
+    /**
+     * @brief Load the item states of a calendar feed
+     * @param indexPath Path to the index file
+     * @return CalendarIndex The item states, empty if the index is missing or invalid
+     */
+    static CalendarIndex loadCalendarIndex(const QString& indexPath);
+    
+    /**
+     * @brief Save the item states of a calendar feed
+     * @param indexPath Path to the index file
+     * @param index The item states
+     * @return bool True if the index was saved, false otherwise
+     */
+    static bool saveCalendarIndex(const QString& indexPath, const CalendarIndex& index);
+    
+    /**
+     * @brief Write the VTODO of a task
+     * @param calendar The calendar writer
+     * @param uid UID of the item
+     * @param task The task
+     * @param state State of the item
+     */
+    static void writeCalendarTask(ICalendarWriter& calendar, const QString& uid, const Task& task,
+                                  const CalendarItemState& state);
+    
+    /**
+     * @brief Write the VEVENT of a time entry
+     * @param calendar The calendar writer
+     * @param uid UID of the item
+     * @param entry The time entry
+     * @param projectName Name of the entry's project
+     * @param state State of the item
+     */
+    static void writeCalendarEntry(ICalendarWriter& calendar, const QString& uid, const TimeEntry& entry,
+                                   const QString& projectName, const CalendarItemState& state);
+    
+    static const quint32 CALENDAR_INDEX_MAGIC = 0x54574349; ///< "TWCI", marks calendar index files
+    
+    /**
+     * @brief Stream the objects of a JSON array file
+     * 
+     * @param filePath Path to the input file
+     * @param handler Called for each object; returning false aborts the import
+     * @return bool True if the whole array was read and handled, false otherwise
+     */
+    bool readJsonArray(const QString& filePath, const std::function<bool(const QJsonObject&)>& handler);
+    
+    /**
+     * @brief Get a path to the uncompressed contents of a file
+     * 
+     * @param filePath Path to the input file
+     * @param temporary Temporary file receiving the inflated contents of compressed files
+     * @param path Receives filePath for plain files, the temporary file's path otherwise
+     * @return bool True if path can be read, false otherwise
+     */
+    static bool uncompressedPath(const QString& filePath, QTemporaryFile& temporary, QString* path);
+    
+    static const int IMPORT_BATCH_SIZE = 500; ///< Records written per database transaction
+    
+    /**
+     * @brief Create a task from CSV fields
+     * 
+     * Helper method that deserializes a single task from the fields of a CSV row.
+     * 
+     * @param fields The fields of the row
      * @param ok Optional pointer to a bool that will be set to true if parsing was successful
      * @return Task The parsed task
      */
-    Task taskFromCsvLine(const QString& line, bool* ok = nullptr);
+    static Task taskFromCsvFields(const QVector<CsvReader::Field>& fields, bool* ok = nullptr);
+    
+    ProgressHandler m_progressHandler; ///< Receives progress reports, may be empty
+    Summary m_summary;                 ///< Records handled so far
+    qint64 m_bytesDone;                ///< Bytes of the current file processed
+    qint64 m_bytesTotal;               ///< Size of the current file, 0 if unknown
 };
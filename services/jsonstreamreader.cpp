@@ -0,0 +1,205 @@
+/**
+ * @file jsonstreamreader.cpp
+ * @brief Implementation of the JsonStreamReader class
+ * 
+ * The JsonStreamReader splits a JSON array into its elements while reading the
+ * input in chunks, and parses each element on its own.
+ * 
+ * @author Cornebidouil
+ * @date Last updated: April 30, 2025
+ */
+
+#include "jsonstreamreader.h"
+#include <QJsonDocument>
+#include <QJsonParseError>
+
+/**
+ * @brief Constructor
+ * 
+ * @param device The device to read from, opened for reading
+ */
+JsonStreamReader::JsonStreamReader(QIODevice* device)
+    : m_device(device)
+    , m_pos(0)
+    , m_finished(false)
+    , m_offset(0)
+{
+}
+
+/**
+ * @brief Make sure unread input is available
+ * 
+ * Reads the next chunk from the device once the current one is consumed.
+ * 
+ * @return bool True if at least one unread byte is available
+ */
+bool JsonStreamReader::ensureData()
+{
+    if (m_pos < m_chunk.size()) {
+        return true;
+    }
+    
+    m_offset += m_chunk.size();
+    m_chunk = m_device->read(CHUNK_SIZE);
+    m_pos = 0;
+    
+    return !m_chunk.isEmpty();
+}
+
+/**
+ * @brief Skip whitespace and return the next significant byte
+ * 
+ * The byte is not consumed.
+ * 
+ * @param c Receives the byte
+ * @return bool True if a byte is available
+ */
+bool JsonStreamReader::peekSignificant(char& c)
+{
+    while (ensureData()) {
+        c = m_chunk.at(m_pos);
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+            return true;
+        }
+        ++m_pos;
+    }
+    
+    return false;
+}
+
+/**
+ * @brief Record an error and stop reading
+ * 
+ * @param message The error description
+ */
+void JsonStreamReader::setError(const QString& message)
+{
+    if (m_error.isEmpty()) {
+        m_error = message;
+    }
+    m_finished = true;
+}
+
+/**
+ * @brief Read the opening bracket of the top-level array
+ * 
+ * A UTF-8 byte order mark before the array is skipped.
+ * 
+ * @return bool True if the input starts with an array
+ */
+bool JsonStreamReader::readArrayStart()
+{
+    if (ensureData() && m_chunk.startsWith("\xEF\xBB\xBF")) {
+        m_pos += 3;
+    }
+    
+    char c;
+    if (!peekSignificant(c) || c != '[') {
+        setError("Expected a JSON array");
+        return false;
+    }
+    
+    ++m_pos;
+    return true;
+}
+
+/**
+ * @brief Read the next element of the array
+ * 
+ * Scans forward to the end of the element, tracking strings, escapes and
+ * nesting depth, copying the element bytes a chunk segment at a time. The
+ * element is then parsed and the following separator consumed.
+ * 
+ * @param object Receives the element
+ * @return bool True if an element was read, false at the end of the array or on error
+ */
+bool JsonStreamReader::readNextObject(QJsonObject& object)
+{
+    if (m_finished) {
+        return false;
+    }
+    
+    char c;
+    if (!peekSignificant(c)) {
+        setError("Unexpected end of input");
+        return false;
+    }
+    
+    if (c == ']') {
+        ++m_pos;
+        m_finished = true;
+        return false;
+    }
+    
+    if (c != '{') {
+        setError(QString("Expected an object at offset %1").arg(m_offset + m_pos));
+        return false;
+    }
+    
+    m_element.resize(0);
+    int depth = 0;
+    bool inString = false;
+    bool escaped = false;
+    bool complete = false;
+    
+    while (!complete && ensureData()) {
+        int segmentStart = m_pos;
+        const char* data = m_chunk.constData();
+        int size = m_chunk.size();
+        
+        for (; m_pos < size; ++m_pos) {
+            char ch = data[m_pos];
+            
+            if (inString) {
+                if (escaped) {
+                    escaped = false;
+                } else if (ch == '\\') {
+                    escaped = true;
+                } else if (ch == '"') {
+                    inString = false;
+                }
+            } else if (ch == '"') {
+                inString = true;
+            } else if (ch == '{' || ch == '[') {
+                ++depth;
+            } else if (ch == '}' || ch == ']') {
+                if (--depth == 0) {
+                    ++m_pos;
+                    complete = true;
+                    break;
+                }
+            }
+        }
+        
+        m_element.append(data + segmentStart, m_pos - segmentStart);
+    }
+    
+    if (!complete) {
+        setError("Unexpected end of input inside an array element");
+        return false;
+    }
+    
+    QJsonParseError parseError;
+    QJsonDocument document = QJsonDocument::fromJson(m_element, &parseError);
+    if (parseError.error != QJsonParseError::NoError || !document.isObject()) {
+        setError(QString("Invalid array element before offset %1: %2")
+                 .arg(m_offset + m_pos).arg(parseError.errorString()));
+        return false;
+    }
+    object = document.object();
+    
+    // Consume the separator; the closing bracket is left for the next call
+    if (!peekSignificant(c)) {
+        setError("Unexpected end of input after an array element");
+        return false;
+    }
+    
+    if (c == ',') {
+        ++m_pos;
+    } else if (c != ']') {
+        setError(QString("Expected ',' or ']' at offset %1").arg(m_offset + m_pos));
+        return false;
+    }
+    
+    return true;
+}
@@ -0,0 +1,105 @@
+/**
+ * @file jsonstreamreader.h
+ * @brief Definition of the JsonStreamReader class
+ * 
+ * This file defines the JsonStreamReader class which reads a top-level JSON
+ * array of objects from a device one element at a time.
+ * 
+ * @author Cornebidouil
+ * @date Last updated: April 30, 2025
+ */
+
+#pragma once
+
+#include <QIODevice>
+#include <QByteArray>
+#include <QJsonObject>
+#include <QString>
+
+/**
+ * @class JsonStreamReader
+ * @brief Incremental reader for JSON arrays of objects
+ * 
+ * The reader pulls the device in fixed-size chunks and tokenizes just enough
+ * of the input (strings, escapes and nesting) to find where each array element
+ * ends. Only that element is then parsed into a QJsonObject, so memory use is
+ * bounded by the largest element rather than by the size of the file.
+ * 
+ * Typical use:
+ * @code
+ * JsonStreamReader reader(&file);
+ * QJsonObject object;
+ * if (reader.readArrayStart()) {
+ *     while (reader.readNextObject(object)) {
+ *         // handle object
+ *     }
+ * }
+ * if (reader.hasError()) {
+ *     qWarning() << reader.errorString();
+ * }
+ * @endcode
+ */
+class JsonStreamReader {
+public:
+    /**
+     * @brief Constructor
+     * @param device The device to read from, opened for reading
+     */
+    explicit JsonStreamReader(QIODevice* device);
+    
+    /**
+     * @brief Read the opening bracket of the top-level array
+     * @return bool True if the input starts with an array
+     */
+    bool readArrayStart();
+    
+    /**
+     * @brief Read the next element of the array
+     * 
+     * @param object Receives the element
+     * @return bool True if an element was read, false at the end of the array or on error
+     */
+    bool readNextObject(QJsonObject& object);
+    
+    /**
+     * @brief Check if the input was malformed or unreadable
+     * @return bool True if an error occurred
+     */
+    bool hasError() const { return !m_error.isEmpty(); }
+    
+    /**
+     * @brief Get a description of the error
+     * @return QString The error description, empty if there was none
+     */
+    QString errorString() const { return m_error; }
+
+private:
+    /**
+     * @brief Make sure unread input is available
+     * @return bool True if at least one unread byte is available
+     */
+    bool ensureData();
+    
+    /**
+     * @brief Skip whitespace and return the next significant byte without consuming it
+     * @param c Receives the byte
+     * @return bool True if a byte is available
+     */
+    bool peekSignificant(char& c);
+    
+    /**
+     * @brief Record an error and stop reading
+     * @param message The error description
+     */
+    void setError(const QString& message);
+    
+    static const int CHUNK_SIZE = 64 * 1024; ///< Bytes read from the device at a time
+    
+    QIODevice* m_device;   ///< Device providing the JSON input
+    QByteArray m_chunk;    ///< Current input chunk
+    int m_pos;             ///< Read position in the current chunk
+    QByteArray m_element;  ///< Bytes of the element being read
+    bool m_finished;       ///< True once the closing bracket was read
+    qint64 m_offset;       ///< Device offset of the current chunk, for error messages
+    QString m_error;       ///< Error description, empty if no error occurred
+};
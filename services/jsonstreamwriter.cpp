@@ -0,0 +1,106 @@
+/**
+ * @file jsonstreamwriter.cpp
+ * @brief Implementation of the JsonStreamWriter class
+ * 
+ * The JsonStreamWriter serializes array elements one by one and writes them to
+ * a device in large blocks.
+ * 
+ * @author Cornebidouil
+ * @date Last updated: April 30, 2025
+ */
+
+#include "jsonstreamwriter.h"
+#include <QJsonDocument>
+#include <QDebug>
+
+/**
+ * @brief Constructor
+ * 
+ * @param device The device to write to, opened for writing
+ * @param format Layout of the written objects
+ */
+JsonStreamWriter::JsonStreamWriter(QIODevice* device, Format format)
+    : m_device(device)
+    , m_format(format)
+    , m_firstElement(true)
+    , m_error(false)
+{
+    m_buffer.reserve(BUFFER_SIZE + 1024);
+}
+
+/**
+ * @brief Destructor
+ * 
+ * Flushes any buffered data.
+ */
+JsonStreamWriter::~JsonStreamWriter()
+{
+    flush();
+}
+
+/**
+ * @brief Write the opening bracket of the array
+ */
+void JsonStreamWriter::beginArray()
+{
+    if (m_format == JsonLines) {
+        return;
+    }
+    
+    m_buffer.append('[');
+    m_firstElement = true;
+}
+
+/**
+ * @brief Write an element of the array
+ * 
+ * @param object The element
+ */
+void JsonStreamWriter::writeObject(const QJsonObject& object)
+{
+    if (m_format == JsonLines) {
+        m_buffer.append(QJsonDocument(object).toJson(QJsonDocument::Compact));
+        m_buffer.append('\n');
+    } else {
+        m_buffer.append(m_firstElement ? "\n" : ",\n");
+        m_buffer.append(QJsonDocument(object).toJson(QJsonDocument::Compact));
+    }
+    m_firstElement = false;
+    
+    if (m_buffer.size() >= BUFFER_SIZE) {
+        flush();
+    }
+}
+
+/**
+ * @brief Write the closing bracket of the array
+ */
+void JsonStreamWriter::endArray()
+{
+    if (m_format == JsonLines) {
+        return;
+    }
+    
+    m_buffer.append("\n]\n");
+}
+
+/**
+ * @brief Write buffered data to the device
+ * 
+ * @return bool True if all data written so far reached the device
+ */
+bool JsonStreamWriter::flush()
+{
+    if (m_buffer.isEmpty() || m_error) {
+        m_buffer.resize(0);
+        return !m_error;
+    }
+    
+    if (m_device->write(m_buffer) != m_buffer.size()) {
+        qWarning() << "Failed to write JSON data:" << m_device->errorString();
+        m_error = true;
+    }
+    
+    m_buffer.resize(0);
+    return !m_error;
+}
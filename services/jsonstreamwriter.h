@@ -0,0 +1,95 @@
+/**
+ * @file jsonstreamwriter.h
+ * @brief Definition of the JsonStreamWriter class
+ * 
+ * This file defines the JsonStreamWriter class which writes a JSON array of
+ * objects, or JSON Lines, to a device one element at a time.
+ * 
+ * @author Cornebidouil
+ * @date Last updated: April 30, 2025
+ */
+
+#pragma once
+
+#include <QIODevice>
+#include <QByteArray>
+#include <QJsonObject>
+
+/**
+ * @class JsonStreamWriter
+ * @brief Incremental writer for JSON arrays of objects
+ * 
+ * Each object is serialized on its own, in compact form on a line of its own,
+ * and appended to a fixed-size buffer that is written to the device whenever
+ * it fills up. Unlike building a QJsonArray, memory use does not depend on the
+ * number of elements. The output is read back by JsonStreamReader.
+ * 
+ * In JsonLines format the objects are written one per line without the
+ * enclosing array, so files can be appended to and split at any newline.
+ */
+class JsonStreamWriter {
+public:
+    /**
+     * @enum Format
+     * @brief Layout of the written objects
+     */
+    enum Format {
+        Array,      ///< A single JSON array with one element per line
+        JsonLines   ///< One JSON object per line, without enclosing array
+    };
+    
+    /**
+     * @brief Constructor
+     * @param device The device to write to, opened for writing
+     * @param format Layout of the written objects
+     */
+    explicit JsonStreamWriter(QIODevice* device, Format format = Array);
+    
+    /**
+     * @brief Destructor
+     * 
+     * Flushes any buffered data.
+     */
+    ~JsonStreamWriter();
+    
+    /**
+     * @brief Write the opening bracket of the array
+     * 
+     * Does nothing in JsonLines format.
+     */
+    void beginArray();
+    
+    /**
+     * @brief Write an element of the array
+     * @param object The element
+     */
+    void writeObject(const QJsonObject& object);
+    
+    /**
+     * @brief Write the closing bracket of the array
+     * 
+     * Does nothing in JsonLines format.
+     */
+    void endArray();
+    
+    /**
+     * @brief Write buffered data to the device
+     * @return bool True if all data written so far reached the device
+     */
+    bool flush();
+    
+    /**
+     * @brief Check if a write to the device failed
+     * @return bool True if a write failed
+     */
+    bool hasError() const { return m_error; }
+
+private:
+    static const int BUFFER_SIZE = 64 * 1024; ///< Buffered bytes before writing to the device
+    
+    QIODevice* m_device;   ///< Device receiving the JSON data
+    Format m_format;       ///< Layout of the written objects
+    QByteArray m_buffer;   ///< Serialized data not yet written
+    bool m_firstElement;   ///< True until the first element was written
+    bool m_error;          ///< True if a write to the device failed
+};
@@ -0,0 +1,511 @@
+/**
+ * @file logger.cpp
+ * @brief Implementation of the Logger class
+ * 
+ * The Logger queues messages in a bounded multi-producer ring buffer and
+ * writes them from a single background thread.
+ * 
+ * @author Cornebidouil
+ * @date Last updated: April 30, 2025
+ */
+
+#include "logger.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QLoggingCategory>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+
+#if defined(Q_OS_WIN)
+#include <io.h>
+#include <windows.h>
+#define LOGGER_DUP _dup
+#define LOGGER_WRITE(fd, data, size) _write(fd, data, unsigned(size))
+#define LOGGER_CLOSE _close
+#else
+#include <unistd.h>
+#include <time.h>
+#define LOGGER_DUP dup
+#define LOGGER_WRITE(fd, data, size) ::write(fd, data, size)
+#define LOGGER_CLOSE ::close
+#endif
+
+/**
+ * @brief Get singleton instance
+ * 
+ * @return Logger& Reference to the singleton instance
+ */
+Logger& Logger::instance()
+{
+    static Logger instance;
+    return instance;
+}
+
+/**
+ * @brief Constructor
+ * 
+ * Allocates the ring buffer and marks every slot free for its first turn.
+ */
+Logger::Logger()
+    : m_slots(new Slot[BUFFER_SIZE])
+    , m_enqueuePos(0)
+    , m_dequeuePos(0)
+    , m_dropped(0)
+    , m_writtenPos(0)
+    , m_maxFileSize(5 * 1024 * 1024)
+    , m_maxFiles(3)
+    , m_crashFd(-1)
+    , m_running(false)
+{
+    for (int i = 0; i < BUFFER_SIZE; ++i) {
+        m_slots[i].sequence.store(quint64(i), std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Destructor
+ * 
+ * Stops logging if it is still running.
+ */
+Logger::~Logger()
+{
+    shutdown();
+}
+
+/**
+ * @brief Start logging to a file
+ * 
+ * @param filePath Path to the log file; its directory is created if needed
+ * @return bool True if the file was opened, false otherwise
+ */
+bool Logger::install(const QString& filePath)
+{
+    if (m_thread.joinable()) {
+        return true;
+    }
+
+    QDir().mkpath(QFileInfo(filePath).absolutePath());
+
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+        fprintf(stderr, "Warning: Could not open log file for writing\n");
+        return false;
+    }
+    updateCrashFd();
+
+    m_running = true;
+    m_thread = std::thread(&Logger::run, this);
+
+    qInstallMessageHandler(messageHandler);
+    std::signal(SIGSEGV, crashHandler);
+    std::signal(SIGABRT, crashHandler);
+    std::signal(SIGFPE, crashHandler);
+    std::signal(SIGILL, crashHandler);
+
+    return true;
+}
+
+/**
+ * @brief Stop logging
+ * 
+ * Safe to call more than once.
+ */
+void Logger::shutdown()
+{
+    if (!m_thread.joinable()) {
+        return;
+    }
+
+    qInstallMessageHandler(nullptr);
+    std::signal(SIGSEGV, SIG_DFL);
+    std::signal(SIGABRT, SIG_DFL);
+    std::signal(SIGFPE, SIG_DFL);
+    std::signal(SIGILL, SIG_DFL);
+
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_running = false;
+    }
+    m_wakeCondition.notify_one();
+    m_thread.join();
+
+    std::lock_guard<std::mutex> lock(m_fileMutex);
+    drain();
+    m_file.close();
+    updateCrashFd();
+}
+
+/**
+ * @brief Write all queued messages
+ */
+void Logger::flush()
+{
+    std::lock_guard<std::mutex> lock(m_fileMutex);
+    drain();
+}
+
+/**
+ * @brief Set the minimum level logged for a category
+ * 
+ * @param category Category name or pattern
+ * @param minimum Least severe message type logged
+ */
+void Logger::setLevel(const QString& category, QtMsgType minimum)
+{
+    m_levels.insert(category, minimum);
+    applyLevels();
+}
+
+/**
+ * @brief Configure log rotation
+ * 
+ * @param maxFileSize Size in bytes above which the file is rotated
+ * @param maxFiles Number of rotated files kept
+ */
+void Logger::setRotation(qint64 maxFileSize, int maxFiles)
+{
+    std::lock_guard<std::mutex> lock(m_fileMutex);
+    m_maxFileSize = maxFileSize;
+    m_maxFiles = maxFiles;
+}
+
+/**
+ * @brief Apply the category levels as QLoggingCategory rules
+ * 
+ * Qt evaluates the rules once per category, not per message, and skips
+ * formatting messages of disabled levels.
+ */
+void Logger::applyLevels()
+{
+    // Message types from least to most severe; QtMsgType values are not ordered
+    static const QtMsgType order[] = { QtDebugMsg, QtInfoMsg, QtWarningMsg, QtCriticalMsg };
+    static const char* const names[] = { "debug", "info", "warning", "critical" };
+
+    QStringList rules;
+    for (auto it = m_levels.constBegin(); it != m_levels.constEnd(); ++it) {
+        bool enabled = false;
+        for (int i = 0; i < 4; ++i) {
+            enabled = enabled || order[i] == it.value();
+            rules.append(QString("%1.%2=%3").arg(it.key(), names[i], enabled ? "true" : "false"));
+        }
+    }
+
+    QLoggingCategory::setFilterRules(rules.join('\n'));
+}
+
+/**
+ * @brief Qt message handler
+ * 
+ * Runs on the thread that logged the message.
+ * 
+ * @param type Message severity
+ * @param context Where the message was logged
+ * @param message The message text
+ */
+void Logger::messageHandler(QtMsgType type, const QMessageLogContext& context, const QString& message)
+{
+    Logger& logger = instance();
+
+    Record record;
+    record.timestamp = QDateTime::currentMSecsSinceEpoch();
+    record.type = type;
+    record.category = context.category;
+    record.file = context.file;
+    record.function = context.function;
+    record.line = context.line;
+    record.message = message;
+
+    if (!logger.push(std::move(record))) {
+        logger.m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    if (type == QtFatalMsg) {
+        // Qt aborts when the handler returns
+        logger.flush();
+    } else if (type != QtDebugMsg && type != QtInfoMsg) {
+        logger.wake();
+    }
+}
+
+/**
+ * @brief Queue a record
+ * 
+ * Producers claim a position with a compare-and-swap and publish the record
+ * by advancing the slot's sequence, so no lock is taken.
+ * 
+ * @param record The record
+ * @return bool False if the buffer was full and the record was dropped
+ */
+bool Logger::push(Record&& record)
+{
+    quint64 position = m_enqueuePos.load(std::memory_order_relaxed);
+    Slot* slot;
+
+    for (;;) {
+        slot = &m_slots[position & (BUFFER_SIZE - 1)];
+        const quint64 sequence = slot->sequence.load(std::memory_order_acquire);
+        const qint64 difference = qint64(sequence - position);
+
+        if (difference == 0) {
+            if (m_enqueuePos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // The consumer has not freed the slot yet: the buffer is full
+            return false;
+        } else {
+            position = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->record = std::move(record);
+    slot->sequence.store(position + 1, std::memory_order_release);
+
+    if ((position & (BUFFER_SIZE / 2 - 1)) == 0) {
+        wake();
+    }
+
+    return true;
+}
+
+/**
+ * @brief Take the oldest record
+ * 
+ * @param record Receives the record
+ * @return bool False if the buffer is empty
+ */
+bool Logger::pop(Record& record)
+{
+    Slot& slot = m_slots[m_dequeuePos & (BUFFER_SIZE - 1)];
+    if (slot.sequence.load(std::memory_order_acquire) != m_dequeuePos + 1) {
+        return false;
+    }
+
+    record = std::move(slot.record);
+    slot.record.message = QString();
+    slot.sequence.store(m_dequeuePos + BUFFER_SIZE, std::memory_order_release);
+    ++m_dequeuePos;
+    return true;
+}
+
+/**
+ * @brief Write all queued records
+ * 
+ * Formats the records into one block, which is written to the file and to
+ * stderr with a single call each.
+ */
+void Logger::drain()
+{
+    static const char* const typeNames[] = { "Debug", "Warning", "Critical", "Fatal", "Info" };
+
+    const int dropped = m_dropped.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) {
+        m_output.append(QDateTime::currentDateTime().toString("[yyyy-MM-dd hh:mm:ss.zzz]").toUtf8());
+        m_output.append(" [Warning] ");
+        m_output.append(QByteArray::number(dropped));
+        m_output.append(" log messages dropped, the log buffer was full\n");
+    }
+
+    Record record;
+    while (pop(record)) {
+        m_output.append(QDateTime::fromMSecsSinceEpoch(record.timestamp).toString("[yyyy-MM-dd hh:mm:ss.zzz]").toUtf8());
+        m_output.append(" [");
+        m_output.append(typeNames[qBound(0, int(record.type), 4)]);
+        m_output.append("] ");
+
+        if (record.category && qstrcmp(record.category, "default") != 0) {
+            m_output.append('[');
+            m_output.append(record.category);
+            m_output.append("] ");
+        }
+
+        m_output.append(record.message.toUtf8());
+
+        if (record.type != QtDebugMsg && record.type != QtInfoMsg) {
+            m_output.append(" (");
+            m_output.append(record.file ? record.file : "unknown");
+            m_output.append(':');
+            m_output.append(QByteArray::number(record.line));
+            m_output.append(", ");
+            m_output.append(record.function ? record.function : "unknown");
+            m_output.append(')');
+        }
+
+        m_output.append('\n');
+    }
+
+    if (m_output.isEmpty()) {
+        m_writtenPos.store(m_dequeuePos, std::memory_order_release);
+        return;
+    }
+
+    // Also output to console for development purposes
+    fwrite(m_output.constData(), 1, size_t(m_output.size()), stderr);
+
+    if (m_file.isOpen()) {
+        m_file.write(m_output);
+        m_file.flush();
+
+        if (m_file.size() >= m_maxFileSize) {
+            rotate();
+        }
+    }
+
+    m_output.resize(0);
+    m_writtenPos.store(m_dequeuePos, std::memory_order_release);
+}
+
+/**
+ * @brief Rename the log file and start a new one
+ * 
+ * todowidget.log becomes todowidget.1.log, todowidget.1.log becomes
+ * todowidget.2.log and so on; the oldest file is removed.
+ */
+void Logger::rotate()
+{
+    const QFileInfo info(m_file.fileName());
+    const QString base = info.absolutePath() + '/' + info.completeBaseName();
+    const QString suffix = info.suffix().isEmpty() ? QString() : '.' + info.suffix();
+    auto rotatedPath = [&base, &suffix](int index) {
+        return QString("%1.%2%3").arg(base).arg(index).arg(suffix);
+    };
+
+    m_file.close();
+
+    QFile::remove(rotatedPath(m_maxFiles));
+    for (int i = m_maxFiles - 1; i >= 1; --i) {
+        QFile::rename(rotatedPath(i), rotatedPath(i + 1));
+    }
+    if (m_maxFiles > 0) {
+        QFile::rename(m_file.fileName(), rotatedPath(1));
+    } else {
+        QFile::remove(m_file.fileName());
+    }
+
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+        fprintf(stderr, "Warning: Could not reopen log file after rotation\n");
+    }
+    updateCrashFd();
+}
+
+/**
+ * @brief Body of the writer thread
+ * 
+ * Sleeps until woken or until FLUSH_INTERVAL_MS passed, then drains the
+ * buffer.
+ */
+void Logger::run()
+{
+    for (;;) {
+        bool running;
+        {
+            std::unique_lock<std::mutex> lock(m_wakeMutex);
+            m_wakeCondition.wait_for(lock, std::chrono::milliseconds(FLUSH_INTERVAL_MS));
+            running = m_running;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_fileMutex);
+            drain();
+        }
+
+        if (!running) {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Wake the writer thread
+ * 
+ * Notifying without holding the mutex can miss a wait that is just starting,
+ * which only delays the write until the next interval.
+ */
+void Logger::wake()
+{
+    m_wakeCondition.notify_one();
+}
+
+/**
+ * @brief Replace the descriptor written by the crash handler
+ * 
+ * The handler works on a duplicate so it never sees a descriptor QFile is
+ * closing. The new descriptor is published before the old one is closed.
+ */
+void Logger::updateCrashFd()
+{
+    const int fd = m_file.isOpen() ? LOGGER_DUP(m_file.handle()) : -1;
+    const int previous = m_crashFd.exchange(fd);
+    if (previous >= 0) {
+        LOGGER_CLOSE(previous);
+    }
+}
+
+/**
+ * @brief Handler of crash signals
+ * 
+ * Waits up to CRASH_WAIT_MS for the writer thread to write the records queued
+ * before the crash, then writes a line built without allocation to the log
+ * file and to stderr, restores the default action and raises the signal again
+ * so the process still terminates as it would have. If the writer thread
+ * itself crashed, the wait simply times out.
+ * 
+ * @param signal The signal number
+ */
+void Logger::crashHandler(int signal)
+{
+    std::signal(signal, SIG_DFL);
+    Logger& logger = instance();
+
+    const quint64 queued = logger.m_enqueuePos.load(std::memory_order_acquire);
+    for (int waited = 0; waited < CRASH_WAIT_MS && logger.m_writtenPos.load(std::memory_order_acquire) < queued; waited += 10) {
+#if defined(Q_OS_WIN)
+        Sleep(10);
+#else
+        const timespec step = { 0, 10 * 1000 * 1000 };
+        nanosleep(&step, nullptr);
+#endif
+    }
+
+    const char* name = "unknown";
+    switch (signal) {
+    case SIGSEGV: name = "SIGSEGV"; break;
+    case SIGABRT: name = "SIGABRT"; break;
+    case SIGFPE: name = "SIGFPE"; break;
+    case SIGILL: name = "SIGILL"; break;
+    default: break;
+    }
+
+    char digits[12];
+    int digitCount = 0;
+    for (int value = signal < 0 ? 0 : signal; digitCount == 0 || value > 0; value /= 10) {
+        digits[digitCount++] = char('0' + value % 10);
+    }
+
+    char line[128];
+    size_t length = 0;
+    auto append = [&line, &length](const char* text) {
+        const size_t size = qMin(strlen(text), sizeof(line) - 1 - length);
+        memcpy(line + length, text, size);
+        length += size;
+    };
+    append("[Fatal] Crashed with signal ");
+    while (digitCount > 0 && length < sizeof(line) - 1) {
+        line[length++] = digits[--digitCount];
+    }
+    append(" (");
+    append(name);
+    append(")\n");
+
+    const int fd = logger.m_crashFd.load();
+    if (fd >= 0) {
+        LOGGER_WRITE(fd, line, length);
+    }
+    LOGGER_WRITE(2, line, length);
+
+    std::raise(signal);
+}
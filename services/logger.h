@@ -0,0 +1,240 @@
+/**
+ * @file logger.h
+ * @brief Definition of the Logger class
+ * 
+ * This file defines the Logger singleton class which writes Qt log messages
+ * to a rotating log file from a background thread.
+ * 
+ * @author Cornebidouil
+ * @date Last updated: April 30, 2025
+ */
+
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QFile>
+#include <QHash>
+#include <QByteArray>
+#include <QtGlobal>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/**
+ * @class Logger
+ * @brief Asynchronous Qt message handler with log rotation
+ * 
+ * Once installed, every Qt message (qDebug(), qWarning(), ...) is stamped and
+ * pushed into a fixed-size lock-free ring buffer; a background thread drains
+ * the buffer, formats the messages and writes them to the log file and to
+ * stderr in blocks. The calling thread never touches the file, so logging
+ * costs a timestamp, one compare-and-swap and a reference-counted string copy.
+ * When the buffer is full, messages are dropped and counted rather than
+ * blocking the caller.
+ * 
+ * The writer wakes up every FLUSH_INTERVAL_MS, when a warning or worse is
+ * logged, and when the buffer is half full. Fatal messages flush the buffer
+ * before the process ends. Crash signals give the writer thread a moment to
+ * write what is queued, then append a pre-formatted line with write(2) to a
+ * descriptor opened in advance; the signal handler never formats or locks.
+ * 
+ * Levels are filtered per category through QLoggingCategory rules, so
+ * disabled messages are not even formatted. Rules from the QT_LOGGING_RULES
+ * environment variable take precedence.
+ * 
+ * The log file is rotated when it exceeds the maximum size: todowidget.log
+ * becomes todowidget.1.log and so on, keeping a fixed number of old files.
+ */
+class Logger {
+public:
+    /**
+     * @brief Get the singleton instance
+     * @return Logger& Reference to the singleton instance
+     */
+    static Logger& instance();
+    
+    /**
+     * @brief Start logging to a file
+     * 
+     * Opens the file, starts the writer thread and installs the Qt message
+     * handler and the crash handlers.
+     * 
+     * @param filePath Path to the log file; its directory is created if needed
+     * @return bool True if the file was opened, false otherwise
+     */
+    bool install(const QString& filePath);
+    
+    /**
+     * @brief Stop logging
+     * 
+     * Restores the default message handler, writes the remaining messages and
+     * stops the writer thread.
+     */
+    void shutdown();
+    
+    /**
+     * @brief Write all queued messages
+     * 
+     * Drains the buffer on the calling thread and flushes the file.
+     */
+    void flush();
+    
+    /**
+     * @brief Set the minimum level logged for a category
+     * 
+     * Plain qDebug() and friends use the "default" category; "*" matches
+     * every category.
+     * 
+     * @param category Category name or pattern
+     * @param minimum Least severe message type logged
+     */
+    void setLevel(const QString& category, QtMsgType minimum);
+    
+    /**
+     * @brief Configure log rotation
+     * @param maxFileSize Size in bytes above which the file is rotated
+     * @param maxFiles Number of rotated files kept
+     */
+    void setRotation(qint64 maxFileSize, int maxFiles);
+
+private:
+    /**
+     * @struct Record
+     * @brief A message waiting to be written
+     * 
+     * The context strings are string literals from the call site.
+     */
+    struct Record {
+        qint64 timestamp = 0;            ///< Milliseconds since the epoch
+        QtMsgType type = QtDebugMsg;     ///< Message severity
+        const char* category = nullptr;  ///< Logging category name
+        const char* file = nullptr;      ///< Source file, if known
+        const char* function = nullptr;  ///< Function, if known
+        int line = 0;                    ///< Source line, if known
+        QString message;                 ///< The message text
+    };
+    
+    /**
+     * @struct Slot
+     * @brief Ring buffer cell
+     * 
+     * The sequence number tells producers and the consumer whose turn it is:
+     * the slot is free for the producer at position p when it equals p, and
+     * holds a record for the consumer at position p when it equals p + 1.
+     */
+    struct Slot {
+        std::atomic<quint64> sequence;   ///< Turn of the slot
+        Record record;                   ///< The record, valid when published
+    };
+    
+    /**
+     * @brief Private constructor
+     * 
+     * Prevents direct instantiation to ensure singleton pattern.
+     */
+    Logger();
+    
+    /**
+     * @brief Private destructor
+     * 
+     * Stops logging if it is still running.
+     */
+    ~Logger();
+    
+    /**
+     * @brief Queue a record
+     * @param record The record
+     * @return bool False if the buffer was full and the record was dropped
+     */
+    bool push(Record&& record);
+    
+    /**
+     * @brief Take the oldest record
+     * 
+     * Called with m_fileMutex held, which makes the caller the only consumer.
+     * 
+     * @param record Receives the record
+     * @return bool False if the buffer is empty
+     */
+    bool pop(Record& record);
+    
+    /**
+     * @brief Write all queued records
+     * 
+     * Called with m_fileMutex held.
+     */
+    void drain();
+    
+    /**
+     * @brief Rename the log file and start a new one
+     * 
+     * Called with m_fileMutex held.
+     */
+    void rotate();
+    
+    /**
+     * @brief Body of the writer thread
+     */
+    void run();
+    
+    /**
+     * @brief Wake the writer thread
+     */
+    void wake();
+    
+    /**
+     * @brief Replace the descriptor written by the crash handler
+     * 
+     * Called with m_fileMutex held whenever the log file is opened or closed.
+     */
+    void updateCrashFd();
+    
+    /**
+     * @brief Apply the category levels as QLoggingCategory rules
+     */
+    void applyLevels();
+    
+    /**
+     * @brief Qt message handler
+     * @param type Message severity
+     * @param context Where the message was logged
+     * @param message The message text
+     */
+    static void messageHandler(QtMsgType type, const QMessageLogContext& context, const QString& message);
+    
+    /**
+     * @brief Handler of crash signals
+     * 
+     * Only calls async-signal-safe functions.
+     * 
+     * @param signal The signal number
+     */
+    static void crashHandler(int signal);
+    
+    static const int BUFFER_SIZE = 8192;        ///< Ring buffer slots, a power of two
+    static const int FLUSH_INTERVAL_MS = 200;   ///< Longest time a message waits for the writer
+    static const int CRASH_WAIT_MS = 300;       ///< Longest time a crash waits for the writer
+    
+    std::unique_ptr<Slot[]> m_slots;            ///< The ring buffer
+    std::atomic<quint64> m_enqueuePos;          ///< Next position for producers
+    quint64 m_dequeuePos;                       ///< Next position for the consumer
+    std::atomic<int> m_dropped;                 ///< Records dropped since the last drain
+    std::atomic<quint64> m_writtenPos;          ///< Positions formatted and written by the consumer
+    
+    std::mutex m_fileMutex;                     ///< Guards the file and the consumer side
+    QFile m_file;                               ///< The log file
+    QByteArray m_output;                        ///< Formatted records not yet written
+    qint64 m_maxFileSize;                       ///< Size above which the file is rotated
+    int m_maxFiles;                             ///< Rotated files kept
+    std::atomic<int> m_crashFd;                 ///< Duplicate of the log file descriptor for the crash handler, or -1
+    
+    std::thread m_thread;                       ///< The writer thread
+    std::mutex m_wakeMutex;                     ///< Guards m_running for the condition
+    std::condition_variable m_wakeCondition;    ///< Wakes the writer thread
+    bool m_running;                             ///< True while the writer thread runs
+    
+    QHash<QString, QtMsgType> m_levels;         ///< Minimum level by category
+};
@@ -0,0 +1,115 @@
+/**
+ * @file reportcache.cpp
+ * @brief Implementation of the ReportCache class
+ * 
+ * The ReportCache keeps aggregated report buckets so reopening the reports
+ * dialog or switching between date ranges only recomputes ranges whose time
+ * entries changed.
+ * 
+ * @author Cornebidouil
+ * @date Last updated: April 30, 2025
+ */
+
+#include "reportcache.h"
+
+/**
+ * @brief Get the singleton instance
+ * @return ReportCache& Reference to the singleton instance
+ */
+ReportCache& ReportCache::instance()
+{
+    static ReportCache instance;
+    return instance;
+}
+
+/**
+ * @brief Constructor for ReportCache
+ */
+ReportCache::ReportCache()
+    : m_cache(MAX_CACHED_BUCKETS)
+{
+}
+
+/**
+ * @brief Build the key of a range
+ * 
+ * @param startDate First day of the range
+ * @param endDate Last day of the range (inclusive)
+ * @param dataVersion Current data version of the time entries
+ * @return Key The cache key
+ */
+ReportCache::Key ReportCache::makeKey(const QDate& startDate, const QDate& endDate, quint64 dataVersion)
+{
+    bool closed = endDate < QDate::currentDate();
+    return Key{startDate, endDate, closed ? 0 : dataVersion};
+}
+
+/**
+ * @brief Look up the buckets of a range
+ * 
+ * @param startDate First day of the range
+ * @param endDate Last day of the range (inclusive)
+ * @param dataVersion Current data version of the time entries
+ * @param buckets Receives the cached buckets on a hit
+ * @return bool True if the range was cached
+ */
+bool ReportCache::find(const QDate& startDate, const QDate& endDate, quint64 dataVersion,
+                       ReportGenerator::Buckets& buckets)
+{
+    ReportGenerator::Buckets* cached = m_cache.object(makeKey(startDate, endDate, dataVersion));
+    if (!cached) {
+        return false;
+    }
+    
+    buckets = *cached;
+    return true;
+}
+
+/**
+ * @brief Store the buckets of a range
+ * 
+ * The cost of an entry is its number of day and day × project buckets, so a
+ * sparse multi-year range costs about as much as the days it has time on.
+ * 
+ * @param buckets The aggregated buckets
+ * @param dataVersion Data version of the entries the buckets were computed from
+ */
+void ReportCache::insert(const ReportGenerator::Buckets& buckets, quint64 dataVersion)
+{
+    if (buckets.cancelled || !buckets.startDate.isValid()) {
+        return;
+    }
+    
+    int cost = 1 + buckets.dayTotals.size();
+    for (auto it = buckets.dayProjects.cbegin(); it != buckets.dayProjects.cend(); ++it) {
+        cost += it.value().size();
+    }
+    
+    // QCache takes ownership and deletes the copy if it exceeds the whole budget
+    m_cache.insert(makeKey(buckets.startDate, buckets.endDate, dataVersion),
+                   new ReportGenerator::Buckets(buckets), cost);
+}
+
+/**
+ * @brief Drop every cached range overlapping a span of days
+ * 
+ * @param firstDay First changed day
+ * @param lastDay Last changed day (inclusive)
+ */
+void ReportCache::invalidate(const QDate& firstDay, const QDate& lastDay)
+{
+    const QList<Key> keys = m_cache.keys();
+    for (const Key& key : keys) {
+        if (key.startDate <= lastDay && key.endDate >= firstDay) {
+            m_cache.remove(key);
+        }
+    }
+}
+
+/**
+ * @brief Drop all cached ranges
+ */
+void ReportCache::clear()
+{
+    m_cache.clear();
+}
@@ -0,0 +1,129 @@
+/**
+ * @file reportcache.h
+ * @brief Definition of the ReportCache class
+ * 
+ * This file defines the ReportCache class which keeps aggregated report
+ * buckets across report requests and dialog instances.
+ * 
+ * @author Cornebidouil
+ * @date Last updated: April 30, 2025
+ */
+
+#pragma once
+
+#include <QCache>
+#include <QDate>
+#include <QHash>
+#include "reportgenerator.h"
+
+/**
+ * @class ReportCache
+ * @brief LRU cache of aggregated report buckets
+ * 
+ * Buckets are keyed by their date range and the data version of the time
+ * entries they were computed from. Since every grouping is rolled up from the
+ * same buckets, the grouping is not part of the key.
+ * 
+ * Closed ranges (ending before today) cannot change unless an entry inside them
+ * is added, updated or deleted, so they are stored independently of the data
+ * version and are only dropped by invalidate() or by LRU eviction. Ranges that
+ * include today stay tied to the data version they were computed for.
+ * 
+ * The cache is bounded by the number of buckets it holds; the least recently
+ * used ranges are evicted first.
+ */
+class ReportCache {
+public:
+    /**
+     * @struct Key
+     * @brief Cache key of an aggregated range
+     */
+    struct Key {
+        QDate startDate;          ///< First day of the range
+        QDate endDate;            ///< Last day of the range (inclusive)
+        quint64 dataVersion;      ///< Data version for open ranges, 0 for closed ranges
+        
+        bool operator==(const Key& other) const {
+            return startDate == other.startDate && endDate == other.endDate
+                   && dataVersion == other.dataVersion;
+        }
+    };
+    
+    /**
+     * @brief Get the singleton instance
+     * @return ReportCache& Reference to the singleton instance
+     */
+    static ReportCache& instance();
+    
+    /**
+     * @brief Look up the buckets of a range
+     * 
+     * A hit marks the range as most recently used.
+     * 
+     * @param startDate First day of the range
+     * @param endDate Last day of the range (inclusive)
+     * @param dataVersion Current data version of the time entries
+     * @param buckets Receives the cached buckets on a hit
+     * @return bool True if the range was cached
+     */
+    bool find(const QDate& startDate, const QDate& endDate, quint64 dataVersion,
+              ReportGenerator::Buckets& buckets);
+    
+    /**
+     * @brief Store the buckets of a range
+     * 
+     * Cancelled buckets are ignored.
+     * 
+     * @param buckets The aggregated buckets
+     * @param dataVersion Data version of the entries the buckets were computed from
+     */
+    void insert(const ReportGenerator::Buckets& buckets, quint64 dataVersion);
+    
+    /**
+     * @brief Drop every cached range overlapping a span of days
+     * @param firstDay First changed day
+     * @param lastDay Last changed day (inclusive)
+     */
+    void invalidate(const QDate& firstDay, const QDate& lastDay);
+    
+    /**
+     * @brief Drop all cached ranges
+     */
+    void clear();
+
+private:
+    /**
+     * @brief Private constructor to enforce singleton pattern
+     */
+    ReportCache();
+    
+    /**
+     * @brief Build the key of a range
+     * 
+     * Ranges ending before today use data version 0.
+     * 
+     * @param startDate First day of the range
+     * @param endDate Last day of the range (inclusive)
+     * @param dataVersion Current data version of the time entries
+     * @return Key The cache key
+     */
+    static Key makeKey(const QDate& startDate, const QDate& endDate, quint64 dataVersion);
+    
+    ReportCache(const ReportCache&) = delete;
+    ReportCache& operator=(const ReportCache&) = delete;
+    
+    static const int MAX_CACHED_BUCKETS = 200000; ///< Upper bound on day and day × project buckets held
+    
+    QCache<Key, ReportGenerator::Buckets> m_cache; ///< Cached buckets, evicted least recently used first
+};
+
+/**
+ * @brief Hash a report cache key
+ * @param key The key to hash
+ * @param seed Hash seed
+ * @return uint The hash value
+ */
+inline uint qHash(const ReportCache::Key& key, uint seed = 0)
+{
+    return qHash(key.startDate, seed) ^ qHash(key.endDate, seed) ^ qHash(key.dataVersion, seed);
+}
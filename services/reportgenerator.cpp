@@ -0,0 +1,231 @@
+/**
+ * @file reportgenerator.cpp
+ * @brief Implementation of the ReportGenerator class
+ * 
+ * The ReportGenerator aggregates a snapshot of time entries into day × project
+ * buckets and rolls them up into the periods and pivots shown by the time
+ * reports dialog. Aggregation runs on a worker thread; rollups are cheap enough
+ * to run on the GUI thread.
+ * 
+ * @author Cornebidouil
+ * @date Last updated: April 30, 2025
+ */
+
+#include "reportgenerator.h"
+
+/**
+ * @brief Aggregate time entries into day × project buckets
+ * 
+ * Each entry is clipped to the range once and split at midnight boundaries, so
+ * the cost is proportional to the number of entries plus the days they cover.
+ * Only days with tracked time get a bucket, which keeps multi-year ranges small.
+ * 
+ * @param entries Snapshot of the time entries
+ * @param startDate First day of the range
+ * @param endDate Last day of the range (inclusive)
+ * @param now Current time, used as the end of running entries
+ * @param generation Generation number of this request
+ * @param latestGeneration Shared latest generation; the pass is cancelled when it differs
+ * @return Buckets The aggregated buckets
+ */
+ReportGenerator::Buckets ReportGenerator::aggregate(const QList<TimeEntry>& entries, const QDate& startDate,
+                                                    const QDate& endDate, const QDateTime& now, int generation,
+                                                    const QSharedPointer<QAtomicInt>& latestGeneration)
+{
+    Buckets buckets;
+    buckets.generation = generation;
+    buckets.startDate = startDate;
+    buckets.endDate = endDate;
+    
+    QDateTime rangeStart(startDate, QTime(0, 0, 0));
+    QDateTime rangeEnd(endDate.addDays(1), QTime(0, 0, 0));
+    
+    int processed = 0;
+    for (const TimeEntry& entry : entries) {
+        // Check for a newer request every few hundred entries
+        if ((++processed & 0x1FF) == 0 && latestGeneration && latestGeneration->loadAcquire() != generation) {
+            buckets.cancelled = true;
+            return buckets;
+        }
+        
+        QDateTime entryStart = entry.startTime();
+        QDateTime entryEnd = entry.isRunning() ? now : entry.endTime();
+        
+        // Clip the entry to the range
+        if (entryStart < rangeStart) {
+            entryStart = rangeStart;
+        }
+        if (entryEnd > rangeEnd) {
+            entryEnd = rangeEnd;
+        }
+        if (entryEnd <= entryStart) {
+            continue;
+        }
+        
+        // Split the clipped interval at midnight boundaries
+        QDateTime segmentStart = entryStart;
+        while (segmentStart < entryEnd) {
+            QDate day = segmentStart.date();
+            QDateTime nextMidnight(day.addDays(1), QTime(0, 0, 0));
+            QDateTime segmentEnd = nextMidnight < entryEnd ? nextMidnight : entryEnd;
+            int seconds = static_cast<int>(segmentStart.secsTo(segmentEnd));
+            
+            buckets.dayTotals[day] += seconds;
+            buckets.dayProjects[day][entry.projectId()] += seconds;
+            buckets.totalSeconds += seconds;
+            
+            segmentStart = segmentEnd;
+        }
+    }
+    
+    return buckets;
+}
+
+/**
+ * @brief Roll buckets up into period totals
+ * 
+ * @param buckets The aggregated buckets
+ * @param period The period to group by
+ * @param startDate First day of the range
+ * @param endDate Last day of the range
+ * @return QMap<QDate, int> Map of period start dates to seconds
+ */
+QMap<QDate, int> ReportGenerator::totalsByPeriod(const Buckets& buckets, Period period,
+                                                 const QDate& startDate, const QDate& endDate)
+{
+    QMap<QDate, int> result;
+    
+    // Show all periods, even with 0 time
+    for (QDate start = periodStart(startDate, period); start <= endDate; start = periodEnd(start, period).addDays(1)) {
+        result.insert(start, 0);
+    }
+    
+    auto end = buckets.dayTotals.upperBound(endDate);
+    for (auto it = buckets.dayTotals.lowerBound(startDate); it != end; ++it) {
+        result[periodStart(it.key(), period)] += it.value();
+    }
+    
+    return result;
+}
+
+/**
+ * @brief Roll buckets up into project totals
+ * 
+ * @param buckets The aggregated buckets
+ * @param startDate First day of the range
+ * @param endDate Last day of the range
+ * @return QMap<QString, int> Map of project IDs to seconds
+ */
+QMap<QString, int> ReportGenerator::totalsByProject(const Buckets& buckets, const QDate& startDate, const QDate& endDate)
+{
+    QMap<QString, int> result;
+    
+    auto end = buckets.dayProjects.upperBound(endDate);
+    for (auto day = buckets.dayProjects.lowerBound(startDate); day != end; ++day) {
+        for (auto it = day.value().cbegin(); it != day.value().cend(); ++it) {
+            result[it.key()] += it.value();
+        }
+    }
+    
+    return result;
+}
+
+/**
+ * @brief Roll buckets up into a project × period pivot table
+ * 
+ * @param buckets The aggregated buckets
+ * @param period The period of the pivot columns
+ * @param startDate First day of the range
+ * @param endDate Last day of the range
+ * @return QMap<QString, QMap<QDate, int>> Map of project IDs to period start dates to seconds
+ */
+QMap<QString, QMap<QDate, int>> ReportGenerator::pivotByProjectAndPeriod(const Buckets& buckets, Period period,
+                                                                         const QDate& startDate, const QDate& endDate)
+{
+    QMap<QString, QMap<QDate, int>> result;
+    
+    auto end = buckets.dayProjects.upperBound(endDate);
+    for (auto day = buckets.dayProjects.lowerBound(startDate); day != end; ++day) {
+        QDate start = periodStart(day.key(), period);
+        for (auto it = day.value().cbegin(); it != day.value().cend(); ++it) {
+            result[it.key()][start] += it.value();
+        }
+    }
+    
+    return result;
+}
+
+/**
+ * @brief Get the first day of the period containing a date
+ * 
+ * @param date Any date
+ * @param period The period
+ * @return QDate The first day of the period
+ */
+QDate ReportGenerator::periodStart(const QDate& date, Period period)
+{
+    switch (period) {
+        case Week:
+            return date.addDays(-(date.dayOfWeek() - 1));
+        case Month:
+            return QDate(date.year(), date.month(), 1);
+        case Quarter:
+            return QDate(date.year(), ((date.month() - 1) / 3) * 3 + 1, 1);
+        case Year:
+            return QDate(date.year(), 1, 1);
+        case Day:
+        default:
+            return date;
+    }
+}
+
+/**
+ * @brief Get the last day of a period
+ * 
+ * @param start The first day of the period
+ * @param period The period
+ * @return QDate The last day of the period
+ */
+QDate ReportGenerator::periodEnd(const QDate& start, Period period)
+{
+    switch (period) {
+        case Week:
+            return start.addDays(6);
+        case Month:
+            return start.addMonths(1).addDays(-1);
+        case Quarter:
+            return start.addMonths(3).addDays(-1);
+        case Year:
+            return start.addYears(1).addDays(-1);
+        case Day:
+        default:
+            return start;
+    }
+}
+
+/**
+ * @brief Get the display label of a period
+ * 
+ * @param start The first day of the period
+ * @param period The period
+ * @return QString The label of the period
+ */
+QString ReportGenerator::periodLabel(const QDate& start, Period period)
+{
+    switch (period) {
+        case Week: {
+            int weekYear = 0;
+            int week = start.weekNumber(&weekYear);
+            return QString("%1-W%2").arg(weekYear).arg(week, 2, 10, QChar('0'));
+        }
+        case Month:
+            return start.toString("yyyy-MM");
+        case Quarter:
+            return QString("%1 Q%2").arg(start.year()).arg((start.month() - 1) / 3 + 1);
+        case Year:
+            return QString::number(start.year());
+        case Day:
+        default:
+            return start.toString("yyyy-MM-dd");
+    }
+}
@@ -0,0 +1,153 @@
+/**
+ * @file reportgenerator.h
+ * @brief Definition of the ReportGenerator class
+ * 
+ * This file defines the ReportGenerator class which aggregates time entries
+ * into report buckets. It works on a snapshot of the entries and has no
+ * dependency on the GUI, so it can run on a worker thread.
+ * 
+ * @author Cornebidouil
+ * @date Last updated: April 30, 2025
+ */
+
+#pragma once
+
+#include <QList>
+#include <QMap>
+#include <QHash>
+#include <QDate>
+#include <QDateTime>
+#include <QAtomicInt>
+#include <QSharedPointer>
+#include "../models/timeentry.h"
+
+/**
+ * @class ReportGenerator
+ * @brief Thread-safe aggregation of time entries for reports
+ * 
+ * The ReportGenerator class computes the data shown by the time reports dialog
+ * in two steps. aggregate() makes a single pass over the entries and produces
+ * sparse day × project buckets for a date range. Every report grouping (day,
+ * week, month, quarter, year, project, and project × period pivots) is then
+ * rolled up from those buckets without touching the entries again, so switching
+ * grouping or drilling into a sub-range of the aggregated range is instant.
+ * 
+ * Aggregation is tagged with a generation number; when the shared latest
+ * generation moves on, the pass stops early and returns cancelled buckets.
+ */
+class ReportGenerator {
+public:
+    /**
+     * @brief Report periods, from finest to coarsest
+     */
+    enum Period {
+        Day,
+        Week,
+        Month,
+        Quarter,
+        Year
+    };
+    
+    /**
+     * @struct Buckets
+     * @brief Finest-grained aggregation of a date range
+     */
+    struct Buckets {
+        int generation = 0;                             ///< Generation the buckets were computed for
+        QDate startDate;                                ///< First day of the aggregated range
+        QDate endDate;                                  ///< Last day of the aggregated range (inclusive)
+        QMap<QDate, int> dayTotals;                     ///< Seconds per day, only days with tracked time
+        QMap<QDate, QHash<QString, int>> dayProjects;   ///< Seconds per project ID per day
+        int totalSeconds = 0;                           ///< Total seconds in the range
+        bool cancelled = false;                         ///< True if a newer generation superseded this one
+        
+        /**
+         * @brief Check if the buckets can answer a report for a range
+         * @param start First day of the requested range
+         * @param end Last day of the requested range
+         * @return bool True if the requested range lies within the aggregated range
+         */
+        bool covers(const QDate& start, const QDate& end) const {
+            return startDate.isValid() && !cancelled && start >= startDate && end <= endDate;
+        }
+    };
+    
+    /**
+     * @brief Aggregate time entries into day × project buckets
+     * 
+     * Safe to call from any thread as long as the entry list is a snapshot.
+     * 
+     * @param entries Snapshot of the time entries
+     * @param startDate First day of the range
+     * @param endDate Last day of the range (inclusive)
+     * @param now Current time, used as the end of running entries
+     * @param generation Generation number of this request
+     * @param latestGeneration Shared latest generation; the pass is cancelled when it differs
+     * @return Buckets The aggregated buckets
+     */
+    static Buckets aggregate(const QList<TimeEntry>& entries, const QDate& startDate, const QDate& endDate,
+                             const QDateTime& now, int generation,
+                             const QSharedPointer<QAtomicInt>& latestGeneration);
+    
+    /**
+     * @brief Roll buckets up into period totals
+     * 
+     * Every period overlapping the range is present, even with 0 time.
+     * 
+     * @param buckets The aggregated buckets
+     * @param period The period to group by
+     * @param startDate First day of the range (must be covered by the buckets)
+     * @param endDate Last day of the range (must be covered by the buckets)
+     * @return QMap<QDate, int> Map of period start dates to seconds
+     */
+    static QMap<QDate, int> totalsByPeriod(const Buckets& buckets, Period period,
+                                           const QDate& startDate, const QDate& endDate);
+    
+    /**
+     * @brief Roll buckets up into project totals
+     * 
+     * @param buckets The aggregated buckets
+     * @param startDate First day of the range (must be covered by the buckets)
+     * @param endDate Last day of the range (must be covered by the buckets)
+     * @return QMap<QString, int> Map of project IDs to seconds
+     */
+    static QMap<QString, int> totalsByProject(const Buckets& buckets, const QDate& startDate, const QDate& endDate);
+    
+    /**
+     * @brief Roll buckets up into a project × period pivot table
+     * 
+     * Only cells with tracked time are present.
+     * 
+     * @param buckets The aggregated buckets
+     * @param period The period of the pivot columns
+     * @param startDate First day of the range (must be covered by the buckets)
+     * @param endDate Last day of the range (must be covered by the buckets)
+     * @return QMap<QString, QMap<QDate, int>> Map of project IDs to period start dates to seconds
+     */
+    static QMap<QString, QMap<QDate, int>> pivotByProjectAndPeriod(const Buckets& buckets, Period period,
+                                                                   const QDate& startDate, const QDate& endDate);
+    
+    /**
+     * @brief Get the first day of the period containing a date
+     * @param date Any date
+     * @param period The period
+     * @return QDate The first day of the period (weeks start on Monday)
+     */
+    static QDate periodStart(const QDate& date, Period period);
+    
+    /**
+     * @brief Get the last day of a period
+     * @param start The first day of the period
+     * @param period The period
+     * @return QDate The last day of the period
+     */
+    static QDate periodEnd(const QDate& start, Period period);
+    
+    /**
+     * @brief Get the display label of a period
+     * @param start The first day of the period
+     * @param period The period
+     * @return QString The label, e.g. "2025-04-30", "2025-W18", "2025-04", "2025 Q2" or "2025"
+     */
+    static QString periodLabel(const QDate& start, Period period);
+};
@@ -17,6 +17,7 @@
 #include <QStandardPaths>
 #include <QDir>
 #include <QSettings>
+#include <QtConcurrent>
 
 /**
  * @brief Get singleton instance
@@ -44,6 +45,9 @@ SettingsManager& SettingsManager::instance()
 SettingsManager::SettingsManager(QObject* parent)
     : QObject(parent),
       m_settings(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/settings.ini", QSettings::IniFormat),
+      m_dirty(false),
+      m_updateDepth(0),
+      m_flushed(false),
       m_alwaysOnTop(false),
       m_opacity(0.9),
       m_windowPosition(QPoint(100, 100)),
@@ -61,6 +65,10 @@ SettingsManager::SettingsManager(QObject* parent)
         dir.mkpath(".");
     }
     
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(SAVE_DELAY_MS);
+    connect(&m_saveTimer, &QTimer::timeout, this, &SettingsManager::save);
+    
     // Load settings from file
     load();
 }
@@ -68,11 +76,11 @@ SettingsManager::SettingsManager(QObject* parent)
 /**
  * @brief Destructor
  * 
- * Saves current settings to the settings file before destruction.
+ * Writes pending changes to the settings file before destruction.
  */
 SettingsManager::~SettingsManager()
 {
-    save();
+    flush();
 }
 
 /**
@@ -88,7 +96,7 @@ bool SettingsManager::alwaysOnTop() const
 /**
  * @brief Set always-on-top setting
  * 
- * Updates the always-on-top setting and saves the change.
+ * Updates the always-on-top setting and schedules a save.
  * 
  * @param value True to make the window always on top, false otherwise
  */
@@ -96,7 +104,7 @@ void SettingsManager::setAlwaysOnTop(bool value)
 {
     if (m_alwaysOnTop != value) {
         m_alwaysOnTop = value;
-        save();
+        scheduleSave();
     }
 }
 
@@ -113,7 +121,7 @@ double SettingsManager::opacity() const
 /**
  * @brief Set window opacity
  * 
- * Updates the window opacity setting and saves the change.
+ * Updates the window opacity setting and schedules a save.
  * 
  * @param value Opacity value (0.0 to 1.0, where 1.0 is fully opaque)
  */
@@ -121,7 +129,7 @@ void SettingsManager::setOpacity(double value)
 {
     if (m_opacity != value) {
         m_opacity = value;
-        save();
+        scheduleSave();
     }
 }
 
@@ -138,7 +146,7 @@ QPoint SettingsManager::windowPosition() const
 /**
  * @brief Set window position
  * 
- * Updates the window position setting and saves the change.
+ * Updates the window position setting and schedules a save.
  * 
  * @param position The new position for the application window
  */
@@ -146,7 +154,7 @@ void SettingsManager::setWindowPosition(const QPoint& position)
 {
     if (m_windowPosition != position) {
         m_windowPosition = position;
-        save();
+        scheduleSave();
     }
 }
 
@@ -163,7 +171,7 @@ QSize SettingsManager::windowSize() const
 /**
  * @brief Set window size
  * 
- * Updates the window size setting and saves the change.
+ * Updates the window size setting and schedules a save.
  * 
  * @param size The new size for the application window
  */
@@ -171,7 +179,7 @@ void SettingsManager::setWindowSize(const QSize& size)
 {
     if (m_windowSize != size) {
         m_windowSize = size;
-        save();
+        scheduleSave();
     }
 }
 
@@ -214,7 +222,7 @@ void SettingsManager::setStartWithWindows(bool value) {
         } else {
             startupSettings.remove("TodoWidget");
         }
-        save();
+        scheduleSave();
     }
 }
 
@@ -237,7 +245,10 @@ bool SettingsManager::startMinimized() const
  */
 void SettingsManager::setStartMinimized(bool minimized)
 {
-    m_startMinimized = minimized;
+    if (m_startMinimized != minimized) {
+        m_startMinimized = minimized;
+        scheduleSave();
+    }
 }
 
 /**
@@ -253,7 +264,7 @@ bool SettingsManager::enableNotifications() const
 /**
  * @brief Set notifications enabled setting
  * 
- * Updates the setting for enabling/disabling notifications and saves the change.
+ * Updates the setting for enabling/disabling notifications and schedules a save.
  * 
  * @param value True to enable notifications, false otherwise
  */
@@ -261,7 +272,7 @@ void SettingsManager::setEnableNotifications(bool value)
 {
     if (m_enableNotifications != value) {
         m_enableNotifications = value;
-        save();
+        scheduleSave();
     }
 }
 
@@ -278,7 +289,7 @@ QString SettingsManager::defaultCategoryId() const
 /**
  * @brief Set default category ID
  * 
- * Updates the default category ID for new tasks and saves the change.
+ * Updates the default category ID for new tasks and schedules a save.
  * 
  * @param id The ID of the category to use as default
  */
@@ -286,7 +297,7 @@ void SettingsManager::setDefaultCategoryId(const QString& id)
 {
     if (m_defaultCategoryId != id) {
         m_defaultCategoryId = id;
-        save();
+        scheduleSave();
     }
 }
 
@@ -298,6 +309,9 @@ void SettingsManager::setDefaultCategoryId(const QString& id)
  */
 void SettingsManager::load()
 {
+    // Read what the last write left on disk
+    m_pendingWrite.waitForFinished();
+    
     try {
         m_alwaysOnTop = m_settings.value("Window/AlwaysOnTop", false).toBool();
         m_opacity = m_settings.value("Window/Opacity", 1.0).toDouble();
@@ -322,26 +336,141 @@ void SettingsManager::load()
 /**
  * @brief Save settings to file
  * 
- * Saves all application settings to the settings file and
- * ensures the file is synced to disk.
+ * Takes a copy of the current settings and writes it on a worker thread, so
+ * the GUI thread does not wait for the file. Writes are serialized: a save
+ * waits for the previous write, which the idle delay makes rare.
  */
 void SettingsManager::save()
 {
-    m_settings.setValue("Window/AlwaysOnTop", m_alwaysOnTop);
-    m_settings.setValue("Window/Opacity", m_opacity);
-    m_settings.setValue("Window/Position", m_windowPosition);
-    m_settings.setValue("Window/Size", m_windowSize);
+    m_saveTimer.stop();
+    m_dirty = false;
+    
+    const QString fileName = m_settings.fileName();
+    const QVariantMap values = snapshot();
+    
+    m_pendingWrite.waitForFinished();
+    if (m_flushed) {
+        writeSettings(fileName, values);
+        return;
+    }
+    m_pendingWrite = QtConcurrent::run([fileName, values]() {
+        writeSettings(fileName, values);
+    });
+}
+
+/**
+ * @brief Write pending changes and wait for all writes to finish
+ */
+void SettingsManager::flush()
+{
+    if (m_saveTimer.isActive()) {
+        m_saveTimer.stop();
+    }
+    m_pendingWrite.waitForFinished();
+    m_flushed = true;
+    
+    if (m_dirty) {
+        m_dirty = false;
+        writeSettings(m_settings.fileName(), snapshot());
+    }
+}
+
+/**
+ * @brief Apply several settings with a single write
+ * 
+ * @param changes Function changing the settings
+ */
+void SettingsManager::update(const std::function<void(SettingsManager&)>& changes)
+{
+    beginUpdate();
+    changes(*this);
+    endUpdate();
+}
+
+/**
+ * @brief Start a group of changes saved together
+ */
+void SettingsManager::beginUpdate()
+{
+    ++m_updateDepth;
+}
+
+/**
+ * @brief End a group of changes
+ * 
+ * The outermost group saves right away instead of waiting for the idle
+ * timer, since its changes are complete.
+ */
+void SettingsManager::endUpdate()
+{
+    if (m_updateDepth > 0 && --m_updateDepth == 0 && m_dirty) {
+        save();
+    }
+}
 
-    m_settings.setValue("Startup/StartWithWindows", m_startWithWindows);
-    m_settings.setValue("Startup/StartMinimized", m_startMinimized);
+/**
+ * @brief Mark the settings dirty and schedule a save
+ */
+void SettingsManager::scheduleSave()
+{
+    m_dirty = true;
+    
+    if (m_updateDepth == 0) {
+        if (m_flushed) {
+            save();
+        } else {
+            m_saveTimer.start();
+        }
+    }
+}
 
-    m_settings.setValue("Categories/DefaultCategory", m_defaultCategoryId);
+/**
+ * @brief Collect the current settings by key
+ * 
+ * @return QVariantMap The settings to write
+ */
+QVariantMap SettingsManager::snapshot() const
+{
+    QVariantMap values;
+    
+    values.insert("Window/AlwaysOnTop", m_alwaysOnTop);
+    values.insert("Window/Opacity", m_opacity);
+    values.insert("Window/Position", m_windowPosition);
+    values.insert("Window/Size", m_windowSize);
+
+    values.insert("Startup/StartWithWindows", m_startWithWindows);
+    values.insert("Startup/StartMinimized", m_startMinimized);
 
-    m_settings.setValue("Notifications/Enable", m_enableNotifications);
-    m_settings.setValue("Notifications/NotifyDueSoon", m_notifyDueSoon);
-    m_settings.setValue("Notifications/NotifyOverdue", m_notifyOverdue);
+    values.insert("Categories/DefaultCategory", m_defaultCategoryId);
 
-    m_settings.sync();
+    values.insert("Notifications/Enable", m_enableNotifications);
+    values.insert("Notifications/NotifyDueSoon", m_notifyDueSoon);
+    values.insert("Notifications/NotifyOverdue", m_notifyOverdue);
+    
+    return values;
+}
+
+/**
+ * @brief Write settings to a file
+ * 
+ * QSettings objects of the same file share their data within the process,
+ * so m_settings sees the values once they were written.
+ * 
+ * @param fileName Path to the settings file
+ * @param values The settings by key
+ */
+void SettingsManager::writeSettings(const QString& fileName, const QVariantMap& values)
+{
+    QSettings settings(fileName, QSettings::IniFormat);
+    
+    for (auto it = values.constBegin(); it != values.constEnd(); ++it) {
+        settings.setValue(it.key(), it.value());
+    }
+    
+    settings.sync();
+    if (settings.status() != QSettings::NoError) {
+        qWarning() << "Failed to write settings to" << fileName;
+    }
 }
 
 /**
@@ -396,7 +525,10 @@ bool SettingsManager::notifyDueSoon() const
  */
 void SettingsManager::setNotifyDueSoon(bool notify)
 {
-    m_notifyDueSoon = notify;
+    if (m_notifyDueSoon != notify) {
+        m_notifyDueSoon = notify;
+        scheduleSave();
+    }
 }
 
 /**
@@ -418,5 +550,8 @@ bool SettingsManager::notifyOverdue() const
  */
 void SettingsManager::setNotifyOverdue(bool notify)
 {
-    m_notifyOverdue = notify;
+    if (m_notifyOverdue != notify) {
+        m_notifyOverdue = notify;
+        scheduleSave();
+    }
 }
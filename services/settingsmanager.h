@@ -15,7 +15,11 @@
 #include <QSettings>
 #include <QPoint>
 #include <QSize>
+#include <QTimer>
+#include <QFuture>
+#include <QVariantMap>
 #include <QDebug>
+#include <functional>
 
 /**
  * @class SettingsManager
@@ -30,6 +34,12 @@
  * - Startup behavior settings (auto-start, minimized start)
  * - Category defaults
  * - Notification preferences
+ * 
+ * Setters do not write to disk: they mark the settings dirty and restart a
+ * short idle timer, so a burst of changes (e.g. dragging the opacity slider)
+ * results in a single write once the changes stop. Writes run on a worker
+ * thread. Several settings can be changed together with update(), which
+ * writes once at the end, and flush() writes pending changes at shutdown.
  */
 class SettingsManager : public QObject {
     Q_OBJECT
@@ -179,10 +189,52 @@ public:
     /**
      * @brief Save settings to storage
      * 
-     * Saves all current settings to persistent storage.
+     * Starts writing all current settings to persistent storage on a worker
+     * thread, replacing any scheduled save. After flush() the write happens on
+     * the calling thread instead.
      */
     void save();
     
+    /**
+     * @brief Write pending changes and wait for all writes to finish
+     * 
+     * Writes on the calling thread. Called at shutdown so no change is lost;
+     * every later change is then written synchronously, since no event loop
+     * is left to run the save timer.
+     */
+    void flush();
+    
+    /**
+     * @brief Apply several settings with a single write
+     * 
+     * The setters called by changes only mark the settings dirty; the
+     * settings are saved once when changes returns. Updates can be nested.
+     * 
+     * @code
+     * SettingsManager::instance().update([](SettingsManager& settings) {
+     *     settings.setWindowPosition(pos);
+     *     settings.setWindowSize(size);
+     * });
+     * @endcode
+     * 
+     * @param changes Function changing the settings
+     */
+    void update(const std::function<void(SettingsManager&)>& changes);
+    
+    /**
+     * @brief Start a group of changes saved together
+     * 
+     * Must be matched by endUpdate().
+     */
+    void beginUpdate();
+    
+    /**
+     * @brief End a group of changes
+     * 
+     * Saves the settings if the outermost group changed them.
+     */
+    void endUpdate();
+    
     /**
      * @brief Reset all settings to defaults
      * 
@@ -206,8 +258,38 @@ private:
      * Ensures settings are saved when the manager is destroyed.
      */
     ~SettingsManager();
+    
+    /**
+     * @brief Mark the settings dirty and schedule a save
+     * 
+     * Restarts the idle timer, unless an update is in progress.
+     */
+    void scheduleSave();
+    
+    /**
+     * @brief Collect the current settings by key
+     * @return QVariantMap The settings to write
+     */
+    QVariantMap snapshot() const;
+    
+    /**
+     * @brief Write settings to a file
+     * 
+     * Uses its own QSettings object, so it can run on any thread.
+     * 
+     * @param fileName Path to the settings file
+     * @param values The settings by key
+     */
+    static void writeSettings(const QString& fileName, const QVariantMap& values);
+
+    static const int SAVE_DELAY_MS = 500; ///< Idle time after the last change before saving
 
     QSettings m_settings;      ///< Qt settings storage
+    QTimer m_saveTimer;        ///< Fires once the settings were left unchanged for SAVE_DELAY_MS
+    QFuture<void> m_pendingWrite; ///< Write running on a worker thread
+    bool m_dirty;              ///< True if settings changed since the last save
+    int m_updateDepth;         ///< Nesting level of beginUpdate() calls
+    bool m_flushed;            ///< True once flush() ran; saves are then synchronous
 
     // Cached settings
     bool m_alwaysOnTop;        ///< Whether window should be always on top
@@ -0,0 +1,214 @@
+/**
+ * @file tracer.cpp
+ * @brief Implementation of the Tracer class
+ * 
+ * The Tracer keeps one event buffer per thread and merges them when a trace
+ * is exported.
+ * 
+ * @author Cornebidouil
+ * @date Last updated: April 30, 2025
+ */
+
+#include "tracer.h"
+#include "jsonstreamwriter.h"
+#include <QCoreApplication>
+#include <QThread>
+#include <QFile>
+#include <QJsonObject>
+#include <QDebug>
+#include <chrono>
+
+std::atomic<bool> Tracer::s_enabled(false);
+
+/**
+ * @brief Get singleton instance
+ * 
+ * @return Tracer& Reference to the singleton instance
+ */
+Tracer& Tracer::instance()
+{
+    static Tracer instance;
+    return instance;
+}
+
+/**
+ * @brief Constructor
+ * 
+ * Takes the current clock time as time zero of the traces.
+ */
+Tracer::Tracer()
+    : m_origin(now())
+{
+}
+
+/**
+ * @brief Enable or disable recording
+ * 
+ * Recorded events are kept when recording is disabled.
+ * 
+ * @param enabled True to record scopes
+ */
+void Tracer::setEnabled(bool enabled)
+{
+    // Create the instance first so time zero precedes every event
+    instance();
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Enable tracing if the TODOWIDGET_TRACE environment variable is set
+ * 
+ * @return QString The output file named by the variable, empty if tracing stays off
+ */
+QString Tracer::enableFromEnvironment()
+{
+    const QString filePath = QString::fromLocal8Bit(qgetenv("TODOWIDGET_TRACE"));
+    if (!filePath.isEmpty()) {
+        setEnabled(true);
+    }
+    return filePath;
+}
+
+/**
+ * @brief Get the current time of the trace clock
+ * 
+ * @return qint64 Nanoseconds on a monotonic clock
+ */
+qint64 Tracer::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Record a finished scope
+ * 
+ * @param name Event name
+ * @param category Event category
+ * @param start Start time from now()
+ * @param duration Duration in nanoseconds
+ */
+void Tracer::record(const char* name, const char* category, qint64 start, qint64 duration)
+{
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+
+    if (buffer.events.size() >= size_t(MAX_EVENTS_PER_THREAD)) {
+        ++buffer.dropped;
+        return;
+    }
+
+    buffer.events.push_back(Event{ name, category, start, duration });
+}
+
+/**
+ * @brief Get the buffer of the calling thread, creating it on first use
+ * 
+ * The buffer is registered once per thread; later calls only read a
+ * thread-local pointer.
+ * 
+ * @return ThreadBuffer& The buffer
+ */
+Tracer::ThreadBuffer& Tracer::threadBuffer()
+{
+    thread_local ThreadBuffer* current = nullptr;
+    if (current) {
+        return *current;
+    }
+
+    std::shared_ptr<ThreadBuffer> buffer = std::make_shared<ThreadBuffer>();
+    buffer->events.reserve(1024);
+
+    QThread* thread = QThread::currentThread();
+    if (QCoreApplication::instance() && thread == QCoreApplication::instance()->thread()) {
+        buffer->threadName = "GUI thread";
+    } else {
+        buffer->threadName = thread->objectName();
+    }
+
+    std::lock_guard<std::mutex> lock(m_buffersMutex);
+    buffer->threadId = int(m_buffers.size()) + 1;
+    if (buffer->threadName.isEmpty()) {
+        buffer->threadName = QString("Thread %1").arg(buffer->threadId);
+    }
+    m_buffers.push_back(buffer);
+
+    current = buffer.get();
+    return *current;
+}
+
+/**
+ * @brief Write the recorded events as a Chrome trace
+ * 
+ * Writes the JSON array form of the trace event format: a metadata event
+ * naming each thread, then one complete ("X") event per scope, with times in
+ * microseconds since the Tracer was created. Each buffer is copied under its
+ * lock so the threads are only held up for the copy.
+ * 
+ * @param filePath Path to the output file
+ * @return bool True if the trace was written, false otherwise
+ */
+bool Tracer::exportChromeTrace(const QString& filePath)
+{
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(m_buffersMutex);
+        buffers = m_buffers;
+    }
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Could not open file for writing:" << filePath;
+        return false;
+    }
+
+    JsonStreamWriter json(&file);
+    json.beginArray();
+
+    const qint64 pid = QCoreApplication::applicationPid();
+    int eventCount = 0;
+
+    for (const std::shared_ptr<ThreadBuffer>& buffer : buffers) {
+        std::vector<Event> events;
+        int dropped;
+        {
+            std::lock_guard<std::mutex> lock(buffer->mutex);
+            events = buffer->events;
+            dropped = buffer->dropped;
+        }
+
+        QJsonObject threadName;
+        threadName["name"] = "thread_name";
+        threadName["ph"] = "M";
+        threadName["pid"] = pid;
+        threadName["tid"] = buffer->threadId;
+        threadName["args"] = QJsonObject{ { "name", buffer->threadName } };
+        json.writeObject(threadName);
+
+        if (dropped > 0) {
+            qWarning() << "Trace buffer of" << buffer->threadName << "was full," << dropped << "events dropped";
+        }
+
+        for (const Event& event : events) {
+            QJsonObject object;
+            object["name"] = QString::fromUtf8(event.name);
+            object["cat"] = QString::fromUtf8(event.category);
+            object["ph"] = "X";
+            object["ts"] = double(event.start - m_origin) / 1000.0;
+            object["dur"] = double(event.duration) / 1000.0;
+            object["pid"] = pid;
+            object["tid"] = buffer->threadId;
+            json.writeObject(object);
+        }
+        eventCount += int(events.size());
+    }
+
+    json.endArray();
+    const bool success = json.flush();
+    file.close();
+
+    if (success) {
+        qInfo() << "Wrote" << eventCount << "trace events to" << filePath;
+    }
+    return success;
+}
@@ -0,0 +1,209 @@
+/**
+ * @file tracer.h
+ * @brief Definition of the Tracer and TraceScope classes
+ * 
+ * This file defines the Tracer singleton which records timed scopes into
+ * per-thread buffers and exports them in the Chrome trace event format, and
+ * the TRACE_SCOPE and TRACE_FUNCTION macros that instrument the code.
+ * 
+ * @author Cornebidouil
+ * @date Last updated: April 30, 2025
+ */
+
+#pragma once
+
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @class Tracer
+ * @brief Recorder of timed scopes for performance analysis
+ * 
+ * Tracing is off by default; a disabled trace point costs one relaxed atomic
+ * load. When enabled, every scope appends one event to a buffer owned by its
+ * thread, whose lock is only contended while a trace is being exported.
+ * 
+ * Traces are written in the Chrome trace event format, which chrome://tracing
+ * and https://ui.perfetto.dev open directly: either on demand with
+ * exportChromeTrace(), or at exit when the TODOWIDGET_TRACE environment
+ * variable names the output file.
+ * 
+ * Event names and categories must be string literals (or Q_FUNC_INFO), since
+ * only their pointers are stored.
+ */
+class Tracer {
+public:
+    /**
+     * @brief Get the singleton instance
+     * @return Tracer& Reference to the singleton instance
+     */
+    static Tracer& instance();
+    
+    /**
+     * @brief Check if tracing is enabled
+     * @return bool True if scopes are being recorded
+     */
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+    
+    /**
+     * @brief Enable or disable recording
+     * @param enabled True to record scopes
+     */
+    void setEnabled(bool enabled);
+    
+    /**
+     * @brief Enable tracing if the TODOWIDGET_TRACE environment variable is set
+     * 
+     * Call first thing in main() so startup is recorded from the beginning.
+     * 
+     * @return QString The output file named by the variable, empty if tracing stays off
+     */
+    QString enableFromEnvironment();
+    
+    /**
+     * @brief Get the current time of the trace clock
+     * @return qint64 Nanoseconds on a monotonic clock
+     */
+    static qint64 now();
+    
+    /**
+     * @brief Record a finished scope
+     * @param name Event name
+     * @param category Event category
+     * @param start Start time from now()
+     * @param duration Duration in nanoseconds
+     */
+    void record(const char* name, const char* category, qint64 start, qint64 duration);
+    
+    /**
+     * @brief Write the recorded events as a Chrome trace
+     * 
+     * Recording may continue while the trace is written.
+     * 
+     * @param filePath Path to the output file
+     * @return bool True if the trace was written, false otherwise
+     */
+    bool exportChromeTrace(const QString& filePath);
+
+private:
+    /**
+     * @struct Event
+     * @brief A recorded scope
+     */
+    struct Event {
+        const char* name;       ///< Event name
+        const char* category;   ///< Event category
+        qint64 start;           ///< Start time in nanoseconds
+        qint64 duration;        ///< Duration in nanoseconds
+    };
+    
+    /**
+     * @struct ThreadBuffer
+     * @brief Events of one thread
+     * 
+     * Kept after the thread ends, so its events still reach the export.
+     */
+    struct ThreadBuffer {
+        std::mutex mutex;             ///< Guards events against a concurrent export
+        std::vector<Event> events;    ///< Events in completion order
+        int threadId = 0;             ///< Sequential ID used as the trace tid
+        QString threadName;           ///< Name shown for the thread
+        int dropped = 0;              ///< Events left out once the buffer was full
+    };
+    
+    /**
+     * @brief Private constructor
+     * 
+     * Prevents direct instantiation to ensure singleton pattern.
+     */
+    Tracer();
+    
+    /**
+     * @brief Get the buffer of the calling thread, creating it on first use
+     * @return ThreadBuffer& The buffer
+     */
+    ThreadBuffer& threadBuffer();
+    
+    static const int MAX_EVENTS_PER_THREAD = 1 << 20; ///< Events kept per thread
+    
+    static std::atomic<bool> s_enabled;                    ///< True while recording
+    
+    std::mutex m_buffersMutex;                             ///< Guards m_buffers
+    std::vector<std::shared_ptr<ThreadBuffer>> m_buffers;  ///< Buffers of all threads that recorded
+    qint64 m_origin;                                       ///< Clock time at construction, time zero of traces
+};
+
+/**
+ * @class TraceScope
+ * @brief Records the time between its construction and destruction
+ * 
+ * Use through TRACE_SCOPE or TRACE_FUNCTION. end() closes the scope early,
+ * for phases that declare objects which must outlive the phase.
+ */
+class TraceScope {
+public:
+    /**
+     * @brief Constructor
+     * 
+     * Starts the scope if tracing is enabled.
+     * 
+     * @param name Event name, a string literal
+     * @param category Event category, a string literal
+     */
+    TraceScope(const char* name, const char* category)
+        : m_name(name)
+        , m_category(category)
+        , m_start(Tracer::isEnabled() ? Tracer::now() : -1)
+    {
+    }
+    
+    /**
+     * @brief Destructor
+     * 
+     * Ends the scope if end() was not called.
+     */
+    ~TraceScope() { end(); }
+    
+    /**
+     * @brief End the scope and record it
+     */
+    void end()
+    {
+        if (m_start >= 0) {
+            Tracer::instance().record(m_name, m_category, m_start, Tracer::now() - m_start);
+            m_start = -1;
+        }
+    }
+
+private:
+    Q_DISABLE_COPY(TraceScope)
+    
+    const char* m_name;       ///< Event name
+    const char* m_category;   ///< Event category
+    qint64 m_start;           ///< Start time, -1 if not recording
+};
+
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+
+#ifdef TODOWIDGET_NO_TRACING
+#define TRACE_SCOPE(name, category) do {} while (false)
+#define TRACE_FUNCTION(category) do {} while (false)
+#else
+/**
+ * @brief Record the rest of the enclosing block as an event
+ * @param name Event name, a string literal
+ * @param category Event category, a string literal
+ */
+#define TRACE_SCOPE(name, category) TraceScope TRACE_CONCAT(traceScope_, __LINE__)(name, category)
+
+/**
+ * @brief Record the rest of the enclosing function as an event named after it
+ * @param category Event category, a string literal
+ */
+#define TRACE_FUNCTION(category) TRACE_SCOPE(Q_FUNC_INFO, category)
+#endif
@@ -13,6 +13,7 @@
 #include "categorydelegate.h"
 #include <QPainter>
 #include "../models/categorymodel.h"
+#include "../services/tracer.h"
 
 /**
  * @brief Constructor
@@ -40,6 +41,8 @@ CategoryDelegate::CategoryDelegate(QObject *parent)
 void CategoryDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
                            const QModelIndex &index) const
 {
+    TRACE_FUNCTION("paint");
+
     if (!index.isValid())
         return;
 
@@ -27,6 +27,7 @@
 #include "timeentrydialog.h"
 #include "timereportsdialog.h"
 #include "../services/settingsmanager.h"
+#include "../services/tracer.h"
 
 /**
  * @brief Constructor
@@ -41,8 +42,13 @@ MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent), 
       m_isDragging(false)
 {
+    TRACE_FUNCTION("startup");
+
     // Basic UI setup
-    setupUi();
+    {
+        TRACE_SCOPE("setupUi", "startup");
+        setupUi();
+    }
 
     setupModels();
     
@@ -60,8 +66,12 @@ MainWindow::MainWindow(QWidget *parent)
     
     setupConnections();
     loadSettings();
+    
+    // Save the geometry while the event loop still runs, before the final settings flush
+    connect(qApp, &QCoreApplication::aboutToQuit, this, &MainWindow::saveSettings);
 
     // Initialize controllers - order matters here
+    TRACE_SCOPE("Load data", "startup");
     m_categoryController->loadCategories();
     
     // First load projects, then initialize time tracking controller
@@ -80,11 +90,10 @@ MainWindow::MainWindow(QWidget *parent)
 /**
  * @brief Destructor
  * 
- * Saves window settings before destruction.
+ * Window settings are saved when the application is about to quit.
  */
 MainWindow::~MainWindow()
 {
-    saveSettings();
 }
 
 /**
@@ -183,6 +192,8 @@ void MainWindow::mouseReleaseEvent(QMouseEvent *event)
  */
 void MainWindow::delayedInitialization()
 {
+    TRACE_FUNCTION("startup");
+
     setupModels();
     setupConnections();
     setupSystemTray();
@@ -422,13 +433,15 @@ void MainWindow::loadSettings()
  * @brief Save application settings
  * 
  * Saves the current window position and size to the SettingsManager.
- * Called automatically when the window is closed or the application exits.
+ * Called automatically when the application is about to quit.
  */
 void MainWindow::saveSettings()
 {
-    // Save window position and size
-    SettingsManager::instance().setWindowPosition(pos());
-    SettingsManager::instance().setWindowSize(size());
+    // Save window position and size with a single write
+    SettingsManager::instance().update([this](SettingsManager& settings) {
+        settings.setWindowPosition(pos());
+        settings.setWindowSize(size());
+    });
 }
 
 /**
@@ -11,6 +11,7 @@
  */
 
 #include "projectdelegate.h"
+#include "../services/tracer.h"
 #include <QPainter>
 #include <QApplication>
 
@@ -36,6 +37,8 @@ ProjectDelegate::ProjectDelegate(QObject *parent)
  */
 void ProjectDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
 {
+    TRACE_FUNCTION("paint");
+
     if (!index.isValid()) {
         return QStyledItemDelegate::paint(painter, option, index);
     }
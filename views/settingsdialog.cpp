@@ -298,25 +298,24 @@ void SettingsDialog::loadSettings()
  */
 void SettingsDialog::saveSettings()
 {
-    // Save window settings
-    SettingsManager::instance().setAlwaysOnTop(m_alwaysOnTopCheck->isChecked());
-    SettingsManager::instance().setOpacity(m_opacitySlider->value() / 100.0);
-
-    // Save startup settings
-    SettingsManager::instance().setStartWithWindows(m_startWithWindowsCheck->isChecked());
-    SettingsManager::instance().setStartMinimized(m_startMinimizedCheck->isChecked());
-
-    // Save notification settings
-    SettingsManager::instance().setEnableNotifications(m_enableNotificationsCheck->isChecked());
-    SettingsManager::instance().setNotifyDueSoon(m_notifyDueSoonCheck->isChecked());
-    SettingsManager::instance().setNotifyOverdue(m_notifyOverdueCheck->isChecked());
-
-    // Save default category
-    QString defaultCategoryId = m_defaultCategoryCombo->currentData().toString();
-    SettingsManager::instance().setDefaultCategoryId(defaultCategoryId);
-
-    // Save all settings to disk
-    SettingsManager::instance().save();
+    // Apply all settings with a single write to disk
+    SettingsManager::instance().update([this](SettingsManager& settings) {
+        // Save window settings
+        settings.setAlwaysOnTop(m_alwaysOnTopCheck->isChecked());
+        settings.setOpacity(m_opacitySlider->value() / 100.0);
+
+        // Save startup settings
+        settings.setStartWithWindows(m_startWithWindowsCheck->isChecked());
+        settings.setStartMinimized(m_startMinimizedCheck->isChecked());
+
+        // Save notification settings
+        settings.setEnableNotifications(m_enableNotificationsCheck->isChecked());
+        settings.setNotifyDueSoon(m_notifyDueSoonCheck->isChecked());
+        settings.setNotifyOverdue(m_notifyOverdueCheck->isChecked());
+
+        // Save default category
+        settings.setDefaultCategoryId(m_defaultCategoryCombo->currentData().toString());
+    });
 }
 
 /**
@@ -17,6 +17,7 @@
 #include <QMouseEvent>
 #include <QDateTime>
 #include "../models/taskmodel.h"
+#include "../services/tracer.h"
 
 /**
  * @brief Constructor
@@ -48,6 +49,8 @@ TaskItemDelegate::TaskItemDelegate(CategoryModel *categoryModel, QObject *parent
  */
 void TaskItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
 {
+    TRACE_FUNCTION("paint");
+
     if (!index.isValid())
         return;
 
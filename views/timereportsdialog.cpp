@@ -14,15 +14,25 @@
 #include "timereportsdialog.h"
 #include "../controllers/timetrackingcontroller.h"
 #include "../controllers/projectcontroller.h"
+#include "../services/reportcache.h"
+#include "../services/csvwriter.h"
+#include "../services/compresseddevice.h"
+#include "../services/importexportservice.h"
+#include "../services/importexportjob.h"
+#include "../services/tracer.h"
 #include <QMessageBox>
 #include <QFileDialog>
+#include <QProgressDialog>
 #include <QPainter>
 #include <QPaintEvent>
 #include <QPainterPath>
+#include <QPixmap>
+#include <QtMath>
 #include <QDebug>
 #include <QHeaderView>
 #include <QFile>
-#include <QTextStream>
+#include <QFutureWatcher>
+#include <QtConcurrent>
 
 /**
  * @class ChartView
@@ -30,6 +40,13 @@
  * 
  * This widget provides a canvas for drawing time tracking charts.
  * It can display data as either a pie chart or a bar chart.
+ * 
+ * The chart is rendered once into a pixmap per widget size and data set, and
+ * every paint event just blits that pixmap. Bar charts are downsampled to the
+ * plot width: when there are more rows than bars fit, consecutive rows are
+ * summed into one bar, so rendering cost depends on the widget width rather
+ * than on the length of the range. Axis ticks, category labels, value labels
+ * and the legend are only drawn as far as they fit.
  */
 class ChartView : public QFrame {
 public:
@@ -48,14 +65,13 @@ public:
     /**
      * @brief Set the data to display in the chart
      * 
-     * @param data A map of labels to values
-     * @param colors A map of labels to colors
-     * @param total The total value (sum of all values in data)
+     * @param rows The report rows to display
+     * @param total The total value (sum of all row values)
      */
-    void setData(const QMap<QString, int>& data, const QMap<QString, QColor>& colors, int total) {
-        m_data = data;
-        m_colors = colors;
+    void setData(const QVector<ReportRow>& rows, int total) {
+        m_data = rows;
         m_totalValue = total;
+        m_cache = QPixmap();
         update();
     }
     
@@ -65,7 +81,12 @@ public:
      * @param type The chart type, either "pie" or "bar"
      */
     void setChartType(const QString& type) {
+        if (m_chartType == type) {
+            return;
+        }
+        
         m_chartType = type;
+        m_cache = QPixmap();
         update();
     }
     
@@ -73,154 +94,335 @@ protected:
     /**
      * @brief Paint event handler
      * 
-     * Draws either a pie chart or bar chart based on the current type.
+     * Re-renders the cached chart if the data or the widget size changed, then
+     * draws the cached pixmap.
      * 
      * @param event The paint event
      */
     void paintEvent(QPaintEvent* event) override {
+        TRACE_FUNCTION("paint");
+        
         QFrame::paintEvent(event);
         
-        if (m_data.isEmpty() || m_totalValue <= 0) {
-            QPainter painter(this);
-            painter.drawText(rect(), Qt::AlignCenter, "No data to display");
+        qreal ratio = devicePixelRatioF();
+        QSize pixelSize = size() * ratio;
+        
+        if (m_cache.isNull() || m_cache.size() != pixelSize) {
+            m_cache = QPixmap(pixelSize);
+            m_cache.setDevicePixelRatio(ratio);
+            m_cache.fill(Qt::transparent);
+            
+            QPainter cachePainter(&m_cache);
+            cachePainter.setFont(font());
+            
+            if (m_data.isEmpty() || m_totalValue <= 0) {
+                cachePainter.drawText(rect(), Qt::AlignCenter, "No data to display");
+            } else if (m_chartType == "pie") {
+                drawPieChart(cachePainter);
+            } else {
+                drawBarChart(cachePainter);
+            }
+        }
+        
+        QPainter painter(this);
+        painter.drawPixmap(0, 0, m_cache);
+    }
+    
+private:
+    /**
+     * @struct Bar
+     * @brief One drawn bar, covering one or more consecutive rows
+     */
+    struct Bar {
+        QString label;      ///< Row label, or "first – last" for merged rows
+        int seconds = 0;    ///< Sum of the merged rows
+        QColor color;       ///< Color of the first merged row
+    };
+    
+    /**
+     * @brief Get the color of a row
+     * 
+     * @param index Index of the row
+     * @return QColor The row color, or a hue spread over all rows if it has none
+     */
+    QColor rowColor(int index) const {
+        const QColor& color = m_data.at(index).color;
+        return color.isValid() ? color : QColor::fromHsv(index * 360 / m_data.size(), 200, 230);
+    }
+    
+    /**
+     * @brief Format a legend line for a value
+     * 
+     * @param label The label of the value
+     * @param value The value in seconds
+     * @return QString The legend text
+     */
+    QString legendText(const QString& label, int value) const {
+        double percent = (double)value / m_totalValue * 100.0;
+        return QString("%1: %2 (%3%)").arg(label).arg(TimeTrackingController::formatDuration(value)).arg(percent, 0, 'f', 1);
+    }
+    
+    /**
+     * @brief Draw a legend into a rectangle
+     * 
+     * Draws as many lines as fit; the last line summarizes the rest.
+     * 
+     * @param painter The painter to draw with
+     * @param area The legend area
+     * @param lines The legend lines
+     */
+    void drawLegend(QPainter& painter, const QRect& area, const QStringList& lines) {
+        int lineHeight = painter.fontMetrics().height() + 4;
+        int capacity = area.height() / lineHeight;
+        if (capacity <= 0) {
             return;
         }
         
-        if (m_chartType == "pie") {
-            drawPieChart();
-        } else {
-            drawBarChart();
+        int shown = lines.size() <= capacity ? lines.size() : capacity - 1;
+        
+        painter.setPen(palette().color(QPalette::Text));
+        int y = area.top();
+        for (int i = 0; i < shown; ++i) {
+            painter.drawText(QRect(area.left(), y, area.width(), lineHeight), Qt::AlignVCenter, 
+                             painter.fontMetrics().elidedText(lines.at(i), Qt::ElideRight, area.width()));
+            y += lineHeight;
+        }
+        
+        if (shown < lines.size()) {
+            painter.drawText(QRect(area.left(), y, area.width(), lineHeight), Qt::AlignVCenter,
+                             QString("… and %1 more").arg(lines.size() - shown));
         }
     }
     
-private:
     /**
      * @brief Draw a pie chart
      * 
-     * Draws a pie chart with segments for each data item.
+     * Draws a pie chart with segments for each data item. The pie shrinks to
+     * leave room for the legend, down to half the available height.
+     * 
+     * @param painter The painter to draw with
      */
-    void drawPieChart() {
-        QPainter painter(this);
+    void drawPieChart(QPainter& painter) {
         painter.setRenderHint(QPainter::Antialiasing);
         
-        // Calculate chart size
         int margin = 20;
-        QRect chartRect = rect().adjusted(margin, margin, -margin, -margin);
+        int lineHeight = painter.fontMetrics().height() + 4;
+        QRect area = rect().adjusted(margin, margin, -margin, -margin);
+        int legendHeight = qMin(m_data.size() * lineHeight, area.height() / 2);
+        
+        QRect chartRect = area.adjusted(0, 0, 0, -legendHeight - 10);
         int size = qMin(chartRect.width(), chartRect.height());
+        if (size < 20) {
+            painter.drawText(rect(), Qt::AlignCenter, "Chart area too small");
+            return;
+        }
         QRect pieRect = QRect(chartRect.center().x() - size/2, chartRect.center().y() - size/2, size, size);
         
         // Draw the pie segments
         qreal startAngle = 0;
-        int i = 0;
-        
         QStringList legend;
         
-        for (auto it = m_data.begin(); it != m_data.end(); ++it) {
-            QString label = it.key();
-            int value = it.value();
-            QColor color = m_colors.value(label, QColor::fromHsv(i * 360 / m_data.size(), 200, 230));
+        for (int i = 0; i < m_data.size(); ++i) {
+            const ReportRow& row = m_data.at(i);
+            qreal sweepAngle = 360.0 * row.seconds / m_totalValue;
             
-            qreal sweepAngle = 360.0 * value / m_totalValue;
-            
-            painter.setBrush(color);
+            painter.setBrush(rowColor(i));
             painter.setPen(Qt::white);
             painter.drawPie(pieRect, startAngle * 16, sweepAngle * 16);
             
-            // Calculate percent for legend
-            double percent = (double)value / m_totalValue * 100.0;
-            legend.append(QString("%1: %2 (%3%)").arg(label).arg(TimeTrackingController::formatDuration(value)).arg(percent, 0, 'f', 1));
-            
+            legend.append(legendText(row.label, row.seconds));
             startAngle += sweepAngle;
-            i++;
         }
         
-        // Draw legend
-        painter.setPen(Qt::black);
-        int legendY = pieRect.bottom() + 20;
-        for (const QString& text : legend) {
-            painter.drawText(QRect(margin, legendY, width() - 2*margin, 20), text);
-            legendY += 20;
+        drawLegend(painter, QRect(area.left(), pieRect.bottom() + 10, area.width(), legendHeight), legend);
+    }
+    
+    /**
+     * @brief Downsample the rows to a number of bars
+     * 
+     * Consecutive rows are summed so that at most maxBars bars remain.
+     * 
+     * @param maxBars Maximum number of bars
+     * @return QVector<Bar> The bars to draw
+     */
+    QVector<Bar> downsample(int maxBars) const {
+        int count = m_data.size();
+        int rowsPerBar = (count + maxBars - 1) / maxBars;
+        
+        QVector<Bar> bars;
+        bars.reserve((count + rowsPerBar - 1) / rowsPerBar);
+        
+        for (int first = 0; first < count; first += rowsPerBar) {
+            int last = qMin(first + rowsPerBar, count) - 1;
+            
+            Bar bar;
+            bar.color = rowColor(first);
+            bar.label = first == last ? m_data.at(first).label
+                                      : m_data.at(first).label + " – " + m_data.at(last).label;
+            for (int i = first; i <= last; ++i) {
+                bar.seconds += m_data.at(i).seconds;
+            }
+            bars.append(bar);
         }
+        
+        return bars;
+    }
+    
+    /**
+     * @brief Measure the advance width of a text
+     * 
+     * QFontMetrics::width() is deprecated since Qt 5.11 in favour of
+     * horizontalAdvance().
+     * 
+     * @param fm Font metrics of the painter
+     * @param text The text to measure
+     * @return int Width in pixels
+     */
+    static int textWidth(const QFontMetrics& fm, const QString& text) {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 11, 0)
+        return fm.horizontalAdvance(text);
+#else
+        return fm.width(text);
+#endif
+    }
+    
+    /**
+     * @brief Pick a readable step for the value axis
+     * 
+     * @param maxValue Largest value on the axis, in seconds
+     * @param maxTicks Maximum number of ticks that fit
+     * @return int Step between ticks, in seconds
+     */
+    static int tickStep(int maxValue, int maxTicks) {
+        static const int steps[] = { 60, 300, 600, 900, 1800, 3600, 2 * 3600, 4 * 3600, 8 * 3600, 24 * 3600 };
+        
+        int raw = maxValue / qMax(1, maxTicks);
+        for (int step : steps) {
+            if (step >= raw) {
+                return step;
+            }
+        }
+        
+        int step = 24 * 3600;
+        while (step < raw) {
+            step *= 2;
+        }
+        return step;
     }
     
     /**
      * @brief Draw a bar chart
      * 
-     * Draws a bar chart with bars for each data item.
+     * Draws one bar per row, or per group of rows when there are more rows
+     * than the plot width can show, with a labeled value axis.
+     * 
+     * @param painter The painter to draw with
      */
-    void drawBarChart() {
-        QPainter painter(this);
-        painter.setRenderHint(QPainter::Antialiasing);
+    void drawBarChart(QPainter& painter) {
+        QFontMetrics fm = painter.fontMetrics();
+        QColor textColor = palette().color(QPalette::Text);
         
-        // Calculate chart size
         int margin = 20;
-        int legendHeight = m_data.size() * 20 + 20;  // Space for legend
-        QRect chartRect = rect().adjusted(margin, margin, -margin, -margin - legendHeight);
+        int axisWidth = textWidth(fm, "000:00") + 8;
+        int labelHeight = fm.height() + 6;
+        
+        // The legend only lists bars when every line fits in a third of the height
+        int lineHeight = fm.height() + 4;
+        int legendHeight = m_data.size() * lineHeight <= height() / 3 ? m_data.size() * lineHeight + 10 : 0;
+        
+        QRect chartRect = rect().adjusted(margin + axisWidth, margin, -margin, -margin - labelHeight - legendHeight);
         
         if (chartRect.height() < 50 || chartRect.width() < 50) {
             painter.drawText(rect(), Qt::AlignCenter, "Chart area too small");
             return;
         }
         
-        // Draw axes
-        painter.setPen(Qt::black);
-        painter.drawLine(chartRect.bottomLeft(), chartRect.bottomRight());  // X axis
-        painter.drawLine(chartRect.bottomLeft(), chartRect.topLeft());      // Y axis
-        
-        // Calculate bar width and spacing
-        int count = m_data.size();
-        int barWidth = chartRect.width() / (count * 2);
-        int maxBarHeight = chartRect.height() - 10;
+        // Keep at least MIN_BAR_SLOT pixels per bar, merging rows when needed
+        QVector<Bar> bars = downsample(qMax(1, chartRect.width() / MIN_BAR_SLOT));
+        int count = bars.size();
         
-        // Find maximum value for scaling
         int maxValue = 0;
-        for (auto it = m_data.begin(); it != m_data.end(); ++it) {
-            maxValue = qMax(maxValue, it.value());
+        for (const Bar& bar : bars) {
+            maxValue = qMax(maxValue, bar.seconds);
+        }
+        if (maxValue <= 0) {
+            painter.drawText(rect(), Qt::AlignCenter, "No data to display");
+            return;
         }
         
-        // Draw bars
-        int i = 0;
-        QStringList legend;
+        // Value axis: round up to a whole step, one tick per few text lines
+        int step = tickStep(maxValue, chartRect.height() / (fm.height() * 2));
+        int axisMax = ((maxValue + step - 1) / step) * step;
         
-        for (auto it = m_data.begin(); it != m_data.end(); ++it) {
-            QString label = it.key();
-            int value = it.value();
-            QColor color = m_colors.value(label, QColor::fromHsv(i * 360 / count, 200, 230));
-            
-            int barHeight = maxValue > 0 ? value * maxBarHeight / maxValue : 0;
-            int barX = chartRect.left() + i * barWidth * 2 + barWidth/2;
-            int barY = chartRect.bottom() - barHeight;
-            
-            QRect barRect(barX, barY, barWidth, barHeight);
-            
-            painter.setBrush(color);
-            painter.setPen(Qt::black);
-            painter.drawRect(barRect);
-            
-            // Draw value on top
-            QString valueText = TimeTrackingController::formatDuration(value, "h:mm");
-            painter.drawText(QRect(barX - barWidth, barY - 20, barWidth*3, 20), 
-                           Qt::AlignCenter, valueText);
+        painter.setPen(palette().color(QPalette::Mid));
+        for (int value = step; value <= axisMax; value += step) {
+            int y = chartRect.bottom() - (qint64)value * chartRect.height() / axisMax;
+            painter.drawLine(chartRect.left(), y, chartRect.right(), y);
+        }
+        
+        painter.setPen(textColor);
+        for (int value = 0; value <= axisMax; value += step) {
+            int y = chartRect.bottom() - (qint64)value * chartRect.height() / axisMax;
+            painter.drawText(QRect(margin, y - fm.height() / 2, axisWidth - 6, fm.height()), 
+                             Qt::AlignRight | Qt::AlignVCenter, 
+                             TimeTrackingController::formatDuration(value, "h:mm"));
+        }
+        
+        painter.drawLine(chartRect.bottomLeft(), chartRect.bottomRight());  // X axis
+        painter.drawLine(chartRect.bottomLeft(), chartRect.topLeft());      // Y axis
+        
+        // Bars, separated by a gap only when there is room for one
+        qreal slot = (qreal)chartRect.width() / count;
+        qreal gap = slot >= 6 ? slot / 4 : 0;
+        bool showValues = slot >= textWidth(fm, "00:00") + 4;
+        
+        painter.setRenderHint(QPainter::Antialiasing, slot >= 6);
+        for (int i = 0; i < count; ++i) {
+            const Bar& bar = bars.at(i);
+            qreal barHeight = (qreal)bar.seconds * chartRect.height() / axisMax;
+            QRectF barRect(chartRect.left() + i * slot + gap / 2, chartRect.bottom() - barHeight, 
+                           slot - gap, barHeight);
             
-            // Prepare legend entry
-            double percent = (double)value / m_totalValue * 100.0;
-            legend.append(QString("%1: %2 (%3%)").arg(label).arg(TimeTrackingController::formatDuration(value)).arg(percent, 0, 'f', 1));
+            painter.fillRect(barRect, bar.color);
             
-            i++;
+            if (showValues && bar.seconds > 0) {
+                painter.drawText(QRectF(barRect.left(), barRect.top() - fm.height(), barRect.width(), fm.height()),
+                                 Qt::AlignCenter, TimeTrackingController::formatDuration(bar.seconds, "h:mm"));
+            }
+        }
+        painter.setRenderHint(QPainter::Antialiasing, false);
+        
+        // Category labels: label every n-th bar so that labels never overlap
+        int widestLabel = 0;
+        for (const Bar& bar : bars) {
+            widestLabel = qMax(widestLabel, textWidth(fm, bar.label));
         }
+        int labelEvery = qMax(1, qCeil((widestLabel + 8) / slot));
         
-        // Draw legend
-        int legendY = chartRect.bottom() + 20;
-        for (const QString& text : legend) {
-            painter.drawText(QRect(margin, legendY, width() - 2*margin, 20), text);
-            legendY += 20;
+        for (int i = 0; i < count; i += labelEvery) {
+            qreal center = chartRect.left() + (i + 0.5) * slot;
+            qreal labelWidth = slot * labelEvery;
+            painter.drawText(QRectF(center - labelWidth / 2, chartRect.bottom() + 3, labelWidth, labelHeight),
+                             Qt::AlignHCenter | Qt::AlignTop, 
+                             fm.elidedText(bars.at(i).label, Qt::ElideRight, labelWidth));
+        }
+        
+        if (legendHeight > 0) {
+            QStringList legend;
+            for (const ReportRow& row : m_data) {
+                legend.append(legendText(row.label, row.seconds));
+            }
+            drawLegend(painter, QRect(margin, chartRect.bottom() + labelHeight + 10, 
+                                      width() - 2 * margin, legendHeight - 10), legend);
         }
     }
     
-    QMap<QString, int> m_data;           ///< Chart data (label -> value)
-    QMap<QString, QColor> m_colors;      ///< Colors for chart elements
+    static const int MIN_BAR_SLOT = 4;   ///< Minimum horizontal pixels per bar before rows are merged
+    
+    QVector<ReportRow> m_data;           ///< Chart data, shared with the report model
     int m_totalValue;                    ///< Total value for percentage calculation
     QString m_chartType = "bar";         ///< Chart type: "bar" or "pie"
+    QPixmap m_cache;                     ///< Rendered chart for the current size and data
 };
 
 /**
@@ -232,13 +434,25 @@ private:
  */
 TimeReportsDialog::TimeReportsDialog(QWidget* parent)
     : QDialog(parent)
+    , m_latestGeneration(new QAtomicInt(0))
 {
     setWindowTitle("Time Reports");
     
     // Initialize models
-    m_reportModel = new QStandardItemModel(this);
+    m_reportModel = new TimeReportModel(this);
     m_proxyModel = new QSortFilterProxyModel(this);
     m_proxyModel->setSourceModel(m_reportModel);
+    m_proxyModel->setSortRole(TimeReportModel::SortRole);
+    
+    // Custom date edits fire on every keystroke; wait until the user pauses
+    m_customDateTimer = new QTimer(this);
+    m_customDateTimer->setSingleShot(true);
+    m_customDateTimer->setInterval(300);
+    
+    // Only show the busy indicator for reports that take noticeably long
+    m_progressDelayTimer = new QTimer(this);
+    m_progressDelayTimer->setSingleShot(true);
+    m_progressDelayTimer->setInterval(150);
     
     setupUi();
     setupConnections();
@@ -253,6 +467,8 @@ TimeReportsDialog::TimeReportsDialog(QWidget* parent)
  */
 TimeReportsDialog::~TimeReportsDialog()
 {
+    // Cancel any computation that is still running
+    m_latestGeneration->fetchAndAddOrdered(1);
 }
 
 /**
@@ -307,7 +523,15 @@ void TimeReportsDialog::setupUi()
     QHBoxLayout* groupingLayout = new QHBoxLayout();
     QLabel* groupingLabel = new QLabel("Group By:", this);
     m_groupingComboBox = new QComboBox(this);
-    m_groupingComboBox->addItems(QStringList() << "Day" << "Project");
+    m_groupingComboBox->addItems(QStringList()
+                               << "Day"
+                               << "Week"
+                               << "Month"
+                               << "Quarter"
+                               << "Year"
+                               << "Project"
+                               << "Project by Week"
+                               << "Project by Month");
     
     groupingLayout->addWidget(groupingLabel);
     groupingLayout->addWidget(m_groupingComboBox);
@@ -332,6 +556,8 @@ void TimeReportsDialog::setupUi()
     m_reportTableView->verticalHeader()->setVisible(false);
     m_reportTableView->setAlternatingRowColors(true);
     m_reportTableView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_reportTableView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_reportTableView->setToolTip("Double-click a week, month, quarter or year to drill into it");
     resultsLayout->addWidget(m_reportTableView);
     
     // Total time
@@ -342,6 +568,14 @@ void TimeReportsDialog::setupUi()
     m_totalLabel->setAlignment(Qt::AlignRight);
     resultsLayout->addWidget(m_totalLabel);
     
+    // Busy indicator for long-running reports
+    m_progressBar = new QProgressBar(this);
+    m_progressBar->setRange(0, 0);
+    m_progressBar->setTextVisible(false);
+    m_progressBar->setMaximumHeight(8);
+    m_progressBar->hide();
+    resultsLayout->addWidget(m_progressBar);
+    
     mainLayout->addWidget(resultsGroup);
     
     // Chart group
@@ -353,9 +587,15 @@ void TimeReportsDialog::setupUi()
     
     mainLayout->addWidget(chartGroup);
     
-    // Export button
+    // Export controls
+    QHBoxLayout* exportLayout = new QHBoxLayout();
+    m_exportRawCheckBox = new QCheckBox("Export raw time entries", this);
+    m_exportRawCheckBox->setToolTip("Export every time entry of the selected range instead of the report rows");
+    exportLayout->addWidget(m_exportRawCheckBox);
+    
     m_exportButton = new QPushButton("Export to CSV", this);
-    mainLayout->addWidget(m_exportButton);
+    exportLayout->addWidget(m_exportButton, 1);
+    mainLayout->addLayout(exportLayout);
     
     // Set layout sizes
     mainLayout->setStretchFactor(filterGroup, 0);
@@ -376,11 +616,17 @@ void TimeReportsDialog::setupConnections()
             this, &TimeReportsDialog::onDateRangeChanged);
     
     connect(m_customStartDateEdit, &QDateEdit::dateChanged, 
-            this, &TimeReportsDialog::onCustomDateChanged);
+            m_customDateTimer, QOverload<>::of(&QTimer::start));
     
     connect(m_customEndDateEdit, &QDateEdit::dateChanged, 
+            m_customDateTimer, QOverload<>::of(&QTimer::start));
+    
+    connect(m_customDateTimer, &QTimer::timeout, 
             this, &TimeReportsDialog::onCustomDateChanged);
     
+    connect(m_progressDelayTimer, &QTimer::timeout, 
+            m_progressBar, &QProgressBar::show);
+    
     connect(m_groupingComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), 
             this, &TimeReportsDialog::onGroupingChanged);
     
@@ -389,6 +635,20 @@ void TimeReportsDialog::setupConnections()
     
     connect(m_refreshButton, &QPushButton::clicked, 
             this, &TimeReportsDialog::onRefreshClicked);
+    
+    connect(m_reportTableView, &QTableView::doubleClicked, 
+            this, &TimeReportsDialog::onReportRowDoubleClicked);
+    
+    // Cached buckets are stale as soon as the time entries change
+    TimeTrackingController& controller = TimeTrackingController::instance();
+    connect(&controller, &TimeTrackingController::timeEntryAdded, 
+            this, &TimeReportsDialog::invalidateReportCache);
+    connect(&controller, &TimeTrackingController::timeEntryUpdated, 
+            this, &TimeReportsDialog::invalidateReportCache);
+    connect(&controller, &TimeTrackingController::timeEntryDeleted, 
+            this, &TimeReportsDialog::invalidateReportCache);
+    connect(&controller, &TimeTrackingController::timeEntriesReloaded, 
+            this, &TimeReportsDialog::invalidateReportCache);
 }
 
 /**
@@ -412,7 +672,7 @@ void TimeReportsDialog::onDateRangeChanged(int index)
 /**
  * @brief Handle custom date changes
  * 
- * Updates the report when custom date range is changed.
+ * Updates the report once the custom date range has stopped changing.
  */
 void TimeReportsDialog::onCustomDateChanged()
 {
@@ -437,10 +697,87 @@ void TimeReportsDialog::onGroupingChanged(int index)
 /**
  * @brief Handle refresh button click
  * 
- * Regenerates the report with current filter settings.
+ * Rescans the time entries and regenerates the report with current filter settings.
  */
 void TimeReportsDialog::onRefreshClicked()
 {
+    invalidateReportCache();
+    generateReport();
+}
+
+/**
+ * @brief Discard the cached buckets
+ */
+void TimeReportsDialog::invalidateReportCache()
+{
+    m_buckets = ReportGenerator::Buckets();
+}
+
+/**
+ * @brief Handle double-click on a report row
+ * 
+ * Narrows the range to the clicked period and switches to the next finer
+ * grouping: years and quarters drill into months, months and weeks into days.
+ * The cached buckets already cover the narrower range, so no rescan happens.
+ * 
+ * @param index The proxy model index of the double-clicked row
+ */
+void TimeReportsDialog::onReportRowDoubleClicked(const QModelIndex& index)
+{
+    QModelIndex sourceIndex = m_proxyModel->mapToSource(index);
+    if (!sourceIndex.isValid()) {
+        return;
+    }
+    
+    ReportGenerator::Period period;
+    int finerGrouping;
+    
+    switch (m_groupingComboBox->currentIndex()) {
+        case 1:  // Week
+            period = ReportGenerator::Week;
+            finerGrouping = 0;  // Day
+            break;
+        case 2:  // Month
+            period = ReportGenerator::Month;
+            finerGrouping = 0;  // Day
+            break;
+        case 3:  // Quarter
+            period = ReportGenerator::Quarter;
+            finerGrouping = 2;  // Month
+            break;
+        case 4:  // Year
+            period = ReportGenerator::Year;
+            finerGrouping = 2;  // Month
+            break;
+        default:
+            return;
+    }
+    
+    QDate periodStart = m_reportModel->rows().at(sourceIndex.row()).periodStart;
+    if (!periodStart.isValid()) {
+        return;
+    }
+    
+    // Clip the period to the current range so the cached buckets still cover it
+    QDate startDate, endDate;
+    getCurrentDateRange(startDate, endDate);
+    QDate drillStart = qMax(periodStart, startDate);
+    QDate drillEnd = qMin(ReportGenerator::periodEnd(periodStart, period), endDate);
+    
+    {
+        QSignalBlocker rangeBlocker(m_dateRangeComboBox);
+        QSignalBlocker startBlocker(m_customStartDateEdit);
+        QSignalBlocker endBlocker(m_customEndDateEdit);
+        QSignalBlocker groupingBlocker(m_groupingComboBox);
+        
+        m_dateRangeComboBox->setCurrentIndex(6);  // Custom Range
+        m_customStartDateEdit->setEnabled(true);
+        m_customEndDateEdit->setEnabled(true);
+        m_customStartDateEdit->setDate(drillStart);
+        m_customEndDateEdit->setDate(drillEnd);
+        m_groupingComboBox->setCurrentIndex(finerGrouping);
+    }
+    
     generateReport();
 }
 
@@ -453,14 +790,17 @@ void TimeReportsDialog::onExportClicked()
 {
     QString filename = QFileDialog::getSaveFileName(this, "Export Report", 
                                                   QDir::homePath(), 
-                                                  "CSV Files (*.csv)");
+                                                  "CSV Files (*.csv);;Compressed CSV Files (*.csv.gz)");
     
     if (!filename.isEmpty()) {
-        if (!filename.endsWith(".csv", Qt::CaseInsensitive)) {
+        if (!filename.endsWith(".csv", Qt::CaseInsensitive)
+            && !filename.endsWith(".csv.gz", Qt::CaseInsensitive)) {
             filename += ".csv";
         }
         
-        if (exportToCsv(filename)) {
+        if (m_exportRawCheckBox->isChecked()) {
+            startRawExport(filename);
+        } else if (exportToCsv(filename)) {
             QMessageBox::information(this, "Export Successful", 
                                    "The report has been exported to " + filename);
         } else {
@@ -533,24 +873,127 @@ void TimeReportsDialog::getCurrentDateRange(QDate& startDate, QDate& endDate)
 /**
  * @brief Generate a time report with current filter settings
  * 
- * Retrieves data based on current filter settings and updates the model and chart.
+ * If the dialog's buckets cover the requested range, or the shared report
+ * cache holds it for the current data version, the report is rolled up
+ * immediately. The dialog's buckets are not reused for a range still open
+ * while a timer runs, since the running time they hold is frozen. Otherwise the inputs are collected on the GUI thread and a
+ * snapshot of the time entries is aggregated on a worker. Bumping the
+ * generation cancels any older computation.
  */
 void TimeReportsDialog::generateReport()
 {
     QDate startDate, endDate;
     getCurrentDateRange(startDate, endDate);
     
-    m_reportModel->clear();
+    TimeTrackingController& controller = TimeTrackingController::instance();
+    quint64 dataVersion = controller.dataVersion();
+    
+    bool liveRange = endDate >= QDate::currentDate() && controller.isTimerRunning();
     
-    // Generate report based on grouping
+    if ((!liveRange && m_buckets.covers(startDate, endDate))
+        || ReportCache::instance().find(startDate, endDate, dataVersion, m_buckets)) {
+        // Supersede any pending aggregation; the cached buckets answer this request
+        m_latestGeneration->fetchAndAddOrdered(1);
+        m_progressDelayTimer->stop();
+        m_progressBar->hide();
+        applyReport();
+        return;
+    }
+    
+    int generation = m_latestGeneration->fetchAndAddOrdered(1) + 1;
+    
+    // The list is implicitly shared, so the snapshot is cheap and safe to read from the worker
+    QList<TimeEntry> entries = controller.timeEntryModel()->getTimeEntries();
+    QDateTime now = QDateTime::currentDateTime();
+    QSharedPointer<QAtomicInt> latestGeneration = m_latestGeneration;
+    
+    QFutureWatcher<ReportGenerator::Buckets>* watcher = new QFutureWatcher<ReportGenerator::Buckets>(this);
+    connect(watcher, &QFutureWatcher<ReportGenerator::Buckets>::finished, this, [this, watcher, dataVersion]() {
+        onReportReady(watcher->result(), dataVersion);
+        watcher->deleteLater();
+    });
+    
+    watcher->setFuture(QtConcurrent::run([entries, startDate, endDate, now, generation, latestGeneration]() {
+        return ReportGenerator::aggregate(entries, startDate, endDate, now, generation, latestGeneration);
+    }));
+    
+    if (!m_progressBar->isVisible()) {
+        m_progressDelayTimer->start();
+    }
+}
+
+/**
+ * @brief Handle finished aggregation
+ * 
+ * Runs on the GUI thread. Buckets of superseded generations are dropped.
+ * Buckets computed from still-current data are shared through the report
+ * cache, unless a running timer keeps changing the range they cover.
+ * 
+ * @param buckets The aggregated buckets
+ * @param dataVersion Data version of the snapshot the buckets were computed from
+ */
+void TimeReportsDialog::onReportReady(const ReportGenerator::Buckets& buckets, quint64 dataVersion)
+{
+    if (buckets.cancelled || buckets.generation != m_latestGeneration->loadAcquire()) {
+        return;
+    }
+    
+    m_progressDelayTimer->stop();
+    m_progressBar->hide();
+    
+    TimeTrackingController& controller = TimeTrackingController::instance();
+    bool closedRange = buckets.endDate < QDate::currentDate();
+    if (dataVersion == controller.dataVersion() && (closedRange || !controller.isTimerRunning())) {
+        ReportCache::instance().insert(buckets, dataVersion);
+    }
+    
+    m_buckets = buckets;
+    applyReport();
+}
+
+/**
+ * @brief Apply the cached buckets to the table and chart
+ * 
+ * Rolls the cached buckets up for the current range and grouping.
+ */
+void TimeReportsDialog::applyReport()
+{
+    QDate startDate, endDate;
+    getCurrentDateRange(startDate, endDate);
+    
+    // Fill the report based on grouping
     switch (m_groupingComboBox->currentIndex()) {
         case 0:  // Day
-            generateReportByDay(startDate, endDate);
+            generateReportByPeriod(ReportGenerator::Day, startDate, endDate);
+            break;
+            
+        case 1:  // Week
+            generateReportByPeriod(ReportGenerator::Week, startDate, endDate);
+            break;
+            
+        case 2:  // Month
+            generateReportByPeriod(ReportGenerator::Month, startDate, endDate);
             break;
             
-        case 1:  // Project
+        case 3:  // Quarter
+            generateReportByPeriod(ReportGenerator::Quarter, startDate, endDate);
+            break;
+            
+        case 4:  // Year
+            generateReportByPeriod(ReportGenerator::Year, startDate, endDate);
+            break;
+            
+        case 5:  // Project
             generateReportByProject(startDate, endDate);
             break;
+            
+        case 6:  // Project by Week
+            generateReportByProjectAndPeriod(ReportGenerator::Week, startDate, endDate);
+            break;
+            
+        case 7:  // Project by Month
+            generateReportByProjectAndPeriod(ReportGenerator::Month, startDate, endDate);
+            break;
     }
     
     m_reportTableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
@@ -561,52 +1004,41 @@ void TimeReportsDialog::generateReport()
 }
 
 /**
- * @brief Generate a report grouped by day
+ * @brief Fill a report grouped by period
  * 
- * Creates a report showing time spent on each day in the date range.
+ * Creates a report showing time spent in each period of the date range.
  * 
+ * @param period The period to group by
  * @param startDate The start date of the range
  * @param endDate The end date of the range
  */
-void TimeReportsDialog::generateReportByDay(const QDate& startDate, const QDate& endDate)
+void TimeReportsDialog::generateReportByPeriod(ReportGenerator::Period period, const QDate& startDate, const QDate& endDate)
 {
-    m_reportModel->setColumnCount(3);
-    m_reportModel->setHorizontalHeaderLabels(QStringList() << "Date" << "Hours" << "Minutes");
+    static const char* const headers[] = { "Date", "Week", "Month", "Quarter", "Year" };
+    
+    QMap<QDate, int> periodTotals = ReportGenerator::totalsByPeriod(m_buckets, period, startDate, endDate);
     
-    QMap<QDate, int> dailyTotals = TimeTrackingController::instance().getTimeByDay(startDate, endDate);
+    QVector<ReportRow> rows;
+    rows.reserve(periodTotals.size());
     
     int totalSeconds = 0;
-    int row = 0;
     
-    for (QDate date = startDate; date <= endDate; date = date.addDays(1)) {
-        int seconds = dailyTotals.value(date, 0);
-        totalSeconds += seconds;
+    for (auto it = periodTotals.cbegin(); it != periodTotals.cend(); ++it) {
+        ReportRow row;
+        row.label = ReportGenerator::periodLabel(it.key(), period);
+        row.seconds = it.value();
+        row.periodStart = it.key();
+        rows.append(row);
         
-        if (seconds > 0 || true) {  // Show all days, even with 0 time
-            m_reportModel->insertRow(row);
-            
-            // Date
-            m_reportModel->setItem(row, 0, new QStandardItem(date.toString("yyyy-MM-dd")));
-            
-            // Hours
-            int hours = seconds / 3600;
-            m_reportModel->setItem(row, 1, new QStandardItem(QString::number(hours)));
-            
-            // Minutes
-            int minutes = (seconds % 3600) / 60;
-            m_reportModel->setItem(row, 2, new QStandardItem(QString::number(minutes)));
-            
-            row++;
-        }
+        totalSeconds += row.seconds;
     }
     
-    // Update total
-    QString totalFormatted = TimeTrackingController::formatDuration(totalSeconds);
-    m_totalLabel->setText("Total: " + totalFormatted);
+    m_reportModel->setRows(headers[period], rows, totalSeconds);
+    updateTotal();
 }
 
 /**
- * @brief Generate a report grouped by project
+ * @brief Fill a report grouped by project
  * 
  * Creates a report showing time spent on each project in the date range.
  * 
@@ -615,89 +1047,158 @@ void TimeReportsDialog::generateReportByDay(const QDate& startDate, const QDate&
  */
 void TimeReportsDialog::generateReportByProject(const QDate& startDate, const QDate& endDate)
 {
-    m_reportModel->setColumnCount(3);
-    m_reportModel->setHorizontalHeaderLabels(QStringList() << "Project" << "Hours" << "Minutes");
+    QMap<QString, int> projectTotals = ReportGenerator::totalsByProject(m_buckets, startDate, endDate);
     
-    QMap<QString, int> projectTotals = TimeTrackingController::instance().getTimeByProject(startDate, endDate);
+    QVector<ReportRow> rows;
+    rows.reserve(projectTotals.size());
     
     int totalSeconds = 0;
-    int row = 0;
     
-    // Clear color map
-    m_colorMap.clear();
+    for (auto it = projectTotals.cbegin(); it != projectTotals.cend(); ++it) {
+        if (it.value() <= 0) {
+            continue;
+        }
+        
+        Project project = ProjectController::instance().getProject(it.key());
+        
+        ReportRow row;
+        row.label = project.id().isEmpty() ? "Unknown Project" : project.name();
+        row.seconds = it.value();
+        row.color = project.id().isEmpty() ? QColor(200, 200, 200) : project.color();
+        row.projectId = it.key();
+        rows.append(row);
+        
+        totalSeconds += row.seconds;
+    }
+    
+    m_reportModel->setRows("Project", rows, totalSeconds);
+    updateTotal();
+}
+
+/**
+ * @brief Fill a report grouped by project and period
+ * 
+ * Creates one row per project and period with tracked time, ordered by project.
+ * 
+ * @param period The period of the pivot
+ * @param startDate The start date of the range
+ * @param endDate The end date of the range
+ */
+void TimeReportsDialog::generateReportByProjectAndPeriod(ReportGenerator::Period period, const QDate& startDate, const QDate& endDate)
+{
+    QMap<QString, QMap<QDate, int>> pivot = ReportGenerator::pivotByProjectAndPeriod(m_buckets, period, startDate, endDate);
+    
+    QVector<ReportRow> rows;
+    int totalSeconds = 0;
     
-    for (auto it = projectTotals.begin(); it != projectTotals.end(); ++it) {
-        QString projectId = it.key();
-        int seconds = it.value();
+    for (auto projectIt = pivot.cbegin(); projectIt != pivot.cend(); ++projectIt) {
+        Project project = ProjectController::instance().getProject(projectIt.key());
+        QString projectName = project.id().isEmpty() ? "Unknown Project" : project.name();
+        QColor projectColor = project.id().isEmpty() ? QColor(200, 200, 200) : project.color();
         
-        if (seconds > 0) {
-            totalSeconds += seconds;
-            
-            Project project = ProjectController::instance().getProject(projectId);
-            QString projectName = project.id().isEmpty() ? "Unknown Project" : project.name();
-            
-            m_reportModel->insertRow(row);
-            
-            // Project name
-            m_reportModel->setItem(row, 0, new QStandardItem(projectName));
+        for (auto it = projectIt.value().cbegin(); it != projectIt.value().cend(); ++it) {
+            ReportRow row;
+            row.label = projectName + " · " + ReportGenerator::periodLabel(it.key(), period);
+            row.seconds = it.value();
+            row.color = projectColor;
+            row.projectId = projectIt.key();
+            row.periodStart = it.key();
+            rows.append(row);
             
-            // Hours
-            int hours = seconds / 3600;
-            m_reportModel->setItem(row, 1, new QStandardItem(QString::number(hours)));
-            
-            // Minutes
-            int minutes = (seconds % 3600) / 60;
-            m_reportModel->setItem(row, 2, new QStandardItem(QString::number(minutes)));
-            
-            // Store color for chart
-            m_colorMap[projectName] = project.id().isEmpty() ? QColor(200, 200, 200) : project.color();
-            
-            row++;
+            totalSeconds += row.seconds;
         }
     }
     
-    // Update total
-    QString totalFormatted = TimeTrackingController::formatDuration(totalSeconds);
+    m_reportModel->setRows(period == ReportGenerator::Week ? "Project / Week" : "Project / Month", rows, totalSeconds);
+    updateTotal();
+}
+
+/**
+ * @brief Update the total label from the report model
+ */
+void TimeReportsDialog::updateTotal()
+{
+    QString totalFormatted = TimeTrackingController::formatDuration(m_reportModel->totalSeconds());
     m_totalLabel->setText("Total: " + totalFormatted);
 }
 
 /**
  * @brief Update the chart with current report data
  * 
- * Extracts data from the model and updates the chart visualization.
+ * Passes the typed report rows straight to the chart visualization.
  */
 void TimeReportsDialog::updateChart()
 {
-    QMap<QString, int> chartData;
-    int totalValue = 0;
-    
-    // Extract data from model
-    for (int row = 0; row < m_reportModel->rowCount(); ++row) {
-        QString label = m_reportModel->item(row, 0)->text();
-        int hours = m_reportModel->item(row, 1)->text().toInt();
-        int minutes = m_reportModel->item(row, 2)->text().toInt();
-        
-        int seconds = hours * 3600 + minutes * 60;
-        chartData[label] = seconds;
-        totalValue += seconds;
-    }
+    const QVector<ReportRow>& rows = m_reportModel->rows();
     
     // Choose chart type based on data size
-    QString chartType = chartData.size() <= 5 ? "pie" : "bar";
+    QString chartType = rows.size() <= 5 ? "pie" : "bar";
     
     // Draw chart
     // Use static_cast instead of qobject_cast since ChartView doesn't have Q_OBJECT macro
     ChartView* chartView = static_cast<ChartView*>(m_chartFrame);
     if (chartView) {
-        chartView->setData(chartData, m_colorMap, totalValue);
+        chartView->setData(rows, m_reportModel->totalSeconds());
         chartView->setChartType(chartType);
     }
 }
 
+/**
+ * @brief Export the raw time entries of the selected range in the background
+ * 
+ * The entries are streamed from the database on a worker thread while a
+ * progress dialog counts them; cancelling removes the partial file.
+ * 
+ * @param filename The path to the CSV file to create
+ */
+void TimeReportsDialog::startRawExport(const QString& filename)
+{
+    QDate startDate, endDate;
+    getCurrentDateRange(startDate, endDate);
+    
+    QHash<QString, QString> projectNames;
+    for (const Project& project : ProjectController::instance().getProjects()) {
+        projectNames.insert(project.id(), project.name());
+    }
+    
+    ImportExportJob* job = new ImportExportJob([=](ImportExportService& service) {
+        return service.exportTimeEntriesToCsv(filename, startDate, endDate, projectNames);
+    }, this);
+    
+    QProgressDialog* progress = new QProgressDialog("Exporting time entries...", "Cancel", 0, 0, this);
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(500);
+    m_exportButton->setEnabled(false);
+    
+    connect(progress, &QProgressDialog::canceled, job, &ImportExportJob::cancel);
+    connect(job, &ImportExportJob::progress, progress, [progress](qint64, qint64, int records) {
+        progress->setLabelText(QString("Exporting time entries... %1 written").arg(records));
+    });
+    connect(job, &ImportExportJob::finished, this, [this, job, progress, filename](bool success) {
+        progress->deleteLater();
+        job->deleteLater();
+        m_exportButton->setEnabled(true);
+        
+        const ImportExportService::Summary summary = job->summary();
+        if (summary.cancelled) {
+            QFile::remove(filename);
+        } else if (success) {
+            QMessageBox::information(this, "Export Successful",
+                                     QString("%1 time entries have been exported to %2").arg(summary.exported).arg(filename));
+        } else {
+            QMessageBox::warning(this, "Export Failed",
+                                 "Failed to export the time entries to " + filename);
+        }
+    });
+    
+    job->start();
+}
+
 /**
  * @brief Export the current report to a CSV file
  * 
- * Writes the report data to a CSV file, including headers and total.
+ * Writes the report rows, including headers and total, through a buffered
+ * RFC 4180 writer.
  * 
  * @param filename The path to the CSV file to create
  * @return true if the export was successful, false otherwise
@@ -705,31 +1206,35 @@ void TimeReportsDialog::updateChart()
 bool TimeReportsDialog::exportToCsv(const QString& filename)
 {
     QFile file(filename);
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+    if (!file.open(QIODevice::WriteOnly)) {
         return false;
     }
     
-    QTextStream out(&file);
+    // Compressed while written when the name ends in .gz
+    CompressedDevice device(&file, CompressedDevice::compressionForPath(filename));
+    if (!device.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    
+    CsvWriter csv(&device);
     
     // Write header
-    QStringList headers;
-    for (int i = 0; i < m_reportModel->columnCount(); ++i) {
-        headers << m_reportModel->horizontalHeaderItem(i)->text();
-    }
-    out << headers.join(",") << "\n";
+    csv.writeRow(QStringList() << m_reportModel->labelHeader() << "Hours" << "Minutes");
     
-    // Write data
-    for (int row = 0; row < m_reportModel->rowCount(); ++row) {
-        QStringList rowData;
-        for (int col = 0; col < m_reportModel->columnCount(); ++col) {
-            rowData << "\"" + m_reportModel->item(row, col)->text() + "\"";
-        }
-        out << rowData.join(",") << "\n";
+    // Write data straight from the typed rows
+    for (const ReportRow& row : m_reportModel->rows()) {
+        csv.addField(row.label);
+        csv.addField(qint64(row.seconds / 3600));
+        csv.addField(qint64((row.seconds % 3600) / 60));
+        csv.endRow();
     }
     
     // Write total
-    out << "\n\"Total\"," << "\"" << m_totalLabel->text().replace("Total: ", "") << "\"\n";
+    csv.endRow();
+    csv.writeRow(QStringList() << "Total" << TimeTrackingController::formatDuration(m_reportModel->totalSeconds()));
     
+    bool success = csv.flush();
+    device.close();
     file.close();
-    return true;
+    return success && !device.hasError();
 }
\ No newline at end of file
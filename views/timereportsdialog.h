@@ -17,14 +17,20 @@
 #include <QTableView>
 #include <QLabel>
 #include <QPushButton>
+#include <QCheckBox>
 #include <QFrame>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QGroupBox>
-#include <QStandardItemModel>
 #include <QSortFilterProxyModel>
+#include <QProgressBar>
+#include <QTimer>
 #include <QMap>
 #include <QDate>
+#include <QSharedPointer>
+#include <QAtomicInt>
+#include "../services/reportgenerator.h"
+#include "../models/timereportmodel.h"
 
 /**
  * @class TimeReportsDialog
@@ -33,6 +39,17 @@
  * The TimeReportsDialog class provides an interface for viewing time tracking data
  * with various filtering, grouping, and visualization options, as well as
  * the ability to export data for further analysis.
+ * 
+ * Reports are computed by ReportGenerator on a worker thread from a snapshot of
+ * the time entries. Every request gets a new generation number; stale
+ * computations are cancelled and their results discarded, so only the latest
+ * inputs are ever applied to the table and chart.
+ * 
+ * The last aggregated day × project buckets are kept. Changing the grouping or
+ * drilling into a period (double-clicking a week, month, quarter or year row)
+ * rolls those buckets up again without rescanning the time entries. Finished
+ * aggregations are also shared through ReportCache, so reopening the dialog or
+ * returning to an earlier range reuses them while the data is unchanged.
  */
 class TimeReportsDialog : public QDialog {
     Q_OBJECT
@@ -91,6 +108,33 @@ private slots:
      * Refreshes the report with current data.
      */
     void onRefreshClicked();
+    
+    /**
+     * @brief Handle finished aggregation
+     * 
+     * Called on the GUI thread when a worker finishes. Buckets from superseded
+     * generations are ignored.
+     * 
+     * @param buckets The aggregated buckets
+     * @param dataVersion Data version of the snapshot the buckets were computed from
+     */
+    void onReportReady(const ReportGenerator::Buckets& buckets, quint64 dataVersion);
+    
+    /**
+     * @brief Handle report row double-click
+     * 
+     * Drills into the period of the clicked row using the next finer grouping.
+     * 
+     * @param index Proxy model index of the double-clicked row
+     */
+    void onReportRowDoubleClicked(const QModelIndex& index);
+    
+    /**
+     * @brief Discard the cached buckets
+     * 
+     * Called when time entries change so the next report rescans them.
+     */
+    void invalidateReportCache();
 
 private:
     /**
@@ -110,7 +154,8 @@ private:
     /**
      * @brief Generate the report
      * 
-     * Generates the report based on current settings.
+     * Starts generating the report for the current settings on a worker thread,
+     * cancelling any computation that is still running.
      */
     void generateReport();
     
@@ -124,13 +169,23 @@ private:
     /**
      * @brief Export the report to CSV
      * 
-     * Exports the current report data to a CSV file.
+     * Exports the current report rows to a CSV file.
      * 
      * @param filename Path to the output file
      * @return bool True if export was successful, false otherwise
      */
     bool exportToCsv(const QString& filename);
     
+    /**
+     * @brief Export the raw time entries of the selected range in the background
+     * 
+     * Runs the export as an ImportExportJob with a cancellable progress dialog
+     * and reports the result when it finishes.
+     * 
+     * @param filename Path to the output file
+     */
+    void startRawExport(const QString& filename);
+    
     /**
      * @brief Get the current date range
      * 
@@ -142,24 +197,49 @@ private:
     void getCurrentDateRange(QDate& startDate, QDate& endDate);
     
     /**
-     * @brief Generate report by day
+     * @brief Apply the cached buckets to the table and chart
      * 
-     * Generates a report grouped by day.
+     * Rolls the cached buckets up for the current range and grouping.
+     */
+    void applyReport();
+    
+    /**
+     * @brief Fill the report by period
      * 
+     * Fills the report model with the per-period totals of the cached buckets.
+     * 
+     * @param period The period to group by
      * @param startDate Start date of the range
      * @param endDate End date of the range
      */
-    void generateReportByDay(const QDate& startDate, const QDate& endDate);
+    void generateReportByPeriod(ReportGenerator::Period period, const QDate& startDate, const QDate& endDate);
     
     /**
-     * @brief Generate report by project
+     * @brief Fill the report by project
      * 
-     * Generates a report grouped by project.
+     * Fills the report model with the per-project totals of the cached buckets.
      * 
      * @param startDate Start date of the range
      * @param endDate End date of the range
      */
     void generateReportByProject(const QDate& startDate, const QDate& endDate);
+    
+    /**
+     * @brief Fill the report by project and period
+     * 
+     * Fills the report model with one row per project and period of the
+     * project × period pivot of the cached buckets.
+     * 
+     * @param period The period of the pivot
+     * @param startDate Start date of the range
+     * @param endDate End date of the range
+     */
+    void generateReportByProjectAndPeriod(ReportGenerator::Period period, const QDate& startDate, const QDate& endDate);
+    
+    /**
+     * @brief Update the total label from the report model
+     */
+    void updateTotal();
 
     // UI elements
     QComboBox* m_dateRangeComboBox;     ///< Combo box for selecting date range
@@ -169,11 +249,16 @@ private:
     QTableView* m_reportTableView;      ///< Table view for report data
     QFrame* m_chartFrame;               ///< Frame for displaying charts
     QPushButton* m_exportButton;        ///< Button for exporting data
+    QCheckBox* m_exportRawCheckBox;     ///< Export raw time entries instead of the report rows
     QPushButton* m_refreshButton;       ///< Button for refreshing the report
     QLabel* m_totalLabel;               ///< Label showing the total time
+    QProgressBar* m_progressBar;        ///< Busy indicator shown while a report is computed
+    QTimer* m_customDateTimer;          ///< Debounces custom date edits
+    QTimer* m_progressDelayTimer;       ///< Delays the busy indicator so short reports don't flicker
     
     // Data
-    QStandardItemModel* m_reportModel;           ///< Model for report data
+    TimeReportModel* m_reportModel;              ///< Model for report data
     QSortFilterProxyModel* m_proxyModel;         ///< Proxy model for sorting
-    QMap<QString, QColor> m_colorMap;            ///< Map of labels to colors for charts
+    QSharedPointer<QAtomicInt> m_latestGeneration; ///< Latest requested generation, shared with workers
+    ReportGenerator::Buckets m_buckets;          ///< Last aggregated buckets, reused for regrouping and drill-down
 };
\ No newline at end of file
@@ -23,6 +23,8 @@
 #include <QStyledItemDelegate>
 #include <QPainter>
 #include <QApplication>
+#include <QShowEvent>
+#include <QHideEvent>
 #include <QDebug>
 
 /**
@@ -157,18 +159,16 @@ TimeTrackerWidget::TimeTrackerWidget(QWidget* parent)
     
     // Check if there's a running timer
     if (m_controller.isTimerRunning()) {
-        m_isTracking = true;
-        m_startStopButton->setText("Stop");
-        
         // Use setCurrentIndex with the data role to properly select the project
         QString currentProjectId = m_controller.getCurrentProjectId();
         int index = m_projectComboBox->findData(currentProjectId);
         if (index >= 0) {
+            QSignalBlocker blocker(m_projectComboBox);
             m_projectComboBox->setCurrentIndex(index);
         }
-        
-        updateTimerDisplay(m_controller.getCurrentElapsed());
     }
+    
+    refreshTimerControls();
 }
 
 /**
@@ -308,16 +308,18 @@ void TimeTrackerWidget::setupConnections()
 /**
  * @brief Handle Start/Stop button click
  * 
- * Starts or stops the timer based on the current tracking state.
+ * Starts or stops the timer of the selected project. Timers of other
+ * projects are left running.
  */
 void TimeTrackerWidget::onStartStopClicked()
 {
+    QString projectId = m_projectComboBox->currentData().toString();
+    
     if (m_isTracking) {
-        // Stop tracking
-        m_controller.stopTimer();
+        // Stop tracking the selected project
+        m_controller.stopTimer(projectId);
     } else {
         // Start tracking
-        QString projectId = m_projectComboBox->currentData().toString();
         if (projectId.isEmpty()) {
             QMessageBox::warning(this, "No Project Selected", "Please select a project to track time for.");
             return;
@@ -330,47 +332,29 @@ void TimeTrackerWidget::onStartStopClicked()
 /**
  * @brief Handle project selection changes
  * 
- * If tracking is active, asks the user if they want to switch projects.
+ * Switches the timer controls to the newly selected project. Running timers
+ * are not affected by the selection.
  * 
  * @param index The index of the newly selected project in the combo box
  */
 void TimeTrackerWidget::onProjectSelectionChanged(int index)
 {
-    // If tracking is active, ask if user wants to switch projects
-    if (m_isTracking && index >= 0) {
-        QString newProjectId = m_projectComboBox->currentData().toString();
-        if (newProjectId != m_controller.getCurrentProjectId()) {
-            QMessageBox::StandardButton reply = QMessageBox::question(
-                this, "Switch Project?", 
-                "Do you want to stop tracking the current project and start tracking the selected project?",
-                QMessageBox::Yes | QMessageBox::No
-            );
-            
-            if (reply == QMessageBox::Yes) {
-                m_controller.stopTimer();
-                m_controller.startTimer(newProjectId);
-            } else {
-                // Revert selection
-                int oldIndex = m_projectComboBox->findData(m_controller.getCurrentProjectId());
-                if (oldIndex >= 0) {
-                    QSignalBlocker blocker(m_projectComboBox);
-                    m_projectComboBox->setCurrentIndex(oldIndex);
-                }
-            }
-        }
-    }
+    refreshTimerControls();
 }
 
 /**
  * @brief Handle timer tick signal from controller
  * 
- * Updates the timer display with the current elapsed time.
+ * Updates the timer display if the tick belongs to the selected project.
  * 
+ * @param projectId The ID of the tracked project
  * @param elapsed The elapsed time in seconds
  */
-void TimeTrackerWidget::onTimerTick(int elapsed)
+void TimeTrackerWidget::onTimerTick(const QString& projectId, int elapsed)
 {
-    updateTimerDisplay(elapsed);
+    if (projectId == m_projectComboBox->currentData().toString()) {
+        updateTimerDisplay(elapsed);
+    }
 }
 
 /**
@@ -385,6 +369,88 @@ void TimeTrackerWidget::updateTimerDisplay(int seconds)
     m_timerLabel->setText(TimeTrackingController::formatDuration(seconds));
 }
 
+/**
+ * @brief Refresh the timer controls for the selected project
+ * 
+ * Updates the tracking flag, the start/stop button and the timer display
+ * from the controller state of the selected project.
+ */
+void TimeTrackerWidget::refreshTimerControls()
+{
+    QString projectId = m_projectComboBox->currentData().toString();
+    
+    m_isTracking = !projectId.isEmpty() && m_controller.isTimerRunning(projectId);
+    m_startStopButton->setText(m_isTracking ? "Stop" : "Start");
+    updateTimerDisplay(m_isTracking ? m_controller.getElapsed(projectId) : 0);
+    updateTickSubscription();
+}
+
+/**
+ * @brief Request or release timer ticks
+ * 
+ * A hidden widget (in the tray or on another tab), a minimized window or an
+ * idle selection does not need per-second updates, so the controller can stop
+ * its tick entirely.
+ */
+void TimeTrackerWidget::updateTickSubscription()
+{
+    m_controller.setTicksWanted(this, isVisible() && !window()->isMinimized() && m_isTracking);
+}
+
+/**
+ * @brief Handle show event
+ * 
+ * The display may be stale after being hidden, so it is recomputed from the
+ * controller's monotonic clock before ticks resume.
+ * 
+ * @param event The show event
+ */
+void TimeTrackerWidget::showEvent(QShowEvent* event)
+{
+    QWidget::showEvent(event);
+    
+    // Minimizing keeps the widget visible, so watch the window itself
+    if (m_watchedWindow != window()) {
+        if (m_watchedWindow) {
+            m_watchedWindow->removeEventFilter(this);
+        }
+        m_watchedWindow = window();
+        m_watchedWindow->installEventFilter(this);
+    }
+    
+    refreshTimerControls();
+}
+
+/**
+ * @brief Handle hide event
+ * 
+ * @param event The hide event
+ */
+void TimeTrackerWidget::hideEvent(QHideEvent* event)
+{
+    QWidget::hideEvent(event);
+    updateTickSubscription();
+}
+
+/**
+ * @brief Filter events of the top-level window
+ * 
+ * A restored window refreshes the display from the controller before ticks
+ * resume, as after a show event.
+ * 
+ * @param watched The object receiving the event
+ * @param event The event
+ * @return bool Always false, the event is passed on
+ */
+bool TimeTrackerWidget::eventFilter(QObject* watched, QEvent* event)
+{
+    if (watched == m_watchedWindow && event->type() == QEvent::WindowStateChange) {
+        refreshTimerControls();
+    }
+    
+    return QWidget::eventFilter(watched, event);
+}
+
 /**
  * @brief Handle Add Manual Entry button click
  * 
@@ -537,8 +603,8 @@ void TimeTrackerWidget::updateProjectComboBox()
         currentProjectId = m_projectComboBox->currentData().toString();
     }
     
-    // If we're tracking a project, make sure we use that ID
-    if (m_isTracking && m_controller.isTimerRunning()) {
+    // Fall back to the most recently tracked project
+    if (currentProjectId.isEmpty() && m_controller.isTimerRunning()) {
         currentProjectId = m_controller.getCurrentProjectId();
     }
     
@@ -571,6 +637,8 @@ void TimeTrackerWidget::updateProjectComboBox()
             qDebug() << "Could not find project with ID:" << currentProjectId;
         }
     }
+    
+    refreshTimerControls();
 }
 
 /**
@@ -611,15 +679,12 @@ void TimeTrackerWidget::updateSummary()
 /**
  * @brief Handle timer started signal from controller
  * 
- * Updates the UI to reflect that time tracking has started.
+ * Selects the newly tracked project and updates the timer controls.
  * 
  * @param projectId The ID of the project being tracked
  */
 void TimeTrackerWidget::onTimerStarted(const QString& projectId)
 {
-    m_isTracking = true;
-    m_startStopButton->setText("Stop");
-    
     // Select the project in the combo box
     int index = m_projectComboBox->findData(projectId);
     if (index >= 0) {
@@ -627,21 +692,23 @@ void TimeTrackerWidget::onTimerStarted(const QString& projectId)
         m_projectComboBox->setCurrentIndex(index);
     }
     
-    updateTimerDisplay(0);
+    refreshTimerControls();
 }
 
 /**
  * @brief Handle timer stopped signal from controller
  * 
- * Updates the UI to reflect that time tracking has stopped and updates the summary.
+ * Updates the timer controls and the summary after a project's timer stopped.
  * 
- * @param duration The duration of the time entry that was created
+ * @param projectId The ID of the project that was being tracked
+ * @param duration The duration of the time entry that was completed
  */
-void TimeTrackerWidget::onTimerStopped(int duration)
+void TimeTrackerWidget::onTimerStopped(const QString& projectId, int duration)
 {
-    m_isTracking = false;
-    m_startStopButton->setText("Start");
-    updateTimerDisplay(0);
+    Q_UNUSED(projectId);
+    Q_UNUSED(duration);
+    
+    refreshTimerControls();
     updateSummary();
 }
 
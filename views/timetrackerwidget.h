@@ -20,6 +20,7 @@
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QTimer>
+#include <QPointer>
 #include "../models/timeentrymodel.h"
 #include "../controllers/timetrackingcontroller.h"
 
@@ -60,6 +61,37 @@ public slots:
      */
     void updateProjectComboBox();
 
+protected:
+    /**
+     * @brief Handle show event
+     * 
+     * Recomputes the timer display and subscribes to timer ticks.
+     * 
+     * @param event The show event
+     */
+    void showEvent(QShowEvent* event) override;
+    
+    /**
+     * @brief Handle hide event
+     * 
+     * Unsubscribes from timer ticks while the widget is not visible.
+     * 
+     * @param event The hide event
+     */
+    void hideEvent(QHideEvent* event) override;
+    
+    /**
+     * @brief Filter events of the top-level window
+     * 
+     * Re-evaluates the tick subscription when the window is minimized or restored,
+     * which does not hide the widget itself.
+     * 
+     * @param watched The object receiving the event
+     * @param event The event
+     * @return bool Always false, the event is passed on
+     */
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
 private slots:
     /**
      * @brief Handle start/stop button click
@@ -71,7 +103,7 @@ private slots:
     /**
      * @brief Handle project selection change
      * 
-     * Updates the current project being tracked.
+     * Shows the timer state of the newly selected project.
      * 
      * @param index Index of the selected project in the combo box
      */
@@ -80,11 +112,12 @@ private slots:
     /**
      * @brief Handle timer tick
      * 
-     * Updates the timer display when the timer ticks.
+     * Updates the timer display when the selected project's timer ticks.
      * 
+     * @param projectId ID of the tracked project
      * @param elapsed Elapsed time in seconds
      */
-    void onTimerTick(int elapsed);
+    void onTimerTick(const QString& projectId, int elapsed);
     
     /**
      * @brief Handle add manual entry button click
@@ -153,9 +186,10 @@ private slots:
      * 
      * Updates UI when a timer is stopped.
      * 
+     * @param projectId ID of the project that was being tracked
      * @param duration Duration of the tracked time in seconds
      */
-    void onTimerStopped(int duration);
+    void onTimerStopped(const QString& projectId, int duration);
     
     /**
      * @brief Handle time entry added signal
@@ -207,6 +241,22 @@ private:
      * @param seconds Elapsed time in seconds
      */
     void updateTimerDisplay(int seconds);
+    
+    /**
+     * @brief Refresh the timer controls for the selected project
+     * 
+     * Updates the start/stop button and timer display to match the timer
+     * state of the project selected in the combo box.
+     */
+    void refreshTimerControls();
+    
+    /**
+     * @brief Request or release timer ticks
+     * 
+     * Ticks are only wanted while the widget is visible and the selected
+     * project is being tracked.
+     */
+    void updateTickSubscription();
 
     // UI elements
     QComboBox* m_projectComboBox;      ///< Combo box for selecting a project
@@ -224,7 +274,8 @@ private:
     TimeTrackingController& m_controller;             ///< Controller for time tracking operations
     
     // State
-    bool m_isTracking;                 ///< Flag indicating if tracking is active
+    bool m_isTracking;                 ///< Flag indicating if the selected project is being tracked
+    QPointer<QWidget> m_watchedWindow; ///< Top-level window whose state changes are filtered
     
     // Dialogs
     TimeEntryDialog* m_timeEntryDialog;     ///< Dialog for editing time entries